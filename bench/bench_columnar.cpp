@@ -0,0 +1,144 @@
+/** @file bench_columnar.cpp
+ *  @brief the benchmark of the columnar output against the text output (write, read back, scan, conversion)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/columnar.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+geo::Answers makeAnswers(std::size_t count)
+{
+  std::mt19937 rand(42);
+  std::uniform_int_distribution<int> region(1, 85);
+  std::uniform_int_distribution<int> place(1, 3000);
+  std::uniform_int_distribution<int> street(1, 50000);
+  std::uniform_int_distribution<int> house(1, 300);
+  std::uniform_real_distribution<double> lat(43.0, 68.0);
+  std::uniform_real_distribution<double> lon(27.0, 60.0);
+
+  geo::Answers result(count);
+  for (auto &a : result)
+  {
+    a.type = geo::Answer::GeocoderType::yandex;
+    geo::Location loc;
+    loc.country = "Россия";
+    loc.region = "Область " + std::to_string(region(rand));
+    loc.place = "Город " + std::to_string(place(rand));
+    loc.street = "улица " + std::to_string(street(rand));
+    loc.house = std::to_string(house(rand));
+    loc.line = loc.country + ", " + loc.region + ", " + loc.place + ", " + loc.street + ", " + loc.house;
+    loc.coord = geo::Coordinates(lat(rand), lon(rand));
+    a.locations.push_back(loc);
+  }
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_columnar)
+
+BOOST_AUTO_TEST_CASE(bench_convert)
+{
+  const std::size_t count = 200000;
+  const auto answers = makeAnswers(count);
+
+  const auto dir = fs::temp_directory_path() / fs::unique_path("geocoder_bench_columnar_%%%%%%");
+  fs::create_directories(dir);
+  const auto text = dir / "output.txt";
+  const auto columnar = dir / "output.col";
+
+  auto start = Clock::now();
+  geo::print(text, answers);
+  const auto text_write = seconds(start);
+
+  start = Clock::now();
+  geo::printColumnar(columnar, answers);
+  const auto columnar_write = seconds(start);
+
+  // the downstream job: read the all answers
+  start = Clock::now();
+  const auto text_read = geo::readAnswers(text);
+  const auto text_read_time = seconds(start);
+
+  start = Clock::now();
+  const auto columnar_read = geo::ColumnarReader(columnar).read();
+  const auto columnar_read_time = seconds(start);
+
+  // the downstream job: aggregate by column (the mean latitude and the count of the locations by place)
+  start = Clock::now();
+  double text_sum = 0.0;
+  std::size_t text_place = 0;
+  for (const auto &a : geo::readAnswers(text))
+  {
+    for (const auto &l : a.locations)
+    {
+      text_sum += l.coord.latitude;
+      text_place += (l.place == "Город 1") ? 1 : 0;
+    }
+  }
+  const auto text_scan = seconds(start);
+
+  start = Clock::now();
+  double columnar_sum = 0.0;
+  std::size_t columnar_place = 0;
+  {
+    const geo::ColumnarReader reader(columnar);
+    for (const auto i : reader.latitude())
+    {
+      columnar_sum += i;
+    }
+    const auto place = reader.strings("place");
+    std::vector<bool> selected(place.entries());
+    for (std::uint32_t i = 0; i < place.entries(); ++i)
+    {
+      selected[i] = (place.entry(i) == "Город 1");
+    }
+    for (std::size_t i = 0; i < place.size(); ++i)
+    {
+      columnar_place += selected[place.code(i)] ? 1 : 0;
+    }
+  }
+  const auto columnar_scan = seconds(start);
+
+  // the conversion of the existing text output
+  start = Clock::now();
+  geo::printColumnar(dir / "converted.col", geo::readAnswers(text));
+  const auto convert = seconds(start);
+
+  const auto text_size = fs::file_size(text);
+  const auto columnar_size = fs::file_size(columnar);
+  fs::remove_all(dir);
+
+  BOOST_CHECK_EQUAL(text_read.size(), count);
+  BOOST_CHECK_EQUAL(columnar_read.size(), count);
+  BOOST_CHECK_EQUAL(text_place, columnar_place);
+  // the text output keeps 6 significant digits
+  BOOST_CHECK_CLOSE(text_sum, columnar_sum, 1e-4);
+
+  BOOST_TEST_MESSAGE(count << " answers, text " << text_size << " bytes, columnar " << columnar_size << " bytes");
+  BOOST_TEST_MESSAGE("write: text " << text_write << " s, columnar " << columnar_write << " s");
+  BOOST_TEST_MESSAGE("read the all answers: text " << text_read_time << " s, columnar " << columnar_read_time << " s");
+  BOOST_TEST_MESSAGE("scan two columns: text " << text_scan << " s, columnar " << columnar_scan << " s");
+  BOOST_TEST_MESSAGE("convert text -> columnar: " << convert << " s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/** @file bench_fuzzy.cpp
+ *  @brief the benchmark of the fuzzy address matching (trigram candidates and the edit distance kernel)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/fuzzy.h"
+#include "geo/gazetteer.h"
+#include "geo/normalize.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+/** @brief the random word of the cyrillic syllables */
+std::string word(std::mt19937 &rand)
+{
+  static const char *const syllables[] = {"ка", "ло", "ми", "ре", "то", "ва", "ну", "си", "ер", "ов", "ин", "ская", "ная", "ий"};
+  std::uniform_int_distribution<std::size_t> count(2, 4);
+  std::uniform_int_distribution<std::size_t> syllable(0, sizeof(syllables) / sizeof(syllables[0]) - 1);
+
+  std::string result;
+  for (auto i = count(rand); i > 0; --i)
+  {
+    result += syllables[syllable(rand)];
+  }
+  return result;
+}
+
+/** @brief replace the one cyrillic letter (two bytes) of the text */
+std::string typo(std::string text, std::mt19937 &rand)
+{
+  std::uniform_int_distribution<std::size_t> pos(0, text.size() - 1);
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    const auto p = pos(rand);
+    if (static_cast<unsigned char>(text[p]) == 0xD0 && p + 1 < text.size() && static_cast<unsigned char>(text[p + 1]) != 0xB0)
+    {
+      // 'а'
+      text[p + 1] = static_cast<char>(0xB0);
+      break;
+    }
+  }
+  return text;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_fuzzy)
+
+BOOST_AUTO_TEST_CASE(bench_match)
+{
+  const std::size_t count = 200000;
+  const std::size_t queries = 20000;
+
+  std::mt19937 rand(42);
+  std::vector<std::string> places(200);
+  std::vector<std::string> streets(5000);
+  for (auto &i : places)
+  {
+    i = word(rand);
+  }
+  for (auto &i : streets)
+  {
+    i = word(rand) + " " + word(rand);
+  }
+
+  const auto dir = fs::temp_directory_path() / fs::unique_path("geocoder_bench_fuzzy_%%%%%%");
+  fs::create_directories(dir);
+
+  std::vector<std::string> addresses;
+  {
+    std::uniform_int_distribution<std::size_t> place(0, places.size() - 1);
+    std::uniform_int_distribution<std::size_t> street(0, streets.size() - 1);
+    std::uniform_int_distribution<int> house(1, 200);
+
+    geo::GazetteerBuilder builder;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      geo::Location loc;
+      loc.place = places[place(rand)];
+      loc.street = streets[street(rand)];
+      loc.house = std::to_string(house(rand));
+      builder.add(loc);
+      if (addresses.size() < queries)
+      {
+        addresses.push_back(loc.place + ", " + loc.street + " " + loc.house);
+      }
+    }
+    builder.write(dir / "index.gaz");
+  }
+
+  const geo::Gazetteer gazetteer(dir / "index.gaz");
+
+  auto start = Clock::now();
+  const geo::FuzzyIndex index(gazetteer);
+  const auto build = seconds(start);
+
+  std::vector<std::string> typos;
+  for (const auto &i : addresses)
+  {
+    typos.push_back(typo(i, rand));
+  }
+
+  start = Clock::now();
+  std::size_t found = 0;
+  for (const auto &i : typos)
+  {
+    const auto matches = index.match(i);
+    found += (!matches.empty() && matches.front().key == geo::normalize(addresses[&i - typos.data()])) ? 1 : 0;
+  }
+  const auto match_time = seconds(start);
+
+  // the kernel: the keys of the same length with the one substitution
+  std::vector<std::pair<std::string, std::string>> keys;
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    keys.emplace_back(geo::normalize(addresses[i]), geo::normalize(typos[i]));
+  }
+  start = Clock::now();
+  std::size_t total = 0;
+  for (const auto &i : keys)
+  {
+    total += geo::editDistance(i.first, i.second, 3);
+  }
+  const auto kernel_time = seconds(start);
+
+  fs::remove_all(dir);
+
+  BOOST_CHECK(found > queries * 9 / 10);
+  BOOST_CHECK(total > 0);
+
+  BOOST_TEST_MESSAGE("fuzzy index of " << index.size() << " keys: build " << build << " s");
+  BOOST_TEST_MESSAGE("match with the one typo: " << match_time / queries * 1e6 << " us/query, found " << found << " of " << queries);
+  BOOST_TEST_MESSAGE("edit distance: " << kernel_time / keys.size() * 1e9 << " ns/pair");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+/** @file bench_http2.cpp
+ *  @brief the benchmark HTTP/1.1 keep-alive (handle per worker) against shared multiplexer (HTTP/2)
+ *  @details HTTP/2 requires the server with h2 support, set GEOCODER_BENCH_H2_URL
+ *  (for example, nghttpd serving the fixture: https://localhost:8443/1.x/?geocode=),
+ *  GEOCODER_BENCH_H2_CAINFO - the certificate of the server
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/algorithm/string.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/libcurl/libcurl.h"
+#include "utils/libcurl/multiplexer.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using geocoder::utils::curl::Multiplexer;
+using geocoder::utils::curl::MultiplexerOptions;
+
+const std::size_t workers = 64;
+const std::size_t per_worker = 50;
+
+template <typename Function>
+double run(Function fn)
+{
+  const auto start = Clock::now();
+
+  std::vector<std::future<void>> futures;
+  for (std::size_t i = 0; i < workers; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, fn));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  return static_cast<double>(workers * per_worker) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double runMultiplexer(const std::string &url, const MultiplexerOptions &options, std::size_t &connections)
+{
+  Multiplexer multiplexer(options);
+  const auto result = run([&] {
+    for (std::size_t i = 0; i < per_worker; ++i)
+    {
+      multiplexer.get(url);
+    }
+  });
+
+  connections = multiplexer.connections();
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_http2)
+
+BOOST_AUTO_TEST_CASE(bench_high_concurrency)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::microseconds(5000);
+  mock.threads = 8;
+
+  {
+    geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+    const auto url = server.url() + "unknown";
+
+    const auto rps = run([&url] {
+      geocoder::utils::curl::LibCurl curl;
+      for (std::size_t i = 0; i < per_worker; ++i)
+      {
+        curl.get(url);
+      }
+    });
+
+    BOOST_TEST_MESSAGE("http/1.1 keep-alive, handle per worker: " << rps << " req/s, connections " << server.stats().connections);
+  }
+
+  {
+    geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+    MultiplexerOptions options;
+    options.version = MultiplexerOptions::HttpVersion::http1_1;
+    options.max_connections = workers;
+
+    std::size_t connections = 0;
+    const auto rps = runMultiplexer(server.url() + "unknown", options, connections);
+    BOOST_TEST_MESSAGE("http/1.1 shared multiplexer: " << rps << " req/s, connections " << connections);
+  }
+
+  if (const char *h2 = std::getenv("GEOCODER_BENCH_H2_URL"))
+  {
+    const std::string url(h2);
+
+    MultiplexerOptions options;
+    options.version = boost::starts_with(url, "https") ? MultiplexerOptions::HttpVersion::http2
+                                                       : MultiplexerOptions::HttpVersion::http2_prior_knowledge;
+    options.max_connections = 1;
+    if (const char *cainfo = std::getenv("GEOCODER_BENCH_H2_CAINFO"))
+    {
+      options.cainfo = cainfo;
+    }
+
+    std::size_t connections = 0;
+    const auto rps = runMultiplexer(url + "unknown", options, connections);
+    BOOST_TEST_MESSAGE("http/2 multiplexed '" << url << "': " << rps << " req/s, connections " << connections);
+  }
+  else
+  {
+    BOOST_TEST_MESSAGE("http/2: GEOCODER_BENCH_H2_URL is not set, skipped");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/** @file bench_logger.cpp
+ *  @brief the benchmark of the logger (records per second)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/log/core.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "utils/logger/binary.h"
+#include "utils/logger/logger.h"
+
+namespace
+{
+namespace fs = boost::filesystem;
+using Clock = std::chrono::steady_clock;
+using geocoder::utils::logger::Severity;
+
+/** @brief write 'count' records per thread, return records per second */
+double run(Severity sev, std::size_t threads, std::size_t count, bool binary = false)
+{
+  const std::string url = "https://geocode-maps.yandex.ru/1.x/?geocode=";
+  const std::string addr = "%D0%9C%D0%BE%D1%81%D0%BA%D0%B2%D0%B0%2C%20%D0%BF%D1%80%D0%B8%D1%88%D0%B2%D0%B8%D0%BD%D0%B0%208%D0%BA2";
+
+  const auto start = Clock::now();
+
+  std::vector<std::future<void>> futures;
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    futures.push_back(std::async(std::launch::async, [&, count] {
+      auto &logger = geo_logger::get();
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        if (binary)
+        {
+          GEO_LOG_BIN(logger, sev, "[GeocoderBase::Impl::get]: request '{}'", url + addr);
+        }
+        else
+        {
+          BOOST_LOG_SEV(logger, sev) << "[GeocoderBase::Impl::get]: request '" << url + addr << "'";
+        }
+      }
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  boost::log::core::get()->flush();
+  geocoder::utils::logger::binary::stop();
+
+  const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  return static_cast<double>(threads * count) / elapsed;
+}
+
+geocoder::utils::logger::config::Configuration makeConfig(const fs::path &dir)
+{
+  geocoder::utils::logger::config::Configuration conf;
+  conf.stdoutput = false;
+  conf.workdir = dir;
+  conf.filename = "bench_%N.log";
+  return conf;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_logger)
+
+BOOST_AUTO_TEST_CASE(bench_records_per_second)
+{
+  const auto dir = fs::temp_directory_path() / fs::unique_path("geocoder_log_%%%%%%");
+  fs::create_directories(dir);
+
+  const std::size_t threads = 4;
+  const std::size_t count = 50000;
+
+  {
+    auto conf = makeConfig(dir);
+    geocoder::utils::logger::Logger::init(conf);
+    BOOST_TEST_MESSAGE("logger: written trace records " << run(Severity::trace, threads, count) << " rec/s");
+    boost::log::core::get()->remove_all_sinks();
+  }
+
+  {
+    auto conf = makeConfig(dir);
+    conf.severity = Severity::info;
+    geocoder::utils::logger::Logger::init(conf);
+    BOOST_TEST_MESSAGE("logger: filtered trace records (severity info) " << run(Severity::trace, threads, count) << " rec/s");
+    boost::log::core::get()->remove_all_sinks();
+  }
+
+  {
+    auto conf = makeConfig(dir);
+    conf.binary.enabled = true;
+    geocoder::utils::logger::Logger::init(conf);
+    BOOST_TEST_MESSAGE("logger: binary trace records " << run(Severity::trace, threads, count, true) << " rec/s");
+    boost::log::core::get()->remove_all_sinks();
+  }
+
+  fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,10 @@
+/* @file bench_main.cpp
+ * @brief the implementation entry point benchmarks
+ * @author agent
+ * @date 19.10.2026
+ */
+#define BOOST_TEST_MODULE geocoder_bench
+
+// boost
+#include <boost/test/unit_test.hpp>
+
@@ -0,0 +1,130 @@
+/** @file bench_parse.cpp
+ *  @brief the benchmark of the parsing answers of the yandex geocoder: xml against json, all results against results=1,
+ *  the parse options (the first result, the coordinates only)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/geoyandex.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/** @brief parse 'count' times, return answers per second */
+template <typename Function>
+double parse(Function fn, const std::string &body, std::size_t count, const geocoder::geo::ParseOptions &options = geocoder::geo::ParseOptions())
+{
+  const auto start = Clock::now();
+
+  std::size_t locations = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    locations += fn(body, options).size();
+  }
+
+  BOOST_CHECK(locations > 0);
+
+  return static_cast<double>(count) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/** @brief geocode the data set by 'workers' threads, return requests per second */
+double geocode(const geocoder::test::MockServer &server, const geocoder::test::DataSet &data, const std::string &format, std::size_t results,
+               std::size_t workers, std::size_t rounds)
+{
+  namespace pt = boost::property_tree;
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  for (auto &i : document.get_child("document.geocoders"))
+  {
+    i.second.put("connection.url", server.url());
+    i.second.put("format", format);
+    i.second.put("results", results);
+  }
+
+  const auto start = Clock::now();
+
+  std::vector<std::future<void>> futures;
+  for (std::size_t i = 0; i < workers; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&] {
+      geocoder::geo::GeoPool pool(document);
+      for (std::size_t r = 0; r < rounds; ++r)
+      {
+        for (const auto &i : data)
+        {
+          pool.geocode(i.first);
+        }
+      }
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  const auto count = workers * rounds * data.size();
+  return static_cast<double>(count) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_parse)
+
+BOOST_AUTO_TEST_CASE(bench_parse_answer)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const auto locs = geocoder::test::makeFixtures(data, 9).begin()->second;
+
+  const auto xml = geocoder::test::makeYandexAnswer(locs);
+  const auto json = geocoder::test::makeYandexJsonAnswer(locs);
+  const auto json_one = geocoder::test::makeYandexJsonAnswer(geocoder::geo::Locations(locs.begin(), locs.begin() + 1));
+
+  const std::size_t count = 20000;
+  const auto xml_rate = parse(geocoder::geo::parseYandexXml, xml, count);
+  const auto json_rate = parse(geocoder::geo::parseYandexJson, json, count);
+  const auto json_one_rate = parse(geocoder::geo::parseYandexJson, json_one, count);
+
+  // the answer of 10 results, the parse stops after the first one
+  geocoder::geo::ParseOptions first;
+  first.max_results = 1;
+  first.fields = 0;
+  const auto xml_first_rate = parse(geocoder::geo::parseYandexXml, xml, count, first);
+  const auto json_first_rate = parse(geocoder::geo::parseYandexJson, json, count, first);
+
+  BOOST_TEST_MESSAGE("xml, 10 results (" << xml.size() << " bytes): " << xml_rate << " answers/s");
+  BOOST_TEST_MESSAGE("json, 10 results (" << json.size() << " bytes): " << json_rate << " answers/s");
+  BOOST_TEST_MESSAGE("json, 1 result (" << json_one.size() << " bytes): " << json_one_rate << " answers/s");
+  BOOST_TEST_MESSAGE("xml, 10 results, the first one, the coordinates only: " << xml_first_rate << " answers/s");
+  BOOST_TEST_MESSAGE("json, 10 results, the first one, the coordinates only: " << json_first_rate << " answers/s");
+}
+
+BOOST_AUTO_TEST_CASE(bench_format_throughput)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data, 9));
+
+  const auto xml_rate = geocode(server, data, "xml", 0, 4, 300);
+  const auto json_rate = geocode(server, data, "json", 1, 4, 300);
+
+  BOOST_TEST_MESSAGE("geopool xml, 10 results: " << xml_rate << " req/s");
+  BOOST_TEST_MESSAGE("geopool json, 1 result: " << json_rate << " req/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+/** @file bench_prefix.cpp
+ *  @brief the benchmark of the autocomplete of the partial addresses (top-k at millions of keys)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/normalize.h"
+#include "geo/prefix.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+/** @brief the random word of the cyrillic letters */
+std::string word(std::mt19937 &rand)
+{
+  static const char *const letters[] = {"а", "б", "в", "г", "д", "е", "ж", "з", "и", "к", "л", "м", "н", "о", "п", "р", "с", "т", "у", "ф", "х", "ч", "ш", "я"};
+  std::uniform_int_distribution<std::size_t> count(4, 10);
+  std::uniform_int_distribution<std::size_t> letter(0, sizeof(letters) / sizeof(letters[0]) - 1);
+
+  std::string result;
+  for (auto i = count(rand); i > 0; --i)
+  {
+    result += letters[letter(rand)];
+  }
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_prefix)
+
+BOOST_AUTO_TEST_CASE(bench_complete)
+{
+  const std::size_t count = 600000;
+  const std::size_t repeats = 400000;
+  const std::size_t queries = 200000;
+
+  std::mt19937 rand(42);
+  std::vector<std::string> regions(80);
+  std::vector<std::string> places(2000);
+  std::vector<std::string> streets(20000);
+  for (auto &i : regions)
+  {
+    i = word(rand) + " область";
+  }
+  for (auto &i : places)
+  {
+    i = word(rand);
+  }
+  for (auto &i : streets)
+  {
+    i = "улица " + word(rand);
+  }
+
+  std::uniform_int_distribution<std::size_t> region(0, regions.size() - 1);
+  std::uniform_int_distribution<std::size_t> street(0, streets.size() - 1);
+  std::uniform_int_distribution<int> house(1, 300);
+  // the large cities are popular
+  std::geometric_distribution<std::size_t> place(0.01);
+
+  geo::Locations locs(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &loc = locs[i];
+    loc.country = "Россия";
+    loc.region = regions[region(rand)];
+    loc.place = places[std::min(place(rand), places.size() - 1)];
+    loc.street = streets[street(rand)];
+    loc.house = std::to_string(house(rand));
+    loc.line = loc.country + ", " + loc.region + ", " + loc.place + ", " + loc.street + ", " + loc.house;
+    loc.coord = geo::Coordinates(50.0 + i * 1e-6, 40.0);
+  }
+  // the repeated requests of the popular addresses
+  std::geometric_distribution<std::size_t> popular(0.0001);
+  for (std::size_t i = 0; i < repeats; ++i)
+  {
+    locs.push_back(locs[std::min(popular(rand), count - 1)]);
+  }
+
+  // the typed prefixes of the addresses 'place street house'
+  std::vector<std::string> prefixes;
+  std::uniform_int_distribution<std::size_t> any(0, count - 1);
+  for (std::size_t i = 0; i < queries; ++i)
+  {
+    const auto &loc = locs[any(rand)];
+    const auto text = geo::normalize(loc.place + " " + loc.street + " " + loc.house);
+    // cut by the code point (the cyrillic letters are two bytes)
+    auto size = std::uniform_int_distribution<std::size_t>(1, text.size())(rand);
+    while (size < text.size() && (static_cast<unsigned char>(text[size]) & 0xC0) == 0x80)
+    {
+      ++size;
+    }
+    prefixes.push_back(text.substr(0, size));
+  }
+
+  auto start = Clock::now();
+  const geo::PrefixIndex index(std::move(locs));
+  const auto build = seconds(start);
+
+  std::vector<double> latency;
+  latency.reserve(queries);
+  std::size_t found = 0;
+  start = Clock::now();
+  for (const auto &i : prefixes)
+  {
+    const auto query = Clock::now();
+    found += index.complete(i, 10).size();
+    latency.push_back(seconds(query));
+  }
+  const auto total = seconds(start);
+
+  std::sort(latency.begin(), latency.end());
+  const auto p50 = latency[latency.size() / 2] * 1e6;
+  const auto p99 = latency[latency.size() * 99 / 100] * 1e6;
+  const auto max = latency.back() * 1e6;
+
+  BOOST_CHECK(found >= queries);
+
+  BOOST_TEST_MESSAGE("prefix index: " << index.size() << " keys, " << index.locations() << " locations, build " << build << " s");
+  BOOST_TEST_MESSAGE("top-10: " << total / queries * 1e6 << " us/query, p50 " << p50 << " us, p99 " << p99 << " us, max " << max << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+/** @file bench_reverse.cpp
+ *  @brief the benchmark of the local reverse geocoding (build and nearest queries at millions of points)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/reverse.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_reverse)
+
+BOOST_AUTO_TEST_CASE(bench_nearest)
+{
+  const std::size_t count = 1000000;
+  const std::size_t queries = 2000000;
+
+  std::mt19937 rand(42);
+  // the european part of Russia
+  std::uniform_real_distribution<double> lat(43.0, 68.0);
+  std::uniform_real_distribution<double> lon(27.0, 60.0);
+
+  geo::Locations locs(count);
+  for (auto &i : locs)
+  {
+    i.house = "1";
+    i.coord = geo::Coordinates(lat(rand), lon(rand));
+  }
+
+  std::vector<geo::Coordinates> points(queries);
+  for (auto &i : points)
+  {
+    i = geo::Coordinates(lat(rand), lon(rand));
+  }
+
+  auto start = Clock::now();
+  const geo::ReverseIndex index(std::move(locs));
+  const auto build = seconds(start);
+
+  start = Clock::now();
+  const auto single = index.nearest(points, std::numeric_limits<double>::infinity(), 1);
+  const auto single_time = seconds(start);
+
+  const auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  start = Clock::now();
+  const auto batch = index.nearest(points, std::numeric_limits<double>::infinity(), threads);
+  const auto batch_time = seconds(start);
+
+  start = Clock::now();
+  std::size_t found = 0;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    found += index.nearest(points[i], 5).size();
+  }
+  const auto knn_time = seconds(start);
+
+  BOOST_CHECK_EQUAL(single.size(), queries);
+  BOOST_CHECK_EQUAL(found, 500000);
+
+  BOOST_TEST_MESSAGE("build " << count << " locations: " << build << " s");
+  BOOST_TEST_MESSAGE("batch, 1 thread: " << queries / single_time << " queries/s, " << single_time / queries * 1e6 << " us/query");
+  BOOST_TEST_MESSAGE("batch, " << threads << " threads: " << queries / batch_time << " queries/s");
+  BOOST_TEST_MESSAGE("k = 5: " << knn_time / 100000 * 1e6 << " us/query");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/** @file bench_server.cpp
+ *  @brief the benchmark of the daemon mode: the warm geocoders over HTTP against the geocoders created per address
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/server.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/libcurl/libcurl.h"
+
+namespace
+{
+namespace asio = boost::asio;
+namespace pt = boost::property_tree;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_server)
+
+BOOST_AUTO_TEST_CASE(bench_warm)
+{
+  const std::size_t requests = 2000;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", upstream.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+
+  std::vector<std::string> addrs;
+  for (const auto &i : data)
+  {
+    addrs.push_back(i.first);
+  }
+
+  // the cold start per address: the geocoders, the connection
+  std::vector<double> cold;
+  std::size_t cold_found = 0;
+  for (std::size_t i = 0; i < requests / 10; ++i)
+  {
+    const auto start = Clock::now();
+    geocoder::geo::GeoPool pool(document);
+    cold_found += pool.geocode(addrs[i % addrs.size()]).locations.size();
+    cold.push_back(seconds(start));
+  }
+
+  geocoder::geo::ServerOptions options;
+  options.endpoint = "127.0.0.1:0";
+  options.threads = 1;
+  geocoder::geo::Server server(document, options);
+  std::thread thread([&server] { server.run(); });
+
+  asio::io_context io;
+  asio::ip::tcp::socket socket(io);
+  socket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), server.port()));
+  socket.set_option(asio::ip::tcp::no_delay(true));
+
+  geocoder::utils::curl::LibCurl curl;
+  std::vector<std::string> targets;
+  for (const auto &i : addrs)
+  {
+    targets.push_back("GET /geocode?address=" + curl.escapeUrl(i) + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  }
+
+  // the warm geocoders, the connection is kept alive
+  std::vector<double> warm;
+  std::size_t warm_bytes = 0;
+  asio::streambuf buffer;
+  for (std::size_t i = 0; i < requests; ++i)
+  {
+    const auto start = Clock::now();
+    asio::write(socket, asio::buffer(targets[i % targets.size()]));
+    const auto n = asio::read_until(socket, buffer, "\r\n\r\n");
+    const std::string header(asio::buffers_begin(buffer.data()), asio::buffers_begin(buffer.data()) + n);
+    buffer.consume(n);
+    const auto length = std::stoul(header.substr(header.find("Content-Length: ") + 16));
+    if (buffer.size() < length)
+    {
+      asio::read(socket, buffer, asio::transfer_exactly(length - buffer.size()));
+    }
+    buffer.consume(length);
+    warm_bytes += length;
+    warm.push_back(seconds(start));
+  }
+
+  server.stop();
+  thread.join();
+
+  std::sort(cold.begin(), cold.end());
+  std::sort(warm.begin(), warm.end());
+  const auto cold_p50 = cold[cold.size() / 2] * 1e3;
+  const auto warm_p50 = warm[warm.size() / 2] * 1e3;
+  const auto warm_p99 = warm[warm.size() * 99 / 100] * 1e3;
+
+  BOOST_CHECK_EQUAL(cold_found, cold.size());
+  BOOST_CHECK(warm_bytes > 0);
+
+  BOOST_TEST_MESSAGE("cold (geocoders per address): p50 " << cold_p50 << " ms");
+  BOOST_TEST_MESSAGE("warm (--serve, keep-alive): p50 " << warm_p50 << " ms, p99 " << warm_p99 << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/** @file bench_tabular.cpp
+ *  @brief the benchmark of the CSV and JSON Lines output (single thread, parallel formatting, stream formatting)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/tabular.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+geo::Answers makeAnswers(std::size_t count)
+{
+  std::mt19937 rand(42);
+  std::uniform_int_distribution<int> place(1, 3000);
+  std::uniform_int_distribution<int> street(1, 50000);
+  std::uniform_int_distribution<int> house(1, 300);
+  std::uniform_real_distribution<double> lat(43.0, 68.0);
+  std::uniform_real_distribution<double> lon(27.0, 60.0);
+
+  geo::Answers result(count);
+  for (auto &a : result)
+  {
+    a.type = geo::Answer::GeocoderType::yandex;
+    geo::Location loc;
+    loc.country = "Россия";
+    loc.place = "Город " + std::to_string(place(rand));
+    loc.street = "улица " + std::to_string(street(rand));
+    loc.house = std::to_string(house(rand));
+    loc.line = loc.country + ", " + loc.place + ", " + loc.street + ", " + loc.house;
+    // the geocoders return 6 decimals
+    loc.coord = geo::Coordinates(std::round(lat(rand) * 1e6) / 1e6, std::round(lon(rand) * 1e6) / 1e6);
+    a.locations.push_back(loc);
+  }
+  return result;
+}
+
+/** @brief the baseline: the csv by the string stream, the precision of the round trip */
+void printStream(const fs::path &filename, const geo::Answers &answers)
+{
+  std::ofstream fout(filename.string());
+  std::ostringstream out;
+  out << std::setprecision(17);
+  for (std::size_t i = 0; i < answers.size(); ++i)
+  {
+    for (const auto &l : answers[i].locations)
+    {
+      out << i + 1 << ',' << geo::Answer::GeoTypeToText(answers[i].type) << ",\"" << l.line << "\"," << l.country << ',' << l.region << ','
+          << l.district << ',' << l.place << ',' << l.suburb << ',' << l.street << ',' << l.house << ',' << l.coord.latitude << ','
+          << l.coord.longitude << ',' << geo::PrecisionToString(l.precision) << '\n';
+    }
+    const auto &txt = out.str();
+    fout.write(txt.c_str(), txt.length());
+    out.str(std::string());
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_tabular)
+
+BOOST_AUTO_TEST_CASE(bench_print)
+{
+  const std::size_t count = 400000;
+  const auto answers = makeAnswers(count);
+
+  const auto dir = fs::temp_directory_path() / fs::unique_path("geocoder_bench_tabular_%%%%%%");
+  fs::create_directories(dir);
+
+  auto start = Clock::now();
+  geo::print(dir / "output.txt", answers);
+  const auto text = seconds(start);
+
+  start = Clock::now();
+  printStream(dir / "stream.csv", answers);
+  const auto stream = seconds(start);
+
+  start = Clock::now();
+  geo::printTabular(dir / "single.csv", answers, geo::TabularFormat::csv, 1);
+  const auto csv_single = seconds(start);
+
+  start = Clock::now();
+  geo::printTabular(dir / "parallel.csv", answers, geo::TabularFormat::csv);
+  const auto csv_parallel = seconds(start);
+
+  start = Clock::now();
+  geo::printTabular(dir / "single.jsonl", answers, geo::TabularFormat::jsonl, 1);
+  const auto jsonl_single = seconds(start);
+
+  start = Clock::now();
+  geo::printTabular(dir / "parallel.jsonl", answers, geo::TabularFormat::jsonl);
+  const auto jsonl_parallel = seconds(start);
+
+  const auto csv_size = fs::file_size(dir / "parallel.csv");
+  const auto jsonl_size = fs::file_size(dir / "parallel.jsonl");
+  const auto equal = fs::file_size(dir / "single.csv") == csv_size && fs::file_size(dir / "single.jsonl") == jsonl_size;
+  fs::remove_all(dir);
+
+  BOOST_CHECK(equal);
+
+  BOOST_TEST_MESSAGE(count << " answers, csv " << csv_size << " bytes, jsonl " << jsonl_size << " bytes");
+  BOOST_TEST_MESSAGE("text (print) " << text << " s, csv by ostringstream " << stream << " s");
+  BOOST_TEST_MESSAGE("csv: single thread " << csv_single << " s, parallel " << csv_parallel << " s");
+  BOOST_TEST_MESSAGE("jsonl: single thread " << jsonl_single << " s, parallel " << jsonl_parallel << " s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
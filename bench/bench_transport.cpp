@@ -0,0 +1,92 @@
+/** @file bench_transport.cpp
+ *  @brief the benchmark of the shared LibCurl: the scaling of the requests by the threads (the pool of the handles
+ *  against the instance serialized by the lock)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/libcurl/libcurl.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using geocoder::utils::curl::LibCurl;
+
+const std::size_t per_thread = 200;
+
+/** @brief requests per second of the threads */
+template <typename Function>
+double run(std::size_t threads, Function fn)
+{
+  const auto start = Clock::now();
+
+  std::vector<std::future<void>> futures;
+  for (std::size_t i = 0; i < threads; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&fn] {
+      std::string body;
+      for (std::size_t n = 0; n < per_thread; ++n)
+      {
+        fn(body);
+      }
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  return static_cast<double>(threads * per_thread) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(bench_transport)
+
+BOOST_AUTO_TEST_CASE(bench_scaling)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+
+  // the latency of the geocoder dominates: the requests in flight scale the throughput
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(2);
+  mock.threads = 16;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+  const auto url = server.url() + LibCurl::escapeUrl(data.begin()->first);
+
+  double single = 0.0;
+  for (std::size_t threads : {1, 2, 4, 8, 16})
+  {
+    LibCurl curl;
+    const auto rps = run(threads, [&](std::string &body) { curl.get(url, body); });
+    single = (threads == 1) ? rps : single;
+    BOOST_TEST_MESSAGE("shared LibCurl, pool of the handles, threads " << threads << ": " << rps << " req/s, scaling " << rps / single);
+  }
+
+  // the lock around the whole request (as the instance with one handle): the throughput of the one thread
+  for (std::size_t threads : {1, 4, 16})
+  {
+    LibCurl curl;
+    std::mutex lock;
+    const auto rps = run(threads, [&](std::string &body) {
+      std::lock_guard<std::mutex> locker(lock);
+      curl.get(url, body);
+    });
+    BOOST_TEST_MESSAGE("shared LibCurl, serialized by the lock, threads " << threads << ": " << rps << " req/s");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,7 +21,8 @@ struct Answer
   enum class GeocoderType
   {
     unknown = -1,
-    yandex = 0
+    yandex = 0,
+    local = 1  ///< the local index, without network
   };
 
   static inline std::string GeoTypeToText(GeocoderType type)
@@ -30,6 +31,8 @@ struct Answer
     {
       case GeocoderType::yandex:
         return "yandex";
+      case GeocoderType::local:
+        return "local";
       case GeocoderType::unknown:
         return "unknown";
       default:
@@ -37,6 +40,26 @@ struct Answer
     }
   }
 
+  static inline GeocoderType TextToGeoType(const std::string &type)
+  {
+    if (type == "yandex")
+    {
+      return GeocoderType::yandex;
+    }
+    else if (type == "local")
+    {
+      return GeocoderType::local;
+    }
+    else if (type == "unknown")
+    {
+      return GeocoderType::unknown;
+    }
+    else
+    {
+      throw std::runtime_error("[Answer::TextToGeoType]: unknown type geocoder '" + type + "'");
+    }
+  }
+
   Locations locations;
   GeocoderType type = GeocoderType::unknown;
 };
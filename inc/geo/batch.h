@@ -0,0 +1,117 @@
+/** @file batch.h
+ *  @brief the define of the batch geocoding pipeline (read, geocode, print)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_BATCH_H_
+#define GEOCODER_GEO_BATCH_H_
+
+// std
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+// this
+#include "geo/answer.h"
+
+namespace geocoder
+{
+namespace geo
+{
+using Answers = std::vector<Answer>;
+using Addresses = std::vector<std::string>;
+
+class Journal;
+
+/** @brief read addresses from file (one address per line)
+ *  @param filename - address filename
+ *  @return addresses
+ */
+Addresses readFromFile(const boost::filesystem::path &filename);
+/** @brief the hash of the address (FNV-1a), stable between the runs and the hosts */
+std::uint64_t hashAddress(const std::string &address);
+
+/** @struct Shard
+ *  @brief the slice of the input of the process ('--shard index/count')
+ */
+struct Shard
+{
+  enum class Key
+  {
+    line = 0,  ///< the number of the line modulo count
+    hash       ///< the hash of the address modulo count, the same address is geocoded by the same shard (cache affinity)
+  };
+
+  std::size_t index{0};
+  std::size_t count{1};
+  Key key{Key::line};
+};
+
+/** @brief parse 'index/count', index < count
+ *  @throw std::runtime_error - invalid shard
+ */
+Shard parseShard(const std::string &text, Shard::Key key = Shard::Key::line);
+
+/** @brief the addresses of the shard in the order of the input
+ *  @param [out] ids - the numbers of the lines of the addresses (starting at 1), the ids of the output rows
+ */
+Addresses selectShard(const Addresses &addrs, const Shard &shard, std::vector<std::size_t> &ids);
+
+/** @brief geocoding addresses
+ *  @param addrs - addresses
+ *  @param conf - configuration document
+ *  @return answers, the answer per address (in order of addresses)
+ */
+Answers geocode(const Addresses &addrs, const boost::property_tree::ptree &conf);
+/** @brief geocoding addresses with the checkpoints
+ *  @param [in,out] answers - the answer per address, the answers of the completed addresses are kept
+ *  @param done - the completed addresses (Journal::load) are not geocoded, empty - none
+ *  @param journal - the journal of the completed addresses (found or not found, the transient failures are not journaled), nullptr - none
+ */
+void geocode(const Addresses &addrs, const boost::property_tree::ptree &conf, Answers &answers, const std::vector<bool> &done, Journal *journal);
+/** @brief print answers to file
+ *  @param filename - output filename
+ *  @param answers - answers
+ */
+void print(const boost::filesystem::path &filename, const Answers &answers);
+/** @brief append the answer in the text format of 'print' */
+void appendText(const Answer &answer, std::string &out);
+
+/** @struct StreamOptions
+ *  @brief the options of the filter mode (config section 'document.stream')
+ */
+struct StreamOptions
+{
+  /** @brief format of the output: text, csv, jsonl */
+  std::string format{"text"};
+  /** @brief maximum count of the addresses taken from the input at once, at most two batches are not written */
+  std::size_t batch{256};
+  /** @brief count of the workers, each has own thread and GeoPool for the whole stream */
+  std::size_t threads{2};
+};
+
+/** @brief the filter: read the addresses (one per line) from the descriptor, write the answers as they complete
+ *  @details the answers are written and flushed in the order of the input, the slow address holds back only the answers after it;
+ *  the input is read while the addresses are geocoded, it is not buffered as a whole;
+ *  the id of the answer is the number of the address line (starting at 1)
+ *  @param in - input descriptor (STDIN_FILENO)
+ *  @param out - output stream (stdout)
+ *  @param conf - configuration document (geocoders)
+ *  @return count of the addresses
+ *  @throw std::runtime_error - unknown format, failed read or write
+ */
+std::size_t geocodeStream(int in, std::FILE *out, const boost::property_tree::ptree &conf, const StreamOptions &options);
+/** @brief read answers from file written by 'print'
+ *  @param filename - filename
+ *  @return answers
+ */
+Answers readAnswers(const boost::filesystem::path &filename);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,132 @@
+/** @file columnar.h
+ *  @brief the define of the columnar binary output (writer and zero-copy memory-mapped reader)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_COLUMNAR_H_
+#define GEOCODER_GEO_COLUMNAR_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_view.hpp>
+
+// this
+#include "geo/batch.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief write answers to the columnar file
+ *  @details layout (little endian, the columns are aligned by 8): header, directory of the columns, columns.
+ *  The table of the answers: 'type' (i8), 'first' (u32, answers + 1, the first location of the answer).
+ *  The table of the locations: 'latitude', 'longitude' (f64), 'precision' (u8) and the dictionary encoded strings
+ *  'line', 'country', 'region', 'district', 'place', 'suburb', 'street', 'house' (u32 codes, u32 offsets of the entries, bytes)
+ *  @throw std::runtime_error - failed write, the locations or the strings of the column do not fit the u32 offsets
+ */
+void printColumnar(const boost::filesystem::path &filename, const Answers &answers);
+
+/** @brief the file is written by 'printColumnar' (by the signature) */
+bool isColumnarFile(const boost::filesystem::path &filename);
+
+/** @struct ColumnSpan
+ *  @brief the column of the fixed width values in the mapped file (zero copy)
+ */
+template <class T>
+struct ColumnSpan
+{
+  const T *data{nullptr};
+  std::size_t size{0};
+
+  const T *begin() const { return data; }
+  const T *end() const { return data + size; }
+  const T &operator[](std::size_t i) const { return data[i]; }
+};
+
+/** @class StringColumn
+ *  @brief the dictionary encoded column of the strings in the mapped file (zero copy)
+ */
+class StringColumn final
+{
+ public:
+  StringColumn() = default;
+  StringColumn(const std::uint32_t *codes, std::size_t size, const std::uint32_t *offsets, std::size_t entries, const char *bytes)
+   : codes_(codes)
+   , size_(size)
+   , offsets_(offsets)
+   , entries_(entries)
+   , bytes_(bytes)
+  {
+  }
+
+  /** @brief count of the rows */
+  std::size_t size() const { return size_; }
+  /** @brief count of the unique values */
+  std::size_t entries() const { return entries_; }
+  /** @brief the code of the row (number of the entry of the dictionary) */
+  std::uint32_t code(std::size_t row) const { return codes_[row]; }
+  /** @brief the entry of the dictionary */
+  boost::string_view entry(std::uint32_t code) const { return boost::string_view(bytes_ + offsets_[code], offsets_[code + 1] - offsets_[code]); }
+  /** @brief the value of the row */
+  boost::string_view operator[](std::size_t row) const { return entry(codes_[row]); }
+
+ private:
+  const std::uint32_t *codes_{nullptr};
+  std::size_t size_{0};
+  const std::uint32_t *offsets_{nullptr};
+  std::size_t entries_{0};
+  const char *bytes_{nullptr};
+};
+
+/** @class ColumnarReader
+ *  @brief the read only memory-mapped columnar file, thread safe
+ *  @details the columns are the views of the mapped file, valid while the reader is alive
+ */
+class ColumnarReader final
+{
+ public:
+  /** @throw std::runtime_error - is not found file or invalid format */
+  explicit ColumnarReader(const boost::filesystem::path &filename);
+  ColumnarReader(ColumnarReader &&);
+  ColumnarReader &operator=(ColumnarReader &&);
+  ColumnarReader(const ColumnarReader &) = delete;
+  ColumnarReader &operator=(const ColumnarReader &) = delete;
+  ~ColumnarReader();
+
+  /** @brief count of the answers */
+  std::size_t answers() const;
+  /** @brief count of the locations (rows) */
+  std::size_t rows() const;
+
+  /** @brief Answer::GeocoderType of the answers */
+  ColumnSpan<std::int8_t> type() const;
+  /** @brief the first row of the answers (answers + 1), the locations of the answer i: [first[i], first[i + 1]) */
+  ColumnSpan<std::uint32_t> first() const;
+
+  ColumnSpan<double> latitude() const;
+  ColumnSpan<double> longitude() const;
+  /** @brief Precision of the locations */
+  ColumnSpan<std::uint8_t> precision() const;
+  /** @brief the string column by name: line, country, region, district, place, suburb, street, house
+   *  @throw std::runtime_error - unknown column
+   */
+  StringColumn strings(const std::string &name) const;
+
+  /** @brief copy the answer */
+  Answer answer(std::size_t i) const;
+  /** @brief copy the all answers */
+  Answers read() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
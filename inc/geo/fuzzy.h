@@ -0,0 +1,84 @@
+/** @file fuzzy.h
+ *  @brief the define of the class FuzzyIndex (fuzzy address matching: character trigrams and bounded edit distance)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_FUZZY_H_
+#define GEOCODER_GEO_FUZZY_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// this
+#include "geo/gazetteer.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief levenshtein distance of the UTF-8 strings (by code points) bounded by 'max'
+ *  @details bit-parallel (Myers/Hyyro, 64 code points per machine word) for the pattern up to 64 code points,
+ *  the banded dynamic programming otherwise
+ *  @return distance, 'max' + 1 - the distance is greater than 'max'
+ */
+std::size_t editDistance(const std::string &lhs, const std::string &rhs, std::size_t max);
+
+/** @struct FuzzyOptions
+ *  @brief the parameters of the fuzzy matching
+ */
+struct FuzzyOptions
+{
+  /** @brief minimum score (1 - distance / length) of the accepted match */
+  double threshold{0.85};
+  /** @brief maximum edit distance (code points) */
+  std::size_t max_distance{3};
+  /** @brief count of the best candidates by the trigrams are verified by the edit distance */
+  std::size_t candidates{32};
+  /** @brief the digits (house numbers) of the query and the key are equal, only the words are corrected */
+  bool exact_numbers{true};
+};
+
+/** @class FuzzyIndex
+ *  @brief the inverted index of the character trigrams over the normalized keys of the gazetteer, thread safe for the queries
+ *  @details the candidates are ranked by the Dice coefficient of the trigrams and verified by 'editDistance'
+ */
+class FuzzyIndex final
+{
+ public:
+  struct Match
+  {
+    /** @brief the normalized key */
+    std::string key;
+    /** @brief the records of the gazetteer */
+    std::vector<std::uint32_t> ids;
+    std::size_t distance{0};
+    /** @brief 1 - distance / max(length of the key, length of the query) */
+    double score{0.0};
+  };
+
+  using Matches = std::vector<Match>;
+
+  /** @brief index the all keys of the gazetteer (the gazetteer is not used after the construction) */
+  explicit FuzzyIndex(const Gazetteer &gazetteer);
+  FuzzyIndex(FuzzyIndex &&);
+  FuzzyIndex &operator=(FuzzyIndex &&);
+  FuzzyIndex(const FuzzyIndex &) = delete;
+  FuzzyIndex &operator=(const FuzzyIndex &) = delete;
+  ~FuzzyIndex();
+
+  /** @brief count of the unique keys */
+  std::size_t size() const;
+  /** @brief the matches of the address (is normalized) with the score not less than threshold, ordered by score */
+  Matches match(const std::string &address, const FuzzyOptions &options = FuzzyOptions()) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,97 @@
+/** @file gazetteer.h
+ *  @brief the define of the offline gazetteer index (builder and memory-mapped reader)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_GAZETTEER_H_
+#define GEOCODER_GEO_GAZETTEER_H_
+
+// std
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+
+// this
+#include "geo/location.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief read gazetteer csv: country;region;district;place;suburb;street;house;latitude;longitude[;precision]
+ *  @details the empty lines and the lines started with '#' are skipped, the default precision is 'exact'
+ *  @throw std::runtime_error - invalid line
+ */
+Locations readGazetteerCsv(const boost::filesystem::path &filename);
+
+/** @class GazetteerBuilder
+ *  @brief compile the locations into the index file
+ *  @details layout: header, the sorted normalized keys (front coded blocks of 16 keys, the offsets of the blocks),
+ *  the records (coordinates, precision, the offsets of the fields) and the pool of the unique strings
+ */
+class GazetteerBuilder final
+{
+ public:
+  GazetteerBuilder();
+  GazetteerBuilder(const GazetteerBuilder &) = delete;
+  GazetteerBuilder &operator=(const GazetteerBuilder &) = delete;
+  ~GazetteerBuilder();
+
+  /** @brief add location by the normalized keys of the location (see 'normalizedKeys') */
+  void add(const Location &loc);
+  /** @brief add location by the given key (is normalized) */
+  void add(const std::string &key, const Location &loc);
+  /** @brief write index
+   *  @throw std::runtime_error - failed write
+   */
+  void write(const boost::filesystem::path &filename) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** @class Gazetteer
+ *  @brief the read only memory-mapped index, thread safe
+ */
+class Gazetteer final
+{
+ public:
+  /** @throw std::runtime_error - is not found file or invalid format (the sections, the blocks of the keys) */
+  explicit Gazetteer(const boost::filesystem::path &filename);
+  Gazetteer(Gazetteer &&);
+  Gazetteer &operator=(Gazetteer &&);
+  Gazetteer(const Gazetteer &) = delete;
+  Gazetteer &operator=(const Gazetteer &) = delete;
+  ~Gazetteer();
+
+  /** @brief count of the keys */
+  std::size_t size() const;
+  /** @brief count of the locations */
+  std::size_t records() const;
+  /** @brief the locations of the address (is normalized), empty - is not found
+   *  @throw std::runtime_error - the corrupt key or record
+   */
+  Locations find(const std::string &address) const;
+  /** @brief the location by number of the record
+   *  @throw std::runtime_error - invalid number, the string of the record is beyond the file
+   */
+  Location record(std::uint32_t id) const;
+  /** @brief visit the keys (normalized) in the sorted order starting with 'prefix'
+   *  @param fn - callback(key, record id), return false - stop
+   */
+  void forEachPrefix(const std::string &prefix, const std::function<bool(const std::string &, std::uint32_t)> &fn) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -7,7 +7,9 @@
 #define GEOCODER_GEO_GEOCODERBASE_H_
 
 // std
+#include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 
@@ -16,15 +18,37 @@
 
 // this
 #include "geo/answer.h"
+#include "geo/parse_options.h"
 
 namespace geocoder
 {
 namespace geo
 {
+/** @class ResponseError
+ *  @brief the error response of the geocoder (the code 400 and above)
+ */
+class ResponseError final : public std::runtime_error
+{
+ public:
+  ResponseError(const std::string &what, long code)
+   : std::runtime_error(what)
+   , code_(code)
+  {
+  }
+
+  long code() const { return code_; }
+  /** @brief the address is rejected by the geocoder (4xx except the key, the timeout and the rate: 401, 403, 408, 429) */
+  bool rejected() const { return code_ >= 400 && code_ < 500 && code_ != 401 && code_ != 403 && code_ != 408 && code_ != 429; }
+
+ private:
+  long code_;
+};
+
 class GeocoderBase
 {
  public:
   using Result = std::tuple<bool, Answer>;
+  using Clock = std::chrono::steady_clock;
 
  public:
   explicit GeocoderBase(const boost::property_tree::ptree &conf);
@@ -32,11 +56,28 @@ class GeocoderBase
   GeocoderBase &operator=(GeocoderBase &&);
   GeocoderBase(const GeocoderBase &) = delete;
   GeocoderBase &operator=(const GeocoderBase &) = delete;
-  ~GeocoderBase();
-  Result geocode(const std::string &address);
+  virtual ~GeocoderBase();
+  /** @param options - the locations of the answer (the parse stops early, see ParseOptions) */
+  virtual Result geocode(const std::string &address, const ParseOptions &options = ParseOptions());
+  /** @brief the deadline of the next requests: the timeout is the rest of the deadline,
+   *  the request is not started (std::runtime_error) if the rest is less than 'min_request'
+   *  @param deadline - Clock::time_point::max() - the timeouts of the connection only
+   */
+  void setDeadline(Clock::time_point deadline, std::chrono::milliseconds min_request = std::chrono::milliseconds(0));
+  /** @brief open the connections before the first request (http head), the local geocoder - nothing
+   *  @param connections - the count of the connections of the http/2 multiplexer (up to 'max_connections'),
+   *  http/1.1 - one connection of the worker per url of the endpoints
+   *  @throw std::runtime_error - the failed request
+   */
+  void warmup(std::size_t connections = 1);
 
  protected:
-  virtual Result parse(const std::string &buffer) = 0;
+  /** @brief the provider without http connection (local index), must override 'geocode' */
+  GeocoderBase();
+
+  virtual Result parse(const std::string &buffer, const ParseOptions &options) = 0;
+  /** @brief the additional parameters of the request, appended after the address ("&name=value...") */
+  void setParams(const std::string &params);
 
  private:
   class Impl;
@@ -0,0 +1,23 @@
+/** @file geolocal.h
+ *  @brief the define of the function factory local geocoder (offline gazetteer index)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_GEOLOCAL_H_
+#define GEOCODER_GEO_GEOLOCAL_H_
+
+// this
+#include "geo/geocoderbase.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief create local geocoder
+ *  @param conf - section 'geocoder': name (local), index (the file of the gazetteer index)
+ */
+GeocoderPtr createLocalGeocoder(const boost::property_tree::ptree &conf);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
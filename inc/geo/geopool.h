@@ -7,6 +7,7 @@
 #define GEOCODER_GEO_GEOPOOL_H_
 
 // std
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -16,6 +17,7 @@
 // this
 #include "geo/answer.h"
 #include "geo/location.h"
+#include "geo/parse_options.h"
 
 namespace geocoder
 {
@@ -24,13 +26,32 @@ namespace geo
 class GeoPool final
 {
  public:
+  /** @brief the result of the last geocode */
+  enum class Status
+  {
+    found = 0,  ///< the answer of the geocoder
+    not_found,  ///< the empty answers and the rejected address (4xx) of the all geocoders, the negative cache
+    failed      ///< the transient error (429, 5xx, the timeout, the deadline): the address is to be requested again
+  };
+
   explicit GeoPool(const boost::property_tree::ptree &conf);
   GeoPool(GeoPool &&);
   GeoPool &operator=(GeoPool &&);
   GeoPool(const GeoPool &) = delete;
   GeoPool &operator=(const GeoPool &) = delete;
   ~GeoPool();
+  /** @brief the options of the config section 'document.parse' */
   Answer geocode(const std::string &address);
+  Answer geocode(const std::string &address, const ParseOptions &options);
+  const ParseOptions &parseOptions() const;
+  /** @brief the status of the last geocode */
+  Status status() const;
+  /** @brief open the connections of the geocoders (config section 'document.prewarm'), the errors are logged */
+  void warmup();
+  /** @brief the period of the keep-alive while idle, 0 - disabled */
+  std::chrono::seconds keepAlivePeriod() const;
+  /** @brief the warm-up if the pool is idle longer than the period of the keep-alive */
+  void keepAlive();
 
  private:
   class Impl;
@@ -14,6 +14,15 @@ namespace geocoder
 namespace geo
 {
 GeocoderPtr createYandexGeocoder(const boost::property_tree::ptree &conf);
+
+/** @brief parse the answer of the yandex geocoder, format=xml (default)
+ *  @details the document is read whole (DOM), the rejected locations and the fields out of 'options' are not walked
+ */
+Locations parseYandexXml(const std::string &buffer, const ParseOptions &options = ParseOptions());
+/** @brief parse the answer of the yandex geocoder, format=json (single pass, without DOM)
+ *  @details the reading stops after 'options.max_results' of the accepted locations
+ */
+Locations parseYandexJson(const std::string &buffer, const ParseOptions &options = ParseOptions());
 }
 }  // namespace geocoder
 
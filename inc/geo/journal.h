@@ -0,0 +1,67 @@
+/** @file journal.h
+ *  @brief the define of the class Journal (the append-only progress of the batch, checkpoint and resume)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_JOURNAL_H_
+#define GEOCODER_GEO_JOURNAL_H_
+
+// std
+#include <memory>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+
+// this
+#include "geo/batch.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @class Journal
+ *  @brief the journal of the completed addresses: the number of the address line, the hash of the address and the answer
+ *  @details the records are framed by the size and crc32, the records are written and flushed in groups;
+ *  the torn tail of the crashed run is truncated on open. Thread safe.
+ */
+class Journal final
+{
+ public:
+  /** @brief open the journal for append, the missing or empty file is created
+   *  @param group - count of the records per write
+   *  @throw std::runtime_error - failed open, the file is not the journal (is not overwritten)
+   */
+  explicit Journal(const boost::filesystem::path &filename, std::size_t group = 1024);
+  Journal(Journal &&);
+  Journal &operator=(Journal &&);
+  /** @brief write the rest of the records */
+  ~Journal();
+
+  /** @brief the completed address, the record is written with the group
+   *  @param index - the number of the address (starting at 0)
+   */
+  void append(std::size_t index, const std::string &address, const Answer &answer);
+  /** @brief write the records of the group and flush the file
+   *  @throw std::runtime_error - failed write
+   */
+  void flush();
+
+  /** @brief read the answers of the addresses from the journal
+   *  @details the records of the other addresses (the number is out of range, the hash differs) are ignored
+   *  @param [out] answers - the answer per address
+   *  @param [out] done - the address is completed
+   *  @return count of the completed addresses
+   */
+  static std::size_t load(const boost::filesystem::path &filename, const Addresses &addrs, Answers &answers, std::vector<bool> &done);
+  /** @brief the file starts with the signature of the journal */
+  static bool isJournal(const boost::filesystem::path &filename);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
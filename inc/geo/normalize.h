@@ -0,0 +1,33 @@
+/** @file normalize.h
+ *  @brief the define of the normalization of the address text (the keys of the local indexes)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_NORMALIZE_H_
+#define GEOCODER_GEO_NORMALIZE_H_
+
+// std
+#include <string>
+#include <vector>
+
+// this
+#include "geo/location.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief normalize address (UTF-8)
+ *  @details lower case (latin, cyrillic, 'ё' -> 'е'), punctuation and '-' -> space,
+ *  the types of the streets and settlements ("улица", "ул.", "г." ...) are removed, one space between words
+ *  @example "Москва, ул. Пришвина, д. 8к2" -> "москва пришвина 8к2"
+ */
+std::string normalize(const std::string &address);
+/** @brief the normalized keys of the location: "place street house", "region place street house",
+ *  "country region place street house" (without duplicates)
+ */
+std::vector<std::string> normalizedKeys(const Location &loc);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,70 @@
+/** @file parse_options.h
+ *  @brief the define of the struct ParseOptions (the projection of the answer of the geocoder)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_PARSE_OPTIONS_H_
+#define GEOCODER_GEO_PARSE_OPTIONS_H_
+
+// std
+#include <cstdint>
+#include <string>
+
+// boost
+#include <boost/property_tree/ptree_fwd.hpp>
+
+// this
+#include "geo/location.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @struct ParseOptions
+ *  @brief the locations of the answer: the count, the worst precision and the text fields to fill
+ *  @details the coordinates and the precision are filled always
+ */
+struct ParseOptions
+{
+  enum Field : std::uint32_t
+  {
+    line = 1 << 0,
+    country = 1 << 1,
+    region = 1 << 2,
+    district = 1 << 3,
+    place = 1 << 4,
+    suburb = 1 << 5,
+    street = 1 << 6,
+    house = 1 << 7,
+    all = (1 << 8) - 1
+  };
+
+  /** @brief 0 - the all locations of the answer */
+  std::size_t max_results{0};
+  /** @brief the worst accepted precision (Precision::other - any) */
+  Precision min_precision{Precision::other};
+  /** @brief the set of Field */
+  std::uint32_t fields{all};
+
+  bool accept(Precision p) const { return static_cast<int>(p) <= static_cast<int>(min_precision); }
+  bool has(Field f) const { return (fields & f) != 0; }
+  /** @brief the locations are not filtered (the empty answer is the answer of the geocoder) */
+  bool complete() const { return min_precision == Precision::other; }
+};
+
+/** @brief the fields by the names separated by comma ("line,street,house"), "all"
+ *  @throw std::runtime_error - unknown name
+ */
+std::uint32_t textToFields(const std::string &text);
+
+/** @brief read the options of the config section 'parse': max_results, min_precision, fields
+ *  @throw std::runtime_error - unknown precision or field
+ */
+ParseOptions readParseOptions(const boost::property_tree::ptree &parse);
+
+/** @brief apply the options to the locations parsed without them (the local geocoder) */
+void applyParseOptions(const ParseOptions &options, Locations &locs);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
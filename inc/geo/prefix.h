@@ -0,0 +1,69 @@
+/** @file prefix.h
+ *  @brief the define of the class PrefixIndex (autocomplete of the partial address over the known locations)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_PREFIX_H_
+#define GEOCODER_GEO_PREFIX_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// this
+#include "geo/location.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @class PrefixIndex
+ *  @brief the top-k completions of the partial address by the popularity of the locations, thread safe for the queries
+ *  @details the normalized keys are sorted in the one buffer, so the completions of the prefix are the range of the keys
+ *  (binary search). The best of the range is found by the range maximum query (the sparse table over the blocks of 64 keys)
+ *  and the next ones by the priority queue of the subranges: O(log n + k log k) independent of the size of the range
+ */
+class PrefixIndex final
+{
+ public:
+  struct Match
+  {
+    const Location *location{nullptr};
+    /** @brief the completed normalized key */
+    std::string key;
+    /** @brief count of the equal locations in the source */
+    std::uint32_t weight{0};
+  };
+
+  using Matches = std::vector<Match>;
+
+  /** @brief build index
+   *  @details the equal locations (line and coordinates) are merged, the weight is the count of the merged,
+   *  the keys are 'normalizedKeys' and 'street house' (the address is started from the street)
+   */
+  explicit PrefixIndex(Locations locs);
+  PrefixIndex(PrefixIndex &&);
+  PrefixIndex &operator=(PrefixIndex &&);
+  PrefixIndex(const PrefixIndex &) = delete;
+  PrefixIndex &operator=(const PrefixIndex &) = delete;
+  ~PrefixIndex();
+
+  /** @brief count of the keys */
+  std::size_t size() const;
+  /** @brief count of the unique locations */
+  std::size_t locations() const;
+  /** @brief the best 'k' locations of the partial address (is normalized), ordered by weight
+   *  @details the text ended by the separator completes the whole words only ("москва " is not "москворецкая")
+   */
+  Matches complete(const std::string &text, std::size_t k = 10) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,86 @@
+/** @file reverse.h
+ *  @brief the define of the class ReverseIndex (local reverse geocoding: coordinates -> nearest known location)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_REVERSE_H_
+#define GEOCODER_GEO_REVERSE_H_
+
+// std
+#include <limits>
+#include <memory>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+
+// this
+#include "geo/location.h"
+
+namespace geocoder
+{
+namespace geo
+{
+/** @brief great circle distance (meters) */
+double distance(const Coordinates &lhs, const Coordinates &rhs);
+
+/** @class ReverseIndex
+ *  @brief the static R-tree (packed on build) over the known locations, thread safe for the queries
+ *  @details the points are stored on the unit sphere (x, y, z), so the nearest by the chord is the nearest
+ *  by the great circle, without the distortion near the poles and the antimeridian
+ */
+class ReverseIndex final
+{
+ public:
+  struct Match
+  {
+    /** @brief nullptr - is not found */
+    const Location *location{nullptr};
+    /** @brief meters */
+    double distance{std::numeric_limits<double>::infinity()};
+  };
+
+  using Matches = std::vector<Match>;
+
+  /** @brief build index, the locations with invalid coordinates are skipped */
+  explicit ReverseIndex(Locations locs);
+  ReverseIndex(ReverseIndex &&);
+  ReverseIndex &operator=(ReverseIndex &&);
+  ReverseIndex(const ReverseIndex &) = delete;
+  ReverseIndex &operator=(const ReverseIndex &) = delete;
+  ~ReverseIndex();
+
+  std::size_t size() const;
+  /** @brief k nearest locations, ordered by distance
+   *  @param coord - point
+   *  @param k - count
+   *  @param max_distance - maximum distance (meters)
+   */
+  Matches nearest(const Coordinates &coord, std::size_t k = 1,
+                  double max_distance = std::numeric_limits<double>::infinity()) const;
+  /** @brief batch: the nearest location for each point
+   *  @param points - points
+   *  @param max_distance - maximum distance (meters)
+   *  @param threads - count of the threads, 0 - hardware concurrency
+   *  @return the match per point (in order of points)
+   */
+  Matches nearest(const std::vector<Coordinates> &points, double max_distance = std::numeric_limits<double>::infinity(),
+                  std::size_t threads = 0) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** @brief load known locations
+ *  @param path - the output file of the geocoder (see 'print', 'printColumnar') or the directory of the recorded responses
+ */
+Locations loadLocations(const boost::filesystem::path &path);
+/** @brief read points from file, one point 'latitude longitude' per line (separators: space, ';', ',')
+ *  @throw std::runtime_error - invalid line
+ */
+std::vector<Coordinates> readPoints(const boost::filesystem::path &filename);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
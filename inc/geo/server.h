@@ -0,0 +1,71 @@
+/** @file server.h
+ *  @brief the define of the class Server (the daemon mode: the geocoding over HTTP with the warm geocoders)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_SERVER_H_
+#define GEOCODER_GEO_SERVER_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// boost
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace geocoder
+{
+namespace geo
+{
+/** @struct ServerOptions
+ *  @brief the options of the server (config section 'document.server')
+ */
+struct ServerOptions
+{
+  /** @brief 'host:port' (port 0 - ephemeral) or 'unix:path' */
+  std::string endpoint{"127.0.0.1:8080"};
+  /** @brief count of the workers (the connections are served in parallel), each has own GeoPool */
+  std::size_t threads{4};
+  /** @brief maximum size of the body of the request, bytes */
+  std::size_t max_body{1 << 20};
+  /** @brief maximum count of the addresses of the batch (413), the batch is geocoded by the workers in parts */
+  std::size_t max_batch{10000};
+  /** @brief stop by SIGINT, SIGTERM */
+  bool signals{false};
+};
+
+/** @class Server
+ *  @brief HTTP/1.1 (keep-alive) server of the geocoding, the answers are JSON Lines (one row per location, see TabularFormat::jsonl)
+ *  @details GET /geocode?address=... - the address (id 1);
+ *  POST /geocode - the batch: the json array of the strings or the addresses one per line (id - the number of the address),
+ *  the parts of the batch are queued to the workers, so the batch does not hold the worker for the whole time;
+ *  the parameters of /geocode 'results', 'precision', 'fields' override the config section 'parse' (see ParseOptions);
+ *  GET /health; GET /metrics - the metrics, 'name value' per line
+ */
+class Server final
+{
+ public:
+  /** @param conf - configuration document (geocoders)
+   *  @throw std::runtime_error - invalid endpoint, failed listen
+   */
+  Server(const boost::property_tree::ptree &conf, const ServerOptions &options);
+  Server(const Server &) = delete;
+  Server &operator=(const Server &) = delete;
+  ~Server();
+
+  /** @brief serve until 'stop' (or the signal) */
+  void run();
+  /** @brief stop the server, thread safe */
+  void stop();
+  /** @brief the port of the tcp endpoint (0 - unix socket) */
+  std::uint16_t port() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
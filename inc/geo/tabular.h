@@ -0,0 +1,61 @@
+/** @file tabular.h
+ *  @brief the define of the machine readable output: CSV and JSON Lines (one row per location)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_GEO_TABULAR_H_
+#define GEOCODER_GEO_TABULAR_H_
+
+// std
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+
+// this
+#include "geo/batch.h"
+
+namespace geocoder
+{
+namespace geo
+{
+enum class TabularFormat
+{
+  csv = 0,  ///< RFC 4180, the header row, the fields are quoted on demand
+  jsonl     ///< the json object per line
+};
+
+/** @brief append the shortest decimal of the value that is read back to the same double
+ *  @details the non finite values are not appended
+ */
+void appendDouble(double value, std::string &out);
+
+/** @brief append the header of the format (csv: the names of the columns, jsonl: nothing) */
+void appendHeader(TabularFormat format, std::string &out);
+
+/** @brief append the rows of the answer, one row per location
+ *  @details the columns: id, type, line, country, region, district, place, suburb, street, house, latitude, longitude, precision
+ *  @param id - the input line id (the number of the address line, starting at 1)
+ */
+void appendRows(TabularFormat format, std::size_t id, const Answer &answer, std::string &out);
+
+/** @brief print answers to file, one row per location, the id of the answer i is i + 1
+ *  @details the blocks of the answers are formatted on the threads to the reused buffers and written in order
+ *  @param threads - count of the threads, 0 - hardware concurrency
+ *  @param ids - the ids of the answers (the numbers of the lines of the shard, see selectShard), empty - i + 1
+ *  @throw std::runtime_error - failed write
+ */
+void printTabular(const boost::filesystem::path &filename, const Answers &answers, TabularFormat format, std::size_t threads = 0,
+                  const std::vector<std::size_t> &ids = std::vector<std::size_t>());
+
+/** @brief merge the outputs of the shards (csv or jsonl) into the order of the input by the ids
+ *  @details the streaming k-way merge, the rows of the shard are read once; the format is detected by the header of csv, the empty shard
+ *  (no lines) matches any format
+ *  @throw std::runtime_error - failed open, different formats, the ids of the shard are not ascending, failed write
+ */
+void mergeTabular(const std::vector<boost::filesystem::path> &inputs, const boost::filesystem::path &output);
+}  // namespace geo
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,91 @@
+/** @file balancer.h
+ *  @brief the define of the class Balancer (the endpoints and the api keys of the geocoder with the weights and the daily quotas)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_BALANCER_H_
+#define GEOCODER_UTILS_BALANCER_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace geocoder
+{
+namespace utils
+{
+/** @struct Endpoint
+ *  @brief the url and the api key of the geocoder
+ */
+struct Endpoint
+{
+  /** @brief the name of the usage counters, stable between the runs */
+  std::string id;
+  std::string url;
+  /** @brief the api key, appended to the request as '&<key_param>=<key>', empty - the key is in the url */
+  std::string key;
+  std::size_t weight{1};
+  /** @brief requests per day (UTC), 0 - unlimited */
+  std::uint64_t quota{0};
+};
+
+using Endpoints = std::vector<Endpoint>;
+
+/** @brief read the endpoints of the config section 'connection'
+ *  @details 'endpoints.endpoint' (id, url, key, weight, quota), the default of the url is 'connection.url',
+ *  the default of the id is the number of the endpoint; without the section - the single endpoint 'connection.url'
+ *  @throw std::runtime_error - is not set url, zero weight
+ */
+Endpoints readEndpoints(const boost::property_tree::ptree &connection);
+
+/** @class Balancer
+ *  @brief the distribution of the requests between the endpoints by the weights (smooth weighted round robin), thread safe
+ *  @details the endpoints with the exhausted quota are skipped until the end of the day (UTC),
+ *  the requests of the day are stored to the usage file and are read on the next run
+ */
+class Balancer final
+{
+ public:
+  /** @param endpoints - endpoints
+   *  @param usage - the usage file, empty - is not stored
+   *  @param flush - the usage file is written each 'flush' requests and on destruction
+   */
+  Balancer(Endpoints endpoints, const boost::filesystem::path &usage = boost::filesystem::path(), std::size_t flush = 100);
+  Balancer(const Balancer &) = delete;
+  Balancer &operator=(const Balancer &) = delete;
+  ~Balancer();
+
+  /** @brief the next endpoint, the request is counted
+   *  @throw std::runtime_error - the quotas of the all endpoints are exhausted
+   */
+  std::size_t acquire();
+  /** @brief the endpoint is exhausted until the end of the day (the limit of the key: 429, 403) */
+  void exhaust(std::size_t i);
+
+  std::size_t size() const;
+  const Endpoint &endpoint(std::size_t i) const;
+  /** @brief the requests of the endpoint today */
+  std::uint64_t used(std::size_t i) const;
+  bool exhausted(std::size_t i) const;
+  /** @brief write the usage file
+   *  @throw std::runtime_error - failed write (the writes of acquire and exhaust are logged)
+   */
+  void save() const;
+
+  /** @brief the balancer by key, common for the all workers of the geocoder (alive while used) */
+  static std::shared_ptr<Balancer> shared(const std::string &key, const Endpoints &endpoints, const boost::filesystem::path &usage);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
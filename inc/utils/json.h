@@ -0,0 +1,56 @@
+/** @file json.h
+ *  @brief the define of the single pass (SAX) json reader
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_JSON_H_
+#define GEOCODER_UTILS_JSON_H_
+
+// std
+#include <cstddef>
+#include <string>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace json
+{
+/** @class Handler
+ *  @brief the events of the reader, the strings are valid only inside the call
+ */
+class Handler
+{
+ public:
+  virtual ~Handler() = default;
+
+  virtual void startObject() {}
+  virtual void endObject() {}
+  virtual void startArray() {}
+  virtual void endArray() {}
+  virtual void key(const char *data, std::size_t size) {}
+  virtual void string(const char *data, std::size_t size) {}
+  /** @brief number, true, false, null as is */
+  virtual void literal(const char *data, std::size_t size) {}
+
+  /** @brief the rest of the document is not read (and is not validated) */
+  bool stopped() const { return stopped_; }
+
+ protected:
+  /** @brief the early stop: the handler has got enough */
+  void stop() { stopped_ = true; }
+
+ private:
+  bool stopped_{false};
+};
+
+/** @brief parse the json document (RFC 7159), the strings are unescaped to UTF-8
+ *  @throw std::runtime_error - syntax error
+ */
+void parse(const char *data, std::size_t size, Handler &handler);
+void parse(const std::string &text, Handler &handler);
+}  // namespace json
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
@@ -7,6 +7,7 @@
 #define GEOCODER_UTILS_LIBCURL_LIBCURL_H_
 
 // std
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -23,8 +24,35 @@ namespace curl
 {
 using Headers = std::set<std::string>;
 
+/** @brief global initialization libcurl (once per process)
+ * @return true - if success initialization
+ */
+bool globalInit();
+
+/** @struct LibCurlOptions
+ * @brief the options of the all handles of the LibCurl, applied once to the handle (not per request)
+ */
+struct LibCurlOptions
+{
+  /** @brief milliseconds, 0 - no timeout */
+  std::uint32_t timeout_ms{0};
+  std::uint32_t conntimeout_ms{0};
+  /** @brief abort the transfer slower than 'low_speed_limit' bytes per second during 'low_speed_time' seconds, 0 - disabled */
+  std::uint32_t low_speed_limit{0};
+  std::uint32_t low_speed_time{0};
+  bool verbose{false};
+  /** @brief Accept-Encoding ("gzip, deflate, br", empty - the all supported by libcurl), disabled if not set */
+  bool compression{false};
+  std::string accept_encoding;
+  /** @brief the handles kept in the pool, the requests in flight above it use the temporary handles */
+  std::size_t handles{16};
+};
+
 /** @class LibCurl
- * @brief The define wrapper libcurl library (curl), thread safe (internal lock)
+ * @brief The define wrapper libcurl library (curl), thread safe
+ * @details the request takes the ready handle of the pool without the lock (the home slot of the thread first),
+ * the handle keeps the options and the connections between the requests. The setters change the options
+ * of the handles taken by the next requests.
  * @url https://curl.haxx.se//
  */
 class LibCurl final
@@ -32,6 +60,7 @@ class LibCurl final
  public:
   /** @brief default ctor */
   LibCurl();
+  explicit LibCurl(const LibCurlOptions &options);
   /** @brief disable copy semantics */
   LibCurl(const LibCurl &) = delete;
   LibCurl &operator=(const LibCurl &) = delete;
@@ -45,17 +74,39 @@ class LibCurl final
    * @return tuple<std::string - answer, long - response code>
    */
   std::tuple<std::string, long> get(const std::string &url);
-  /** @brief http post request
+  /** @brief http get request into the buffer of the caller (reused between the requests)
+   * @param body - the answer: cleared, the capacity is kept and reserved by Content-Length
+   * @param timeout_ms - the timeout of the request (the rest of the deadline), milliseconds, 0 - 'timeout_ms' of the options
+   * @return response code
+   */
+  long get(const std::string &url, std::string &body, std::uint32_t timeout_ms = 0);
+  /** @brief http post request with the empty body
    * @param url - url
    * @return tuple<std::string - answer, long - response code>
    */
   std::tuple<std::string, long> post(const std::string &url);
+  /** @brief http head request, the connection is kept in the cache of the handle (warm-up)
+   * @return response code
+   */
+  long head(const std::string &url);
   /** @brief enable verbose */
   void verbose(bool enable = true);
   /** @brief set timeout (seconds) */
   void setTimeOut(std::uint32_t t);
   /** @brief set connection timeout (seconds) */
   void setConnTimeOut(std::uint32_t t);
+  /** @brief set timeout (milliseconds) */
+  void setTimeOutMs(std::uint32_t t);
+  /** @brief set connection timeout (milliseconds) */
+  void setConnTimeOutMs(std::uint32_t t);
+  /** @brief abort the transfer slower than 'limit' bytes per second during 'time' seconds, 0 - disabled */
+  void setLowSpeed(std::uint32_t limit, std::uint32_t time);
+  /** @brief set Accept-Encoding, the response is decoded automatically
+   * @param encoding - "gzip, deflate, br", empty - the all supported by libcurl
+   */
+  void setAcceptEncoding(const std::string &encoding);
+  /** @brief body size of the last transfer of the calling thread as received on the wire (before decoding) */
+  std::uint64_t lastWireSize() const;
   /** @brief set headers
    * @param encoding - encoding (UTF, CP1251)
    * @param headers - other headers
@@ -70,7 +121,12 @@ class LibCurl final
    * @param url - url
    * @return escape result
    */
-  std::string escapeUrl(const std::string &url);
+  static std::string escapeUrl(const std::string &url);
+  /** @brief escaping url as 'curl_easy_escape' (the unreserved characters are kept), the result is appended to 'out'
+   * @param url - url
+   * @param out - the buffer, is not allocated if the capacity is enough
+   */
+  static void escapeUrl(const std::string &url, std::string &out);
 
  private:
   class Impl;
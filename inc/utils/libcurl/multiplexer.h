@@ -0,0 +1,100 @@
+/** @file multiplexer.h
+ * @brief the define of the class Multiplexer (shared curl multi handle, HTTP/2 multiplexing)
+ * @author agent
+ * @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_LIBCURL_MULTIPLEXER_H_
+#define GEOCODER_UTILS_LIBCURL_MULTIPLEXER_H_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace curl
+{
+/** @struct MultiplexerOptions
+ * @brief the options of the all transfers of the multiplexer
+ */
+struct MultiplexerOptions
+{
+  enum class HttpVersion
+  {
+    http1_1,  ///< HTTP/1.1, keep-alive
+    http2,    ///< HTTP/2 negotiated by ALPN over TLS, HTTP/1.1 otherwise
+    http2_prior_knowledge  ///< HTTP/2 without upgrade (h2c)
+  };
+
+  HttpVersion version{HttpVersion::http2};
+  /** @brief maximum connections to the one host (HTTP/2 - streams are multiplexed over them) */
+  std::size_t max_connections{1};
+  /** @brief maximum concurrent streams per connection */
+  std::size_t max_streams{100};
+  /** @brief milliseconds, 0 - no timeout */
+  std::uint32_t timeout_ms{100000};
+  std::uint32_t conntimeout_ms{100000};
+  /** @brief abort the transfer slower than 'low_speed_limit' bytes per second during 'low_speed_time' seconds, 0 - disabled */
+  std::uint32_t low_speed_limit{0};
+  std::uint32_t low_speed_time{0};
+  bool verbose{false};
+  /** @brief Accept-Encoding ("gzip, deflate, br"), disabled if not set */
+  bool compression{false};
+  std::string accept_encoding;
+  /** @brief the file of CA certificates (empty - system default) */
+  std::string cainfo;
+
+  static HttpVersion textToVersion(const std::string &text);
+  static std::string versionToText(HttpVersion version);
+};
+
+/** @class Multiplexer
+ * @brief the curl multi handle driven by own thread, thread safe
+ * @details the workers submit requests and wait results, the all transfers share
+ * the connections of the multi handle (one TLS connection per provider for HTTP/2)
+ */
+class Multiplexer final
+{
+ public:
+  explicit Multiplexer(const MultiplexerOptions &options);
+  Multiplexer(const Multiplexer &) = delete;
+  Multiplexer &operator=(const Multiplexer &) = delete;
+  ~Multiplexer();
+  /** @brief http get request (blocking)
+   * @param url - url
+   * @return tuple<std::string - answer, long - response code>
+   */
+  std::tuple<std::string, long> get(const std::string &url);
+  /** @brief http get request (blocking)
+   * @param url - url
+   * @param wire - body size as received on the wire (before decoding)
+   * @return tuple<std::string - answer, long - response code>
+   */
+  std::tuple<std::string, long> get(const std::string &url, std::uint64_t &wire);
+  /** @brief http get request (blocking)
+   * @param timeout_ms - the timeout of the request (the rest of the deadline), milliseconds, 0 - 'timeout_ms' of the options
+   */
+  std::tuple<std::string, long> get(const std::string &url, std::uint64_t &wire, std::uint32_t timeout_ms);
+  /** @brief open up to 'count' connections in parallel by the http head requests (the warm-up: dns, tcp, tls)
+   * @throw std::runtime_error - the failed request
+   */
+  void warmup(const std::string &url, std::size_t count);
+  /** @brief count of the opened connections */
+  std::size_t connections() const;
+
+  /** @brief the multiplexer shared by key (for example, name of the geocoder) and the options */
+  static std::shared_ptr<Multiplexer> shared(const std::string &key, const MultiplexerOptions &options);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace curl
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,98 @@
+/** @file limiter.h
+ *  @brief the define of the class Limiter (the adaptive limit of the requests in flight of the geocoder, AIMD)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_LIMITER_H_
+#define GEOCODER_UTILS_LIMITER_H_
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// boost
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace geocoder
+{
+namespace utils
+{
+/** @struct LimiterOptions
+ *  @brief the options of the limiter (config section 'connection.limiter')
+ */
+struct LimiterOptions
+{
+  std::size_t initial{4};
+  std::size_t min{1};
+  std::size_t max{64};
+  /** @brief the multiplicative decrease of the limit on the overload */
+  double backoff{0.5};
+  /** @brief the latency above 'tolerance' * the baseline (the minimum latency) is the overload, 0 - the latency is ignored */
+  double tolerance{3.0};
+};
+
+/** @brief read the options of the config section 'limiter'
+ *  @throw std::runtime_error - min is zero, min > max, backoff is not in (0, 1)
+ */
+LimiterOptions readLimiterOptions(const boost::property_tree::ptree &limiter);
+
+/** @class Limiter
+ *  @brief the limit of the requests in flight, thread safe
+ *  @details the limit grows by one per the limit of the successful requests (additive increase) and is multiplied
+ *  by 'backoff' on the overload: 429, 503, the transport error, the latency above the tolerance (multiplicative decrease).
+ *  The overload decreases the limit once per the requests in flight: the requests started before the decrease are not counted.
+ */
+class Limiter final
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Outcome
+  {
+    success = 0,  ///< the answer, the latency is the signal
+    overload,     ///< 429, 503, the transport error
+    ignore        ///< the other errors, the limit is not changed
+  };
+
+  /** @struct Ticket
+   *  @brief the permit of the request
+   */
+  struct Ticket
+  {
+    Clock::time_point start;
+    std::uint64_t epoch{0};
+  };
+
+  /** @param metric - the name of the gauge of the limit, empty - none */
+  explicit Limiter(const LimiterOptions &options, const std::string &metric = std::string());
+  Limiter(const Limiter &) = delete;
+  Limiter &operator=(const Limiter &) = delete;
+  ~Limiter();
+
+  /** @brief wait until the requests in flight are below the limit */
+  Ticket acquire();
+  /** @brief wait until the requests in flight are below the limit, but not longer than 'deadline'
+   *  @return none - the deadline is reached, the request is not counted
+   */
+  boost::optional<Ticket> acquire(Clock::time_point deadline);
+  /** @brief the request is completed */
+  void release(const Ticket &ticket, Outcome outcome);
+
+  /** @brief the current limit */
+  std::size_t limit() const;
+  std::size_t inflight() const;
+
+  /** @brief the limiter by key, common for the all workers of the geocoder (alive while used) */
+  static std::shared_ptr<Limiter> shared(const std::string &key, const LimiterOptions &options, const std::string &metric);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
@@ -0,0 +1,212 @@
+/** @file binary.h
+ *  @brief the define of the binary logger (per-thread ring buffers, offline decoder)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_LOGGER_BINARY_H_
+#define GEOCODER_UTILS_LOGGER_BINARY_H_
+
+// std
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+// this
+#include "utils/logger/config.h"
+#include "utils/logger/types.h"
+
+namespace geocoder
+{
+namespace utils
+{
+namespace logger
+{
+namespace binary
+{
+/** @details file layout (native byte order):
+ *  "GEOBLOG1", then blocks: uint8 type, uint32 a, uint32 b, payload
+ *  type 'F' - format string: a - id, b - length, payload - text
+ *  type 'R' - records of the thread: a - thread index, b - length, payload - records
+ *  type 'D' - dropped records (ring buffer is full): a - thread index, b - count
+ *  record: uint64 nanoseconds since epoch, uint32 format id, uint16 size of arguments,
+ *  uint8 severity, uint8 count of arguments, arguments: uint8 ArgType, value
+ *  (string: uint16 length, bytes)
+ */
+enum class ArgType : std::uint8_t
+{
+  int64 = 1,
+  uint64,
+  float64,
+  string,
+  boolean,
+  character
+};
+
+struct RecordHeader
+{
+  std::uint64_t time;
+  std::uint32_t id;
+  std::uint16_t size;
+  std::uint8_t severity;
+  std::uint8_t count;
+};
+
+/** @brief the maximum size of the record, longer strings are truncated */
+constexpr std::size_t max_record_size = 512;
+
+using Buffer = std::array<char, max_record_size>;
+
+/** @brief start binary logger (the flush thread), restart if running */
+void start(const config::Configuration &conf);
+/** @brief stop binary logger, flush all records */
+void stop();
+/** @brief the binary logger is running */
+bool isRunning();
+/** @brief the severity is passed minimum severity of the binary logger */
+bool isEnabled(Severity sev);
+/** @brief register format string, placeholders '{}'
+ *  @return id of format
+ */
+std::uint32_t registerFormat(const char *format);
+/** @brief decode binary log to text
+ *  @param in - binary log
+ *  @param out - text
+ *  @return count of records
+ */
+std::size_t decode(std::istream &in, std::ostream &out);
+
+/** @class Encoder
+ *  @brief encoding record (header and raw arguments) on the stack
+ */
+class Encoder final
+{
+ public:
+  Encoder(std::uint32_t id, Severity sev);
+
+  template <typename T>
+  Encoder &operator<<(const T &value)
+  {
+    encode(value, std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>());
+    return *this;
+  }
+
+  Encoder &operator<<(const std::string &value) { return putString(value.data(), value.size()); }
+  Encoder &operator<<(const char *value) { return putString(value, std::strlen(value)); }
+  Encoder &operator<<(char value) { return put(ArgType::character, value); }
+  Encoder &operator<<(bool value) { return put(ArgType::boolean, static_cast<std::uint8_t>(value)); }
+  Encoder &operator<<(double value) { return put(ArgType::float64, value); }
+  Encoder &operator<<(float value) { return put(ArgType::float64, static_cast<double>(value)); }
+
+  /** @brief complete record and push to the ring buffer */
+  void commit();
+
+ private:
+  template <typename T>
+  void encode(const T &value, std::true_type)
+  {
+    if (std::is_signed<T>::value)
+    {
+      put(ArgType::int64, static_cast<std::int64_t>(value));
+    }
+    else
+    {
+      put(ArgType::uint64, static_cast<std::uint64_t>(value));
+    }
+  }
+
+  template <typename T>
+  void encode(const T &value, std::false_type)
+  {
+    std::ostringstream text;
+    text << value;
+    const auto str = text.str();
+    putString(str.data(), str.size());
+  }
+
+  template <typename T>
+  Encoder &put(ArgType type, const T &value)
+  {
+    if (size_ + 1 + sizeof(T) <= buffer_.size())
+    {
+      buffer_[size_++] = static_cast<char>(type);
+      std::memcpy(buffer_.data() + size_, &value, sizeof(T));
+      size_ += sizeof(T);
+      ++count_;
+    }
+    return *this;
+  }
+
+  Encoder &putString(const char *data, std::size_t size);
+
+ private:
+  Buffer buffer_;
+  std::size_t size_{sizeof(RecordHeader)};
+  std::uint8_t count_{0};
+};
+
+inline void encodeArgs(Encoder &) {}
+
+template <typename T, typename... Args>
+void encodeArgs(Encoder &enc, const T &value, const Args &... args)
+{
+  enc << value;
+  encodeArgs(enc, args...);
+}
+
+/** @brief format text: replace placeholders '{}' by arguments (binary logger is not running) */
+inline void formatArgs(std::ostream &out, const char *format) { out << format; }
+
+template <typename T, typename... Args>
+void formatArgs(std::ostream &out, const char *format, const T &value, const Args &... args)
+{
+  const char *p = std::strstr(format, "{}");
+  if (!p)
+  {
+    out << format;
+    return;
+  }
+
+  out.write(format, p - format);
+  out << value;
+  formatArgs(out, p + 2, args...);
+}
+
+template <typename... Args>
+std::string format(const char *format, const Args &... args)
+{
+  std::ostringstream out;
+  formatArgs(out, format, args...);
+  return out.str();
+}
+}  // namespace binary
+}  // namespace logger
+}  // namespace utils
+}  // namespace geocoder
+
+/** @brief logging through the binary logger if it is running, else as BOOST_LOG_SEV
+ *  @details the arguments are stored raw, formatting is done offline by decoder
+ */
+#define GEO_LOG_BIN(lg, sev, fmt, ...)                                                                     \
+  do                                                                                                       \
+  {                                                                                                        \
+    if (::geocoder::utils::logger::binary::isRunning())                                                    \
+    {                                                                                                      \
+      if (::geocoder::utils::logger::binary::isEnabled(sev))                                               \
+      {                                                                                                    \
+        static const auto geo_log_bin_id = ::geocoder::utils::logger::binary::registerFormat(fmt);         \
+        ::geocoder::utils::logger::binary::Encoder geo_log_bin_enc(geo_log_bin_id, sev);                  \
+        ::geocoder::utils::logger::binary::encodeArgs(geo_log_bin_enc, ##__VA_ARGS__);                     \
+        geo_log_bin_enc.commit();                                                                          \
+      }                                                                                                    \
+    }                                                                                                      \
+    else                                                                                                   \
+    {                                                                                                      \
+      BOOST_LOG_SEV(lg, sev) << ::geocoder::utils::logger::binary::format(fmt, ##__VA_ARGS__);             \
+    }                                                                                                      \
+  } while (false)
+
+#endif
@@ -14,6 +14,9 @@
 // boost
 #include <boost/filesystem.hpp>
 
+// this
+#include "utils/logger/types.h"
+
 namespace geocoder
 {
 namespace utils
@@ -42,6 +45,18 @@ struct Configuration
     std::uint64_t size{10};
   };
 
+  /** @brief binary logger (per-thread ring buffers, see logger/binary.h) */
+  struct Binary
+  {
+    bool enabled{false};
+    /** @brief prefix of the filename, <prefix>_<time>.blog in workdir */
+    std::string prefix{"geocoder"};
+    /** @brief size of the ring buffer per thread (bytes) */
+    std::size_t buffer{1 << 20};
+    /** @brief flush period (milliseconds) */
+    std::uint32_t flush{100};
+  };
+
   enum class Time
   {
     utc,
@@ -60,6 +75,9 @@ struct Configuration
   std::string filename = "geocoder_%Y-%m-%d_%H-%M-%S.%N.log";
   Rotation rotation;
   Time time_type{Time::utc};
+  /** @brief minimum severity, the records below are discarded before formatting the message */
+  Severity severity{Severity::trace};
+  Binary binary;
   Attributes attributes{{AttributesValues::process_id, true}, {AttributesValues::thread_id, true}, {AttributesValues::timestamp, true}};
 };
 
@@ -14,32 +14,23 @@
 // filesystem
 #include <boost/filesystem.hpp>
 
+// this
+#include "utils/logger/config.h"
+#include "utils/logger/types.h"
+
 namespace geocoder
 {
 namespace utils
 {
 namespace logger
 {
-/** @enum Severity
- *  @brief severity level logging
- */
-enum class Severity
-{
-  info = 0,
-  warning,
-  error,
-  crititcal,
-  fatal,
-  debug,
-  trace
-};
-
 using SeverityLogger = boost::log::sources::severity_logger_mt<Severity>;
 
 class Logger final
 {
  public:
   static void init();
+  static void init(const config::Configuration &conf);
   static void initFromFile(const boost::filesystem::path &filename);
   ~Logger();
 };
@@ -6,6 +6,10 @@
 #ifndef GEOCODER_COMMON_LOGGER_TYPES_H_
 #define GEOCODER_COMMON_LOGGER_TYPES_H_
 
+// std
+#include <stdexcept>
+#include <string>
+
 // boost
 #include <boost/property_tree/ptree_fwd.hpp>
 
@@ -16,6 +20,85 @@ namespace utils
 namespace logger
 {
 using Config = boost::property_tree::ptree;
+
+/** @enum Severity
+ *  @brief severity level logging
+ */
+enum class Severity
+{
+  info = 0,
+  warning,
+  error,
+  crititcal,
+  fatal,
+  debug,
+  trace
+};
+
+/** @brief the importance of the severity (trace - lowest, fatal - highest)
+ *  @details the values of Severity are not ordered by importance
+ */
+inline int severityRank(Severity sev)
+{
+  switch (sev)
+  {
+    case Severity::trace:
+      return 0;
+    case Severity::debug:
+      return 1;
+    case Severity::info:
+      return 2;
+    case Severity::warning:
+      return 3;
+    case Severity::error:
+      return 4;
+    case Severity::crititcal:
+      return 5;
+    case Severity::fatal:
+      return 6;
+    default:
+      throw std::runtime_error("[logger::severityRank]: unknown severity");
+  }
+}
+
+/** @brief the text of the severity in the log records (INFO, WARNING, ...), UNKNOWN - the value out of Severity */
+const std::string &severityToText(Severity sev);
+
+inline Severity textToSeverity(const std::string &text)
+{
+  if (text == "trace")
+  {
+    return Severity::trace;
+  }
+  else if (text == "debug")
+  {
+    return Severity::debug;
+  }
+  else if (text == "info")
+  {
+    return Severity::info;
+  }
+  else if (text == "warning")
+  {
+    return Severity::warning;
+  }
+  else if (text == "error")
+  {
+    return Severity::error;
+  }
+  else if (text == "critical")
+  {
+    return Severity::crititcal;
+  }
+  else if (text == "fatal")
+  {
+    return Severity::fatal;
+  }
+  else
+  {
+    throw std::runtime_error("[logger::textToSeverity]: unknown severity '" + text + "'");
+  }
+}
 }
 }  // namespace utils
 }  // namespace geocoder
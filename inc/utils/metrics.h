@@ -0,0 +1,56 @@
+/** @file metrics.h
+ *  @brief the define of the process wide named counters
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_METRICS_H_
+#define GEOCODER_UTILS_METRICS_H_
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace metrics
+{
+/** @class Counter
+ *  @brief monotonic counter (the gauge by 'set'), thread safe
+ */
+class Counter final
+{
+ public:
+  Counter() = default;
+  Counter(const Counter &) = delete;
+  Counter &operator=(const Counter &) = delete;
+
+  void add(std::uint64_t value = 1) { value_.fetch_add(value, std::memory_order_relaxed); }
+  std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+  void reset() { value_.store(0, std::memory_order_relaxed); }
+  /** @brief the gauge: the current value (the limit of the requests in flight) */
+  void set(std::uint64_t value) { value_.store(value, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+using Snapshot = std::map<std::string, std::uint64_t>;
+
+/** @brief the counter by name (created on first call, the reference is valid until end of the process) */
+Counter &counter(const std::string &name);
+/** @brief values of the all counters */
+Snapshot snapshot();
+/** @brief reset the all counters to zero */
+void reset();
+/** @brief print snapshot, one 'name value' per line */
+void print(std::ostream &out, const Snapshot &values);
+}  // namespace metrics
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
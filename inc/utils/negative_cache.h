@@ -0,0 +1,65 @@
+/** @file negative_cache.h
+ *  @brief the define of the class NegativeCache (the addresses not resolved by the all geocoders)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_NEGATIVE_CACHE_H_
+#define GEOCODER_UTILS_NEGATIVE_CACHE_H_
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// boost
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace geocoder
+{
+namespace utils
+{
+/** @struct NegativeCacheOptions
+ *  @brief the options of the cache (config section 'document.negative_cache')
+ */
+struct NegativeCacheOptions
+{
+  /** @brief the time of the life of the entry from the insert */
+  std::chrono::seconds ttl{3600};
+  /** @brief maximum count of the entries (the least recently used is evicted), 0 - the cache is disabled */
+  std::size_t size{0};
+};
+
+/** @brief read the options of the config section 'negative_cache' */
+NegativeCacheOptions readNegativeCacheOptions(const boost::property_tree::ptree &cache);
+
+/** @class NegativeCache
+ *  @brief the set of the keys with TTL and LRU eviction, thread safe
+ *  @details the metrics: negative_cache.hits, negative_cache.size (the gauge)
+ */
+class NegativeCache final
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit NegativeCache(const NegativeCacheOptions &options);
+  NegativeCache(const NegativeCache &) = delete;
+  NegativeCache &operator=(const NegativeCache &) = delete;
+  ~NegativeCache();
+
+  /** @brief the key is known and is not expired (the expired one is removed) */
+  bool contains(const std::string &key);
+  void insert(const std::string &key);
+  std::size_t size() const;
+
+  /** @brief the cache by key, common for the all workers (alive while used) */
+  static std::shared_ptr<NegativeCache> shared(const std::string &key, const NegativeCacheOptions &options);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
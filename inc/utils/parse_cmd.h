@@ -8,6 +8,7 @@
 
 // std
 #include <string>
+#include <vector>
 
 // boost
 #include <boost/filesystem.hpp>
@@ -16,17 +17,73 @@ namespace geocoder
 {
 namespace utils
 {
+/** @struct CmdOptions
+ * @brief the command line options
+ */
+struct CmdOptions
+{
+  /** @brief configuration filename (required) */
+  boost::filesystem::path config;
+  /** @brief address (optional) */
+  std::string address;
+  /** @brief file with address (optional) */
+  boost::filesystem::path addr_file;
+  /** @brief output file (optional) */
+  boost::filesystem::path output;
+  /** @brief directory for recording responses of the geocoders (optional) */
+  boost::filesystem::path record;
+  /** @brief directory with recorded responses, replay without network (optional) */
+  boost::filesystem::path replay;
+  /** @brief file with points 'latitude longitude', reverse geocoding by local index (optional) */
+  boost::filesystem::path reverse;
+  /** @brief the source of the local reverse and prefix index: output file or directory of the recorded responses */
+  boost::filesystem::path index;
+  /** @brief maximum distance (meters) of the reverse geocoding, 0 - unlimited */
+  double max_distance{0.0};
+  /** @brief file with partial addresses, autocomplete by local index (optional) */
+  boost::filesystem::path complete;
+  /** @brief count of the completions of the partial address */
+  std::size_t top{10};
+  /** @brief format of the output file: text, columnar, csv, jsonl */
+  std::string format{"text"};
+  /** @brief the daemon mode: the endpoint of the HTTP geocoding 'host:port' or 'unix:path' (optional) */
+  std::string serve;
+  /** @brief the filter mode: addresses from stdin, results to stdout as the batches complete */
+  bool stream{false};
+  /** @brief the journal of the progress of the address file, default '<output>.journal' (optional) */
+  boost::filesystem::path journal;
+  /** @brief skip the addresses completed by the journal */
+  bool resume{false};
+  /** @brief the slice of the address file 'index/count' (optional) */
+  std::string shard;
+  /** @brief the key of the slice: line, hash */
+  std::string shard_by{"line"};
+};
+
 /** @brief parse cmd
  * @param argc - number argv
  * @param argv - command line
- * @param [out] config_filename- configuration filename (required)
- * @param [out] address - address (optional)
- * @param [out] addr_filename - file with address
- * @param [out] outfile - output file (optional)
+ * @param [out] options - command line options
+ * @return true - if success parse command line, else = false
+ */
+bool parseCmd(int argc, char *argv[], CmdOptions &options);
+
+/** @struct MergeOptions
+ * @brief the options of the subcommand 'merge'
+ */
+struct MergeOptions
+{
+  /** @brief output file */
+  boost::filesystem::path output;
+  /** @brief the outputs of the shards */
+  std::vector<boost::filesystem::path> inputs;
+};
+
+/** @brief parse cmd of the subcommand 'merge' (without the name of the subcommand)
+ * @param [out] options - command line options
  * @return true - if success parse command line, else = false
  */
-bool parseCmd(int argc, char *argv[], boost::filesystem::path &config_filename, std::string &address, boost::filesystem::path &addr_filename,
-              boost::filesystem::path &outfile);
+bool parseMergeCmd(int argc, char *argv[], MergeOptions &options);
 }  // namespace utils
 }  // namespace geocoder
 
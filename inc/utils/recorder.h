@@ -0,0 +1,73 @@
+/** @file recorder.h
+ *  @brief the define of the class Recorder (record and replay responses of the geocoders)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_UTILS_RECORDER_H_
+#define GEOCODER_UTILS_RECORDER_H_
+
+// std
+#include <functional>
+#include <string>
+#include <tuple>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace geocoder
+{
+namespace utils
+{
+/** @class Recorder
+ *  @brief store raw responses (body and response code) keyed by request url
+ *  @details layout: <dir>/<xx>/<hash url>.resp, file: url '\n' code '\n' body
+ */
+class Recorder final
+{
+ public:
+  enum class Mode
+  {
+    none,
+    record,
+    replay
+  };
+
+  Recorder() = default;
+  Recorder(Mode mode, const boost::filesystem::path &dir);
+  /** @brief create from config section 'recorder' (mode, dir), absent section - Mode::none */
+  explicit Recorder(const boost::property_tree::ptree &conf);
+
+  Mode mode() const { return mode_; }
+  /** @brief save response
+   *  @param url - request url
+   *  @param body - response body
+   *  @param code - response code
+   */
+  void save(const std::string &url, const std::string &body, long code) const;
+  /** @brief load response
+   *  @param url - request url
+   *  @return tuple<std::string - answer, long - response code>
+   *  @throw std::runtime_error - is not recorded url
+   */
+  std::tuple<std::string, long> load(const std::string &url) const;
+
+  /** @brief visit the all recorded responses of the directory
+   *  @param fn - callback(url, body, code)
+   */
+  void forEach(const std::function<void(const std::string &, const std::string &, long)> &fn) const;
+
+  static std::string modeToText(Mode mode);
+  static Mode textToMode(const std::string &mode);
+
+ private:
+  boost::filesystem::path getFileName(const std::string &url) const;
+
+ private:
+  Mode mode_{Mode::none};
+  boost::filesystem::path dir_;
+};
+}  // namespace utils
+}  // namespace geocoder
+
+#endif
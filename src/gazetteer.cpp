@@ -0,0 +1,81 @@
+/** @file gazetteer.cpp
+ *  @brief the entry point of the builder of the gazetteer index (csv -> memory-mapped index for the local geocoder)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <iostream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/program_options.hpp>
+
+// this
+#include "GeocoderVersion.h"
+#include "geo/gazetteer.h"
+
+int main(int argc, char *argv[])
+{
+  namespace bp = boost::program_options;
+
+  std::vector<std::string> inputs;
+  std::string output;
+
+  bp::options_description option_desc("Allowed options");
+  option_desc.add_options()("help,h", "Display the program usage and exit")("version,v", "Display the program version and exit")(
+      "input,i", bp::value<std::vector<std::string>>(&inputs),
+      "Gazetteer csv 'country;region;district;place;suburb;street;house;latitude;longitude[;precision]' (required)")(
+      "output,o", bp::value<std::string>(&output)->required(), "Index file (required)");
+
+  bp::positional_options_description positional;
+  positional.add("input", -1);
+
+  try
+  {
+    bp::variables_map vm;
+    bp::store(bp::command_line_parser(argc, argv).options(option_desc).positional(positional).run(), vm);
+    if (vm.count("help"))
+    {
+      std::cerr << option_desc << std::endl;
+      return 0;
+    }
+    else if (vm.count("version"))
+    {
+      std::cout << geocoder::version::getText() << std::endl;
+      return 0;
+    }
+
+    bp::notify(vm);
+
+    if (inputs.empty())
+    {
+      std::cerr << option_desc << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    geocoder::geo::GazetteerBuilder builder;
+    std::size_t count = 0;
+    for (const auto &i : inputs)
+    {
+      for (const auto &loc : geocoder::geo::readGazetteerCsv(i))
+      {
+        builder.add(loc);
+        ++count;
+      }
+    }
+
+    builder.write(output);
+
+    const geocoder::geo::Gazetteer index(output);
+    std::cout << "locations " << count << ", keys " << index.size() << ", file '" << output << "'" << std::endl;
+  }
+  catch (const std::exception &err)
+  {
+    std::cerr << err.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
@@ -0,0 +1,737 @@
+/** @file batch.cpp
+ *  @brief the implementation of the batch geocoding pipeline
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// posix
+#include <poll.h>
+#include <unistd.h>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/geopool.h"
+#include "geo/journal.h"
+#include "geo/tabular.h"
+#include "utils/logger/logger.h"
+
+namespace geocoder
+{
+namespace geo
+{
+namespace
+{
+/** @brief the size of the read buffer of the stream */
+constexpr std::size_t kStreamBuffer = 1 << 20;
+
+/** @class LineReader
+ *  @brief the lines of the descriptor on the background thread, the queue of the lines is bounded
+ */
+class LineReader final
+{
+ public:
+  LineReader(int fd, std::size_t capacity)
+   : fd_(fd)
+   , capacity_(capacity)
+   , thread_([this] { run(); })
+  {
+  }
+  LineReader(const LineReader &) = delete;
+  LineReader &operator=(const LineReader &) = delete;
+  ~LineReader()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+  }
+
+  /** @brief wait for the lines, take at most 'max' of them
+   *  @return false - the end of the input
+   *  @throw std::runtime_error - failed read
+   */
+  bool take(Addresses &addrs, std::size_t max)
+  {
+    addrs.clear();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return !lines_.empty() || eof_; });
+    if (error_)
+    {
+      std::rethrow_exception(error_);
+    }
+
+    while (!lines_.empty() && addrs.size() < max)
+    {
+      addrs.push_back(std::move(lines_.front()));
+      lines_.pop_front();
+    }
+    lock.unlock();
+    cond_.notify_all();
+
+    return !addrs.empty();
+  }
+
+ private:
+  void run()
+  {
+    std::vector<char> buffer(kStreamBuffer);
+    std::size_t begin = 0;
+    std::size_t end = 0;
+
+    try
+    {
+      for (;;)
+      {
+        // the descriptor is polled to check the stop, the read does not block
+        pollfd pfd{fd_, POLLIN, 0};
+        const auto ready = ::poll(&pfd, 1, 100);
+        if (ready < 0 && errno != EINTR)
+        {
+          throw std::runtime_error(std::string("[LineReader::run]: failed poll '") + std::strerror(errno) + "'");
+        }
+        if (ready <= 0)
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (stop_)
+          {
+            return;
+          }
+          continue;
+        }
+
+        if (end == buffer.size())
+        {
+          // the line is longer than the buffer
+          buffer.resize(buffer.size() * 2);
+        }
+        const auto n = ::read(fd_, buffer.data() + end, buffer.size() - end);
+        if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+        if (n < 0)
+        {
+          throw std::runtime_error(std::string("[LineReader::run]: failed read '") + std::strerror(errno) + "'");
+        }
+        end += static_cast<std::size_t>(n);
+
+        Addresses lines;
+        for (auto pos = begin; pos < end;)
+        {
+          const auto nl = static_cast<const char *>(std::memchr(buffer.data() + pos, '\n', end - pos));
+          if (nl == nullptr)
+          {
+            break;
+          }
+          lines.push_back(line(buffer.data() + begin, nl));
+          begin = pos = static_cast<std::size_t>(nl - buffer.data()) + 1;
+        }
+
+        // the last line without the line feed
+        if (n == 0 && begin < end)
+        {
+          lines.push_back(line(buffer.data() + begin, buffer.data() + end));
+          begin = end;
+        }
+
+        if (!push(lines, n == 0))
+        {
+          return;
+        }
+        if (n == 0)
+        {
+          return;
+        }
+
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      eof_ = true;
+    }
+    cond_.notify_all();
+  }
+
+  static std::string line(const char *begin, const char *end)
+  {
+    if (end != begin && *(end - 1) == '\r')
+    {
+      --end;
+    }
+    return std::string(begin, end);
+  }
+
+  /** @brief wait for the room of the queue
+   *  @return false - stopped
+   */
+  bool push(Addresses &lines, bool eof)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return lines_.size() < capacity_ || stop_; });
+    if (stop_)
+    {
+      return false;
+    }
+    std::move(lines.begin(), lines.end(), std::back_inserter(lines_));
+    eof_ = eof;
+    lock.unlock();
+    cond_.notify_all();
+    return true;
+  }
+
+  const int fd_;
+  const std::size_t capacity_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<std::string> lines_;
+  bool eof_{false};
+  bool stop_{false};
+  std::exception_ptr error_;
+
+  std::thread thread_;
+};
+
+/** @class StreamWorkers
+ *  @brief the persistent workers of the stream: each takes the next address of the queue by own GeoPool,
+ *  the answers are written in the order of the input as soon as the preceding ones complete
+ */
+class StreamWorkers final
+{
+ public:
+  /** @brief format the answer with the index of the address (starting at 0) */
+  using Format = std::function<void(std::size_t, const Answer &, std::string &)>;
+  /** @brief write and flush the formatted answers */
+  using Write = std::function<void(const std::string &)>;
+
+  StreamWorkers(std::vector<std::unique_ptr<GeoPool>> &pools, std::size_t capacity, Format format, Write write)
+   : capacity_(capacity)
+   , format_(std::move(format))
+   , write_(std::move(write))
+  {
+    try
+    {
+      for (auto &i : pools)
+      {
+        auto &pool = *i;
+        threads_.emplace_back([this, &pool] { run(pool); });
+      }
+    }
+    catch (...)
+    {
+      stop();
+      throw;
+    }
+  }
+  StreamWorkers(const StreamWorkers &) = delete;
+  StreamWorkers &operator=(const StreamWorkers &) = delete;
+  ~StreamWorkers() { stop(); }
+
+  /** @brief queue the addresses, wait while the answers not written are more than the capacity
+   *  @throw std::runtime_error - failed write
+   */
+  void push(Addresses &addrs)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return next_ - written_ < capacity_ || error_; });
+    if (error_)
+    {
+      std::rethrow_exception(error_);
+    }
+
+    for (auto &i : addrs)
+    {
+      tasks_.emplace_back(next_++, std::move(i));
+    }
+    lock.unlock();
+    cond_.notify_all();
+  }
+
+  /** @brief wait for the all queued answers are written
+   *  @throw std::runtime_error - failed write
+   */
+  void finish()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return written_ == next_ || error_; });
+    if (error_)
+    {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  void run(GeoPool &pool)
+  {
+    for (;;)
+    {
+      std::pair<std::size_t, std::string> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return !tasks_.empty() || stop_; });
+        if (stop_)
+        {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+
+      Answer answer;
+      try
+      {
+        answer = pool.geocode(task.second);
+      }
+      catch (const std::exception &err)
+      {
+        BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::error) << "[geocodeStream] Failed geocode '" << task.second << "'";
+      }
+
+      std::string text;
+      format_(task.first, answer, text);
+      complete(task.first, std::move(text));
+    }
+  }
+
+  /** @brief store the answer, the worker which is not blocked by the other writer writes the completed prefix */
+  void complete(std::size_t id, std::string &&text)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.emplace(id, std::move(text));
+    if (writing_ || error_ || stop_)
+    {
+      return;
+    }
+
+    writing_ = true;
+    std::string chunk;
+    for (;;)
+    {
+      chunk.clear();
+      for (auto i = done_.begin(); i != done_.end() && i->first == collected_; i = done_.erase(i), ++collected_)
+      {
+        chunk += i->second;
+      }
+      if (collected_ == written_)
+      {
+        break;
+      }
+
+      lock.unlock();
+      std::exception_ptr error;
+      try
+      {
+        write_(chunk);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      written_ = collected_;
+      error_ = error;
+      cond_.notify_all();
+      if (error_)
+      {
+        break;
+      }
+    }
+    writing_ = false;
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto &i : threads_)
+    {
+      i.join();
+    }
+  }
+
+  const std::size_t capacity_;
+  const Format format_;
+  const Write write_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<std::pair<std::size_t, std::string>> tasks_;
+  /** @brief the answers completed out of the order */
+  std::map<std::size_t, std::string> done_;
+  std::size_t next_{0};
+  std::size_t collected_{0};
+  std::size_t written_{0};
+  bool writing_{false};
+  bool stop_{false};
+  std::exception_ptr error_;
+
+  std::vector<std::thread> threads_;
+};
+}  // namespace
+
+//--------------------------------------------------------------------------------------------
+Addresses readFromFile(const boost::filesystem::path &filename)
+{
+  std::ifstream fin{filename.string()};
+
+  std::string line;
+  Addresses result;
+
+  while (std::getline(fin, line))
+  {
+    result.emplace_back(line);
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+std::uint64_t hashAddress(const std::string &address)
+{
+  std::uint64_t result = 14695981039346656037ULL;
+  for (const auto c : address)
+  {
+    result ^= static_cast<unsigned char>(c);
+    result *= 1099511628211ULL;
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+Shard parseShard(const std::string &text, Shard::Key key)
+{
+  Shard result;
+  result.key = key;
+
+  char tail = 0;
+  unsigned long long index = 0;
+  unsigned long long count = 0;
+  if (std::sscanf(text.c_str(), "%llu/%llu%c", &index, &count, &tail) != 2 || count == 0 || index >= count)
+  {
+    throw std::runtime_error("[parseShard]: invalid shard '" + text + "', expected 'index/count', index < count");
+  }
+
+  result.index = static_cast<std::size_t>(index);
+  result.count = static_cast<std::size_t>(count);
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+Addresses selectShard(const Addresses &addrs, const Shard &shard, std::vector<std::size_t> &ids)
+{
+  Addresses result;
+  ids.clear();
+
+  for (std::size_t i = 0; i < addrs.size(); ++i)
+  {
+    const auto key = (shard.key == Shard::Key::hash) ? hashAddress(addrs[i]) : static_cast<std::uint64_t>(i);
+    if (key % shard.count == shard.index)
+    {
+      result.push_back(addrs[i]);
+      ids.push_back(i + 1);
+    }
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+Answers geocode(const Addresses &addrs, const boost::property_tree::ptree &conf)
+{
+  Answers result(addrs.size());
+  geocode(addrs, conf, result, std::vector<bool>(), nullptr);
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+void geocode(const Addresses &addrs, const boost::property_tree::ptree &conf, Answers &answers, const std::vector<bool> &done, Journal *journal)
+{
+  auto &logger = geo_logger::get();
+  using utils::logger::Severity;
+
+  BOOST_LOG_SEV(logger, Severity::info) << "[geocode]: Start geocoding.";
+
+  answers.resize(addrs.size());
+
+  // the workers above the limit of the requests in flight (connection.limiter) wait for the permit
+  const auto threads = std::max<std::size_t>(conf.get<std::size_t>("document.batch.threads", 2), 1);
+  const auto maxthreads = std::max<std::size_t>(std::min(threads, addrs.size()), 1);
+  const auto addr_per_thread = (addrs.size() + maxthreads - 1) / maxthreads;
+
+  std::vector<std::future<void>> futures;
+
+  for (std::size_t begin = 0; begin < addrs.size(); begin += addr_per_thread)
+  {
+    const auto end = std::min(addrs.size(), begin + addr_per_thread);
+
+    // the answer per address, the position of the answer is the line of the address
+    auto fut = std::async(std::launch::async, [&, begin, end] {
+      auto &logger = geo_logger::get();
+      GeoPool pool(conf);
+      for (auto i = begin; i < end; ++i)
+      {
+        if (i < done.size() && done[i])
+        {
+          continue;
+        }
+
+        auto status = GeoPool::Status::failed;
+        try
+        {
+          answers[i] = pool.geocode(addrs[i]);
+          status = pool.status();
+        }
+        catch (const std::exception &err)
+        {
+          BOOST_LOG_SEV(logger, Severity::error) << "[geocode] Failed geocode '" << addrs[i] << "'";
+          answers[i] = Answer();
+        }
+
+        // the transient failure is not completed: the address is geocoded again by the resume
+        if (journal != nullptr && status != GeoPool::Status::failed)
+        {
+          journal->append(i, addrs[i], answers[i]);
+        }
+      }
+    });
+
+    futures.push_back(std::move(fut));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  if (journal != nullptr)
+  {
+    journal->flush();
+  }
+}
+//--------------------------------------------------------------------------------------------
+void appendText(const Answer &answer, std::string &out)
+{
+  const auto field = [&out](const char *name, const std::string &value) {
+    out.append("--> ").append(name).append(" = '").append(value).append("'\n");
+  };
+
+  out.append("geocoder type = '").append(Answer::GeoTypeToText(answer.type)).append("'\n");
+
+  for (const auto &j : answer.locations)
+  {
+    out.append(j.line).append("\n");
+    field("country", j.country);
+    field("region", j.region);
+    field("district", j.district);
+    field("place", j.place);
+    field("suburb", j.suburb);
+    field("street", j.street);
+    field("house", j.house);
+    // the shortest round trip: the coordinates read back by readAnswers (the source of the reverse index) are exact
+    out.append("--> coord {");
+    appendDouble(j.coord.latitude, out);
+    out.append(", ");
+    appendDouble(j.coord.longitude, out);
+    out.append("}\n");
+    field("precision", PrecisionToString(j.precision));
+  }
+
+  out.append("----------------------------------------------------------\n");
+}
+//--------------------------------------------------------------------------------------------
+void print(const boost::filesystem::path &filename, const Answers &answers)
+{
+  std::ofstream fout(filename.string());
+
+  if (!fout.is_open())
+  {
+    throw std::runtime_error("[print]: failed open filename '" + filename.string() + "'");
+  }
+
+  std::string out;
+  for (const auto &i : answers)
+  {
+    out.clear();
+    appendText(i, out);
+    fout.write(out.c_str(), out.length());
+  }
+}
+//--------------------------------------------------------------------------------------------
+std::size_t geocodeStream(int in, std::FILE *out, const boost::property_tree::ptree &conf, const StreamOptions &options)
+{
+  auto &logger = geo_logger::get();
+  using utils::logger::Severity;
+
+  if (options.format != "text" && options.format != "csv" && options.format != "jsonl")
+  {
+    throw std::runtime_error("[geocodeStream]: unsupported format '" + options.format + "'");
+  }
+
+  const auto batch = std::max<std::size_t>(options.batch, 1);
+  const auto threads = std::max<std::size_t>(options.threads, 1);
+  const auto format = (options.format == "csv") ? TabularFormat::csv : TabularFormat::jsonl;
+
+  const auto write = [out](const std::string &data) {
+    if (!data.empty() && std::fwrite(data.data(), 1, data.size(), out) != data.size())
+    {
+      throw std::runtime_error("[geocodeStream]: failed write");
+    }
+  };
+
+  std::string header;
+  if (options.format == "csv")
+  {
+    appendHeader(format, header);
+    write(header);
+  }
+
+  std::vector<std::unique_ptr<GeoPool>> pools;
+  for (std::size_t i = 0; i < threads; ++i)
+  {
+    pools.emplace_back(new GeoPool(conf));
+  }
+
+  // the workers are started once for the stream, the answers are written as they complete in the order of the input:
+  // the slow address holds back only the answers after it, at most two batches are not written
+  const auto append = [&options, format](std::size_t id, const Answer &answer, std::string &text) {
+    if (options.format == "text")
+    {
+      appendText(answer, text);
+    }
+    else
+    {
+      appendRows(format, id + 1, answer, text);
+    }
+  };
+  const auto flush = [out, &write](const std::string &data) {
+    write(data);
+    if (std::fflush(out) != 0)
+    {
+      throw std::runtime_error("[geocodeStream]: failed write");
+    }
+  };
+  StreamWorkers workers(pools, batch, append, flush);
+
+  LineReader reader(in, batch * 4);
+
+  BOOST_LOG_SEV(logger, Severity::info) << "[geocodeStream]: Start, batch " << batch << ", threads " << threads;
+
+  Addresses addrs;
+  std::size_t count = 0;
+  while (reader.take(addrs, batch))
+  {
+    count += addrs.size();
+    workers.push(addrs);
+  }
+  workers.finish();
+  std::fflush(out);
+
+  BOOST_LOG_SEV(logger, Severity::info) << "[geocodeStream]: Complete, addresses " << count;
+  return count;
+}
+//--------------------------------------------------------------------------------------------
+Answers readAnswers(const boost::filesystem::path &filename)
+{
+  std::ifstream fin(filename.string());
+
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("[readAnswers]: failed open filename '" + filename.string() + "'");
+  }
+
+  // "--> name = 'value'"
+  const auto value = [&filename](const std::string &line, const std::string &name) {
+    const auto prefix = "--> " + name + " = '";
+    if (line.compare(0, prefix.size(), prefix) != 0 || line.size() < prefix.size() + 1 || line.back() != '\'')
+    {
+      throw std::runtime_error("[readAnswers]: invalid line '" + line + "' in '" + filename.string() + "'");
+    }
+    return line.substr(prefix.size(), line.size() - prefix.size() - 1);
+  };
+
+  const std::string type_prefix = "geocoder type = '";
+
+  Answers result;
+  std::string line;
+  while (std::getline(fin, line))
+  {
+    if (line.compare(0, type_prefix.size(), type_prefix) == 0)
+    {
+      Answer answer;
+      answer.type = Answer::TextToGeoType(line.substr(type_prefix.size(), line.size() - type_prefix.size() - 1));
+      result.push_back(std::move(answer));
+    }
+    else if (line.compare(0, 3, "---") == 0)
+    {
+      // the end of the answer
+      continue;
+    }
+    else if (result.empty())
+    {
+      throw std::runtime_error("[readAnswers]: is not found 'geocoder type' in '" + filename.string() + "'");
+    }
+    else
+    {
+      // the location: address line and 9 fields
+      Location loc;
+      loc.line = line;
+
+      std::string fields[9];
+      for (auto &i : fields)
+      {
+        if (!std::getline(fin, i))
+        {
+          throw std::runtime_error("[readAnswers]: unexpected end of file '" + filename.string() + "'");
+        }
+      }
+
+      loc.country = value(fields[0], "country");
+      loc.region = value(fields[1], "region");
+      loc.district = value(fields[2], "district");
+      loc.place = value(fields[3], "place");
+      loc.suburb = value(fields[4], "suburb");
+      loc.street = value(fields[5], "street");
+      loc.house = value(fields[6], "house");
+
+      // "--> coord {latitude, longitude}"
+      if (std::sscanf(fields[7].c_str(), "--> coord {%lf, %lf}", &loc.coord.latitude, &loc.coord.longitude) != 2)
+      {
+        throw std::runtime_error("[readAnswers]: invalid line '" + fields[7] + "' in '" + filename.string() + "'");
+      }
+
+      loc.precision = StringToPrecision(value(fields[8], "precision"));
+
+      result.back().locations.push_back(std::move(loc));
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
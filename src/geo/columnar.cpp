@@ -0,0 +1,443 @@
+/** @file columnar.cpp
+ *  @brief the implementation of the columnar binary output
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/columnar.h"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// boost
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+const char magic[8] = {'G', 'E', 'O', 'C', 'O', 'L', '0', '1'};
+const std::size_t field_count = 8;
+const char *const field_names[field_count] = {"line", "country", "region", "district", "place", "suburb", "street", "house"};
+
+enum class ColumnType : std::uint32_t
+{
+  int8 = 1,
+  uint8,
+  uint32,
+  float64,
+  dictionary  ///< u32 codes, u32 offsets of the entries (entries + 1), bytes
+};
+
+#pragma pack(push, 1)
+struct Header
+{
+  char magic[8];
+  std::uint32_t columns;
+  std::uint32_t reserved;
+  std::uint64_t answers;
+  std::uint64_t rows;
+};
+
+struct Column
+{
+  char name[16];
+  ColumnType type;
+  std::uint32_t reserved;
+  /** @brief the values (the codes of the dictionary) */
+  std::uint64_t offset;
+  std::uint64_t count;
+  /** @brief the dictionary: offsets of the entries, count of the entries, bytes */
+  std::uint64_t offsets;
+  std::uint64_t entries;
+  std::uint64_t bytes;
+};
+#pragma pack(pop)
+
+std::uint64_t align(std::uint64_t value) { return (value + 7) & ~static_cast<std::uint64_t>(7); }
+
+/** @brief the string fields of the location in the order of 'field_names' */
+template <class L, class S>
+void fields(L &loc, S *(&out)[field_count])
+{
+  S *result[field_count] = {&loc.line, &loc.country, &loc.region, &loc.district, &loc.place, &loc.suburb, &loc.street, &loc.house};
+  std::copy(std::begin(result), std::end(result), std::begin(out));
+}
+
+/** @brief the dictionary encoding of the string column */
+struct Dictionary
+{
+  std::unordered_map<std::string, std::uint32_t> index;
+  std::vector<std::uint32_t> codes;
+  std::vector<std::uint32_t> offsets{0};
+  std::string bytes;
+
+  void add(const std::string &value)
+  {
+    const auto it = index.emplace(value, static_cast<std::uint32_t>(offsets.size() - 1));
+    if (it.second)
+    {
+      // the offsets of the entries are u32
+      if (value.size() > std::numeric_limits<std::uint32_t>::max() - bytes.size())
+      {
+        throw std::runtime_error("[printColumnar]: the strings of the column exceed 4 GiB");
+      }
+      bytes += value;
+      offsets.push_back(static_cast<std::uint32_t>(bytes.size()));
+    }
+    codes.push_back(it.first->second);
+  }
+};
+
+/** @brief the part of the file */
+struct Blob
+{
+  const char *data;
+  std::uint64_t size;
+};
+}  // namespace
+//--------------------------------------------------------------------------------------------
+void printColumnar(const boost::filesystem::path &filename, const Answers &answers)
+{
+  std::vector<std::int8_t> types;
+  std::vector<std::uint32_t> first;
+  std::vector<double> latitude;
+  std::vector<double> longitude;
+  std::vector<std::uint8_t> precision;
+  Dictionary dictionaries[field_count];
+
+  types.reserve(answers.size());
+  first.reserve(answers.size() + 1);
+  first.push_back(0);
+  for (const auto &a : answers)
+  {
+    types.push_back(static_cast<std::int8_t>(a.type));
+    for (const auto &loc : a.locations)
+    {
+      latitude.push_back(loc.coord.latitude);
+      longitude.push_back(loc.coord.longitude);
+      precision.push_back(static_cast<std::uint8_t>(loc.precision));
+
+      const std::string *values[field_count];
+      fields(loc, values);
+      for (std::size_t i = 0; i < field_count; ++i)
+      {
+        dictionaries[i].add(*values[i]);
+      }
+    }
+    // the first rows of the answers are u32
+    if (latitude.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+      throw std::runtime_error("[printColumnar]: the count of the locations exceeds " + std::to_string(std::numeric_limits<std::uint32_t>::max()));
+    }
+    first.push_back(static_cast<std::uint32_t>(latitude.size()));
+  }
+
+  // the directory and the parts of the file in the order of the offsets
+  std::vector<Column> columns;
+  std::vector<Blob> blobs;
+  const auto column_count = 5 + field_count;
+  std::uint64_t position = sizeof(Header) + column_count * sizeof(Column);
+
+  const auto add = [&blobs, &position](const void *data, std::uint64_t size) {
+    position = align(position);
+    const auto result = position;
+    blobs.push_back(Blob{static_cast<const char *>(data), size});
+    position += size;
+    return result;
+  };
+
+  const auto addColumn = [&columns, &add](const char *name, ColumnType type, const void *data, std::uint64_t count, std::uint64_t width) {
+    Column c{};
+    std::strncpy(c.name, name, sizeof(c.name) - 1);
+    c.type = type;
+    c.offset = add(data, count * width);
+    c.count = count;
+    columns.push_back(c);
+  };
+
+  addColumn("type", ColumnType::int8, types.data(), types.size(), sizeof(std::int8_t));
+  addColumn("first", ColumnType::uint32, first.data(), first.size(), sizeof(std::uint32_t));
+  addColumn("latitude", ColumnType::float64, latitude.data(), latitude.size(), sizeof(double));
+  addColumn("longitude", ColumnType::float64, longitude.data(), longitude.size(), sizeof(double));
+  addColumn("precision", ColumnType::uint8, precision.data(), precision.size(), sizeof(std::uint8_t));
+  for (std::size_t i = 0; i < field_count; ++i)
+  {
+    const auto &d = dictionaries[i];
+    addColumn(field_names[i], ColumnType::dictionary, d.codes.data(), d.codes.size(), sizeof(std::uint32_t));
+    columns.back().offsets = add(d.offsets.data(), d.offsets.size() * sizeof(std::uint32_t));
+    columns.back().entries = d.offsets.size() - 1;
+    columns.back().bytes = add(d.bytes.data(), d.bytes.size());
+  }
+
+  Header header{};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.columns = static_cast<std::uint32_t>(columns.size());
+  header.answers = answers.size();
+  header.rows = latitude.size();
+
+  auto tmp = filename;
+  tmp += ".tmp";
+  {
+    std::ofstream fout(tmp.string(), std::ios::binary | std::ios::trunc);
+    if (!fout.is_open())
+    {
+      throw std::runtime_error("[printColumnar]: failed open file '" + tmp.string() + "'");
+    }
+
+    fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char *>(columns.data()), columns.size() * sizeof(Column));
+
+    std::uint64_t written = sizeof(Header) + columns.size() * sizeof(Column);
+    const char zeros[8] = {};
+    for (const auto &b : blobs)
+    {
+      fout.write(zeros, align(written) - written);
+      fout.write(b.data, b.size);
+      written = align(written) + b.size;
+    }
+
+    if (!fout)
+    {
+      throw std::runtime_error("[printColumnar]: failed write file '" + tmp.string() + "'");
+    }
+  }
+
+  boost::filesystem::rename(tmp, filename);
+}
+//--------------------------------------------------------------------------------------------
+bool isColumnarFile(const boost::filesystem::path &filename)
+{
+  std::ifstream fin(filename.string(), std::ios::binary);
+  char signature[sizeof(magic)] = {};
+  fin.read(signature, sizeof(signature));
+  return fin && !std::memcmp(signature, magic, sizeof(magic));
+}
+//--------------------------------------------------------------------------------------------
+class ColumnarReader::Impl final
+{
+ public:
+  explicit Impl(const boost::filesystem::path &filename)
+  {
+    if (!boost::filesystem::exists(filename))
+    {
+      throw std::runtime_error("[ColumnarReader]: is not found file '" + filename.string() + "'");
+    }
+
+    const auto invalid = [&filename] { return std::runtime_error("[ColumnarReader]: invalid file '" + filename.string() + "'"); };
+
+    file_.open(filename.string());
+    begin_ = file_.data();
+    const auto size = file_.size();
+
+    if (size < sizeof(Header))
+    {
+      throw invalid();
+    }
+    std::memcpy(&header_, begin_, sizeof(Header));
+    if (std::memcmp(header_.magic, magic, sizeof(magic)) || sizeof(Header) + header_.columns * sizeof(Column) > size)
+    {
+      throw invalid();
+    }
+
+    const auto inside = [size](std::uint64_t offset, std::uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+    const auto width = [](ColumnType type) -> std::uint64_t {
+      switch (type)
+      {
+        case ColumnType::int8:
+        case ColumnType::uint8:
+          return 1;
+        case ColumnType::uint32:
+        case ColumnType::dictionary:
+          return 4;
+        case ColumnType::float64:
+          return 8;
+        default:
+          return 0;
+      }
+    };
+
+    for (std::uint32_t i = 0; i < header_.columns; ++i)
+    {
+      Column c;
+      std::memcpy(&c, begin_ + sizeof(Header) + i * sizeof(Column), sizeof(Column));
+      c.name[sizeof(c.name) - 1] = 0;
+
+      const auto w = width(c.type);
+      if (w == 0 || c.offset % w || c.count > size / w || !inside(c.offset, c.count * w))
+      {
+        throw invalid();
+      }
+      if (c.type == ColumnType::dictionary)
+      {
+        // the reads of the strings are not checked: the codes are the entries, the entries are inside the bytes
+        if (c.offsets % 4 || c.entries >= size / sizeof(std::uint32_t) || !inside(c.offsets, (c.entries + 1) * sizeof(std::uint32_t)))
+        {
+          throw invalid();
+        }
+        const auto *offsets = reinterpret_cast<const std::uint32_t *>(begin_ + c.offsets);
+        if (!inside(c.bytes, offsets[c.entries]) || !std::is_sorted(offsets, offsets + c.entries + 1))
+        {
+          throw invalid();
+        }
+        const auto *codes = reinterpret_cast<const std::uint32_t *>(begin_ + c.offset);
+        if (std::any_of(codes, codes + c.count, [&c](std::uint32_t code) { return code >= c.entries; }))
+        {
+          throw invalid();
+        }
+      }
+      columns_.emplace(c.name, c);
+    }
+
+    // the required columns
+    type_ = span<std::int8_t>("type", ColumnType::int8);
+    first_ = span<std::uint32_t>("first", ColumnType::uint32);
+    latitude_ = span<double>("latitude", ColumnType::float64);
+    longitude_ = span<double>("longitude", ColumnType::float64);
+    precision_ = span<std::uint8_t>("precision", ColumnType::uint8);
+    for (std::size_t i = 0; i < field_count; ++i)
+    {
+      strings_[i] = strings(field_names[i]);
+    }
+
+    if (type_.size != header_.answers || first_.size != header_.answers + 1 || latitude_.size != header_.rows ||
+        longitude_.size != header_.rows || precision_.size != header_.rows || first_[0] != 0 || first_[header_.answers] != header_.rows ||
+        !std::is_sorted(first_.data, first_.data + first_.size))
+    {
+      throw invalid();
+    }
+  }
+
+  std::size_t answers() const { return header_.answers; }
+  std::size_t rows() const { return header_.rows; }
+
+  const ColumnSpan<std::int8_t> &type() const { return type_; }
+  const ColumnSpan<std::uint32_t> &first() const { return first_; }
+  const ColumnSpan<double> &latitude() const { return latitude_; }
+  const ColumnSpan<double> &longitude() const { return longitude_; }
+  const ColumnSpan<std::uint8_t> &precision() const { return precision_; }
+
+  StringColumn strings(const std::string &name) const
+  {
+    const auto &c = column(name, ColumnType::dictionary);
+    if (c.count != header_.rows)
+    {
+      throw std::runtime_error("[ColumnarReader]: invalid column '" + name + "'");
+    }
+    return StringColumn(reinterpret_cast<const std::uint32_t *>(begin_ + c.offset), c.count,
+                        reinterpret_cast<const std::uint32_t *>(begin_ + c.offsets), c.entries, begin_ + c.bytes);
+  }
+
+  Answer answer(std::size_t i) const
+  {
+    if (i >= header_.answers)
+    {
+      throw std::out_of_range("[ColumnarReader::answer]: invalid answer " + std::to_string(i));
+    }
+
+    Answer result;
+    result.type = static_cast<Answer::GeocoderType>(type_[i]);
+    for (auto row = first_[i]; row < first_[i + 1]; ++row)
+    {
+      Location loc;
+      loc.coord = Coordinates(latitude_[row], longitude_[row]);
+      loc.precision = static_cast<Precision>(precision_[row]);
+
+      std::string *values[field_count];
+      fields(loc, values);
+      for (std::size_t f = 0; f < field_count; ++f)
+      {
+        const auto value = strings_[f][row];
+        values[f]->assign(value.data(), value.size());
+      }
+      result.locations.push_back(std::move(loc));
+    }
+    return result;
+  }
+
+ private:
+  const Column &column(const std::string &name, ColumnType type) const
+  {
+    const auto it = columns_.find(name);
+    if (it == columns_.end() || it->second.type != type)
+    {
+      throw std::runtime_error("[ColumnarReader]: is not found column '" + name + "'");
+    }
+    return it->second;
+  }
+
+  template <class T>
+  ColumnSpan<T> span(const std::string &name, ColumnType type) const
+  {
+    const auto &c = column(name, type);
+    ColumnSpan<T> result;
+    result.data = reinterpret_cast<const T *>(begin_ + c.offset);
+    result.size = c.count;
+    return result;
+  }
+
+ private:
+  boost::iostreams::mapped_file_source file_;
+  const char *begin_{nullptr};
+  Header header_{};
+  std::unordered_map<std::string, Column> columns_;
+
+  ColumnSpan<std::int8_t> type_;
+  ColumnSpan<std::uint32_t> first_;
+  ColumnSpan<double> latitude_;
+  ColumnSpan<double> longitude_;
+  ColumnSpan<std::uint8_t> precision_;
+  StringColumn strings_[field_count];
+};
+//--------------------------------------------------------------------------------------------
+ColumnarReader::ColumnarReader(const boost::filesystem::path &filename)
+ : impl_(new Impl(filename))
+{
+}
+//--------------------------------------------------------------------------------------------
+ColumnarReader::ColumnarReader(ColumnarReader &&) = default;
+ColumnarReader &ColumnarReader::operator=(ColumnarReader &&) = default;
+ColumnarReader::~ColumnarReader() = default;
+//--------------------------------------------------------------------------------------------
+std::size_t ColumnarReader::answers() const { return impl_->answers(); }
+//--------------------------------------------------------------------------------------------
+std::size_t ColumnarReader::rows() const { return impl_->rows(); }
+//--------------------------------------------------------------------------------------------
+ColumnSpan<std::int8_t> ColumnarReader::type() const { return impl_->type(); }
+//--------------------------------------------------------------------------------------------
+ColumnSpan<std::uint32_t> ColumnarReader::first() const { return impl_->first(); }
+//--------------------------------------------------------------------------------------------
+ColumnSpan<double> ColumnarReader::latitude() const { return impl_->latitude(); }
+//--------------------------------------------------------------------------------------------
+ColumnSpan<double> ColumnarReader::longitude() const { return impl_->longitude(); }
+//--------------------------------------------------------------------------------------------
+ColumnSpan<std::uint8_t> ColumnarReader::precision() const { return impl_->precision(); }
+//--------------------------------------------------------------------------------------------
+StringColumn ColumnarReader::strings(const std::string &name) const { return impl_->strings(name); }
+//--------------------------------------------------------------------------------------------
+Answer ColumnarReader::answer(std::size_t i) const { return impl_->answer(i); }
+//--------------------------------------------------------------------------------------------
+Answers ColumnarReader::read() const
+{
+  Answers result;
+  result.reserve(answers());
+  for (std::size_t i = 0; i < answers(); ++i)
+  {
+    result.push_back(answer(i));
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -0,0 +1,568 @@
+/** @file fuzzy.cpp
+ *  @brief the implementation of the class FuzzyIndex
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/fuzzy.h"
+
+// std
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+// this
+#include "geo/normalize.h"
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+using Text = std::vector<char32_t>;
+
+/** @brief UTF-8 -> code points, the invalid bytes are kept as is */
+void decode(const char *data, std::size_t size, Text &out)
+{
+  out.clear();
+  for (std::size_t i = 0; i < size;)
+  {
+    const auto c = static_cast<unsigned char>(data[i]);
+    std::size_t len = 1;
+    char32_t cp = c;
+    if (c >= 0xF0)
+    {
+      len = 4;
+      cp = c & 0x07;
+    }
+    else if (c >= 0xE0)
+    {
+      len = 3;
+      cp = c & 0x0F;
+    }
+    else if (c >= 0xC0)
+    {
+      len = 2;
+      cp = c & 0x1F;
+    }
+
+    if (len > 1 && i + len <= size)
+    {
+      for (std::size_t j = 1; j < len; ++j)
+      {
+        cp = (cp << 6) | (static_cast<unsigned char>(data[i + j]) & 0x3F);
+      }
+    }
+    else
+    {
+      len = 1;
+      cp = c;
+    }
+
+    out.push_back(cp);
+    i += len;
+  }
+}
+
+/** @brief the positions of the code points of the pattern (the bit masks of the bit-parallel algorithm) */
+class PatternMask final
+{
+ public:
+  explicit PatternMask(const Text &pattern)
+  {
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+    {
+      const auto bit = std::uint64_t(1) << i;
+      const auto index = slot(pattern[i]);
+      if (index < table_.size())
+      {
+        table_[index] |= bit;
+      }
+      else
+      {
+        auto it = std::find_if(other_.begin(), other_.end(), [&pattern, i](const Other &o) { return o.first == pattern[i]; });
+        if (it == other_.end())
+        {
+          other_.emplace_back(pattern[i], bit);
+        }
+        else
+        {
+          it->second |= bit;
+        }
+      }
+    }
+  }
+
+  std::uint64_t get(char32_t c) const
+  {
+    const auto index = slot(c);
+    if (index < table_.size())
+    {
+      return table_[index];
+    }
+
+    for (const auto &i : other_)
+    {
+      if (i.first == c)
+      {
+        return i.second;
+      }
+    }
+    return 0;
+  }
+
+ private:
+  using Other = std::pair<char32_t, std::uint64_t>;
+
+  /** @brief ASCII and cyrillic (U+0430..U+045F) are looked up by the table */
+  static std::size_t slot(char32_t c)
+  {
+    if (c < 0x80)
+    {
+      return c;
+    }
+    if (c >= 0x430 && c < 0x460)
+    {
+      return 0x80 + (c - 0x430);
+    }
+    return std::size_t(-1);
+  }
+
+  std::array<std::uint64_t, 0x80 + 0x30> table_{};
+  std::vector<Other> other_;
+};
+
+/** @brief Myers/Hyyro bit-parallel levenshtein distance, the pattern up to 64 code points
+ *  @details one column of the matrix per step, the step is a few word operations
+ */
+std::size_t distanceBits(const Text &pattern, const Text &text, std::size_t max)
+{
+  const PatternMask peq(pattern);
+  const auto m = pattern.size();
+  const auto n = text.size();
+  const std::uint64_t high = std::uint64_t(1) << (m - 1);
+
+  std::uint64_t pv = (m == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << m) - 1);
+  std::uint64_t mv = 0;
+  std::size_t score = m;
+
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    const auto eq = peq.get(text[j]);
+    const auto xv = eq | mv;
+    const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+    auto ph = mv | ~(xh | pv);
+    auto mh = pv & xh;
+
+    if (ph & high)
+    {
+      ++score;
+    }
+    else if (mh & high)
+    {
+      --score;
+    }
+
+    // the distance decreases not more than by one on the each rest column
+    if (score > max + (n - j - 1))
+    {
+      return max + 1;
+    }
+
+    ph = (ph << 1) | 1;
+    mh <<= 1;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+  }
+
+  return std::min(score, max + 1);
+}
+
+/** @brief the dynamic programming in the band of the width 2 * max + 1 */
+std::size_t distanceBand(const Text &lhs, const Text &rhs, std::size_t max)
+{
+  const auto m = lhs.size();
+  const auto n = rhs.size();
+  const auto limit = max + 1;
+
+  std::vector<std::size_t> prev(n + 1, limit);
+  std::vector<std::size_t> cur(n + 1, limit);
+  for (std::size_t j = 0; j <= std::min(n, max); ++j)
+  {
+    prev[j] = j;
+  }
+
+  for (std::size_t i = 1; i <= m; ++i)
+  {
+    const auto lo = (i > max) ? i - max : 1;
+    const auto hi = std::min(n, i + max);
+
+    cur[lo - 1] = (lo == 1) ? std::min(i, limit) : limit;
+    auto row_min = cur[lo - 1];
+    for (std::size_t j = lo; j <= hi; ++j)
+    {
+      const auto replace = prev[j - 1] + ((lhs[i - 1] == rhs[j - 1]) ? 0 : 1);
+      cur[j] = std::min(std::min(prev[j] + 1, cur[j - 1] + 1), std::min(replace, limit));
+      row_min = std::min(row_min, cur[j]);
+    }
+    if (hi < n)
+    {
+      cur[hi + 1] = limit;
+    }
+
+    if (row_min > max)
+    {
+      return limit;
+    }
+    std::swap(prev, cur);
+  }
+
+  return std::min(prev[n], limit);
+}
+
+std::size_t distance(const Text &lhs, const Text &rhs, std::size_t max)
+{
+  const auto diff = (lhs.size() > rhs.size()) ? lhs.size() - rhs.size() : rhs.size() - lhs.size();
+  if (diff > max)
+  {
+    return max + 1;
+  }
+  if (lhs.empty() || rhs.empty())
+  {
+    return std::max(lhs.size(), rhs.size());
+  }
+
+  // the shorter is the pattern
+  const auto &pattern = (lhs.size() <= rhs.size()) ? lhs : rhs;
+  const auto &text = (lhs.size() <= rhs.size()) ? rhs : lhs;
+  if (pattern.size() <= 64)
+  {
+    return distanceBits(pattern, text, max);
+  }
+  return distanceBand(pattern, text, max);
+}
+
+/** @brief the digits of the text in the order */
+void digits(const Text &text, Text &out)
+{
+  out.clear();
+  std::copy_if(text.begin(), text.end(), std::back_inserter(out), [](char32_t c) { return c >= '0' && c <= '9'; });
+}
+
+/** @brief the trigrams (the three code points of 21 bits) of the text padded by the spaces, unique and sorted */
+void trigrams(const Text &text, std::vector<std::uint64_t> &out)
+{
+  out.clear();
+  if (text.empty())
+  {
+    return;
+  }
+
+  const auto at = [&text](std::size_t i) -> std::uint64_t { return (i == 0 || i > text.size()) ? ' ' : text[i - 1]; };
+  for (std::size_t i = 0; i < text.size(); ++i)
+  {
+    out.push_back((at(i) << 42) | (at(i + 1) << 21) | at(i + 2));
+  }
+
+  std::sort(out.begin(), out.end());
+  out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+std::size_t editDistance(const std::string &lhs, const std::string &rhs, std::size_t max)
+{
+  Text l;
+  Text r;
+  decode(lhs.data(), lhs.size(), l);
+  decode(rhs.data(), rhs.size(), r);
+  return distance(l, r, max);
+}
+//--------------------------------------------------------------------------------------------
+FuzzyIndex::~FuzzyIndex() = default;
+FuzzyIndex::FuzzyIndex(FuzzyIndex &&) = default;
+FuzzyIndex &FuzzyIndex::operator=(FuzzyIndex &&) = default;
+//--------------------------------------------------------------------------------------------
+class FuzzyIndex::Impl final
+{
+ public:
+  explicit Impl(const Gazetteer &gazetteer)
+  {
+    key_offsets_.push_back(0);
+    id_offsets_.push_back(0);
+
+    // the keys are visited in the sorted order, the equal keys are adjacent
+    gazetteer.forEachPrefix("", [this](const std::string &key, std::uint32_t id) {
+      const auto count = key_offsets_.size() - 1;
+      if (count == 0 || key.compare(0, std::string::npos, text_, key_offsets_[count - 1], key_offsets_[count] - key_offsets_[count - 1]) != 0)
+      {
+        text_ += key;
+        key_offsets_.push_back(text_.size());
+        id_offsets_.push_back(id_offsets_.back());
+      }
+      ids_.push_back(id);
+      ++id_offsets_.back();
+      return true;
+    });
+
+    build();
+  }
+
+  std::size_t size() const { return key_offsets_.size() - 1; }
+
+  Matches match(const std::string &address, const FuzzyOptions &options) const
+  {
+    Matches result;
+
+    const auto query = normalize(address);
+    Text text;
+    decode(query.data(), query.size(), text);
+    if (text.empty())
+    {
+      return result;
+    }
+
+    std::vector<std::uint64_t> grams;
+    trigrams(text, grams);
+
+    // the postings of the trigrams of the query, the shortest first
+    using Range = std::pair<const std::uint32_t *, const std::uint32_t *>;
+    std::vector<Range> lists;
+    for (const auto g : grams)
+    {
+      const auto it = dictionary_.find(g);
+      if (it == dictionary_.end())
+      {
+        lists.emplace_back(nullptr, nullptr);
+      }
+      else
+      {
+        lists.emplace_back(postings_.data() + posting_offsets_[it->second], postings_.data() + posting_offsets_[it->second + 1]);
+      }
+    }
+    std::sort(lists.begin(), lists.end(), [](const Range &lhs, const Range &rhs) { return lhs.second - lhs.first < rhs.second - rhs.first; });
+
+    // the count filter: the edit breaks not more than 3 trigrams, so the match has at least 'grams - 3 * max_distance'
+    // common trigrams and is found in the one of the '3 * max_distance + 1' shortest postings (the longest are only probed)
+    const auto broken = 3 * options.max_distance;
+    const std::size_t min_common = (grams.size() > broken) ? grams.size() - broken : 0;
+    const auto scanned = (min_common > 0) ? broken + 1 : lists.size();
+
+    // the count of the common trigrams of the each key, the scratch is reused by the thread
+    thread_local std::vector<std::uint16_t> counts;
+    thread_local std::vector<std::uint32_t> touched;
+    if (counts.size() < size())
+    {
+      counts.resize(size(), 0);
+    }
+    touched.clear();
+
+    for (std::size_t i = 0; i < scanned; ++i)
+    {
+      for (auto p = lists[i].first; p != lists[i].second; ++p)
+      {
+        if (counts[*p]++ == 0)
+        {
+          touched.push_back(*p);
+        }
+      }
+    }
+
+    for (std::size_t i = scanned; i < lists.size(); ++i)
+    {
+      // drop the keys which can not reach 'min_common' by the rest postings
+      const auto rest = lists.size() - i;
+      touched.erase(std::remove_if(touched.begin(), touched.end(),
+                                   [rest, min_common](std::uint32_t key) {
+                                     if (counts[key] + rest < min_common)
+                                     {
+                                       counts[key] = 0;
+                                       return true;
+                                     }
+                                     return false;
+                                   }),
+                    touched.end());
+      if (touched.empty())
+      {
+        break;
+      }
+
+      // the sequential scan of the short postings, the binary search of the keys in the long ones
+      const auto length = static_cast<std::size_t>(lists[i].second - lists[i].first);
+      if (length < 8 * touched.size())
+      {
+        for (auto p = lists[i].first; p != lists[i].second; ++p)
+        {
+          if (counts[*p] != 0)
+          {
+            ++counts[*p];
+          }
+        }
+      }
+      else
+      {
+        for (const auto key : touched)
+        {
+          if (std::binary_search(lists[i].first, lists[i].second, key))
+          {
+            ++counts[key];
+          }
+        }
+      }
+    }
+
+    // rank by the Dice coefficient, the keys out of the length bound can not match
+    using Candidate = std::pair<double, std::uint32_t>;
+    std::vector<Candidate> candidates;
+    for (const auto key : touched)
+    {
+      const auto common = counts[key];
+      counts[key] = 0;
+
+      const auto diff = (lengths_[key] > text.size()) ? lengths_[key] - text.size() : text.size() - lengths_[key];
+      if (common >= min_common && diff <= options.max_distance)
+      {
+        candidates.emplace_back(2.0 * common / (grams.size() + grams_[key]), key);
+      }
+    }
+
+    const auto greater = [](const Candidate &lhs, const Candidate &rhs) { return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second); };
+    if (candidates.size() > options.candidates)
+    {
+      std::partial_sort(candidates.begin(), candidates.begin() + options.candidates, candidates.end(), greater);
+      candidates.resize(options.candidates);
+    }
+
+    Text numbers;
+    digits(text, numbers);
+
+    Text other;
+    Text other_numbers;
+    for (const auto &c : candidates)
+    {
+      const auto begin = key_offsets_[c.second];
+      const auto size = key_offsets_[c.second + 1] - begin;
+      decode(text_.data() + begin, size, other);
+
+      if (options.exact_numbers)
+      {
+        digits(other, other_numbers);
+        if (other_numbers != numbers)
+        {
+          continue;
+        }
+      }
+
+      const auto d = distance(text, other, options.max_distance);
+      if (d > options.max_distance)
+      {
+        continue;
+      }
+
+      const double score = 1.0 - static_cast<double>(d) / std::max(text.size(), other.size());
+      if (score < options.threshold)
+      {
+        continue;
+      }
+
+      Match m;
+      m.key.assign(text_, begin, size);
+      m.ids.assign(ids_.begin() + id_offsets_[c.second], ids_.begin() + id_offsets_[c.second + 1]);
+      m.distance = d;
+      m.score = score;
+      result.push_back(std::move(m));
+    }
+
+    std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) {
+      return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.key < rhs.key);
+    });
+
+    return result;
+  }
+
+ private:
+  /** @brief the postings of the trigrams (compressed sparse rows: the trigram -> the keys) */
+  void build()
+  {
+    const auto count = size();
+    lengths_.resize(count);
+    grams_.resize(count);
+
+    // the trigrams of the keys by the dense numbers of the dictionary
+    std::vector<std::uint32_t> numbers;
+    std::vector<std::uint64_t> key_numbers(count + 1, 0);
+    std::vector<std::uint32_t> frequency;
+
+    Text text;
+    std::vector<std::uint64_t> grams;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      decode(text_.data() + key_offsets_[k], key_offsets_[k + 1] - key_offsets_[k], text);
+      trigrams(text, grams);
+
+      lengths_[k] = static_cast<std::uint16_t>(std::min<std::size_t>(text.size(), 0xFFFF));
+      grams_[k] = static_cast<std::uint16_t>(std::min<std::size_t>(grams.size(), 0xFFFF));
+
+      for (const auto g : grams)
+      {
+        const auto it = dictionary_.emplace(g, static_cast<std::uint32_t>(frequency.size())).first;
+        if (it->second == frequency.size())
+        {
+          frequency.push_back(0);
+        }
+        ++frequency[it->second];
+        numbers.push_back(it->second);
+      }
+      key_numbers[k + 1] = numbers.size();
+    }
+
+    posting_offsets_.assign(frequency.size() + 1, 0);
+    for (std::size_t i = 0; i < frequency.size(); ++i)
+    {
+      posting_offsets_[i + 1] = posting_offsets_[i] + frequency[i];
+    }
+
+    // the keys are added in the increasing order, so the postings are sorted
+    postings_.resize(numbers.size());
+    auto fill = posting_offsets_;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      for (auto i = key_numbers[k]; i < key_numbers[k + 1]; ++i)
+      {
+        postings_[fill[numbers[i]]++] = static_cast<std::uint32_t>(k);
+      }
+    }
+  }
+
+ private:
+  // the unique keys: text, offsets of the keys in the text, the records of the keys
+  std::string text_;
+  std::vector<std::uint64_t> key_offsets_;
+  std::vector<std::uint32_t> ids_;
+  std::vector<std::uint64_t> id_offsets_;
+  // length of the keys (code points) and count of the trigrams of the keys
+  std::vector<std::uint16_t> lengths_;
+  std::vector<std::uint16_t> grams_;
+  // trigram -> number, postings of the numbers
+  std::unordered_map<std::uint64_t, std::uint32_t> dictionary_;
+  std::vector<std::uint64_t> posting_offsets_;
+  std::vector<std::uint32_t> postings_;
+};
+//--------------------------------------------------------------------------------------------
+FuzzyIndex::FuzzyIndex(const Gazetteer &gazetteer)
+ : impl_(new Impl(gazetteer))
+{
+}
+//--------------------------------------------------------------------------------------------
+std::size_t FuzzyIndex::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+FuzzyIndex::Matches FuzzyIndex::match(const std::string &address, const FuzzyOptions &options) const
+{
+  return impl_->match(address, options);
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
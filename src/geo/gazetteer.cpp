@@ -0,0 +1,522 @@
+/** @file gazetteer.cpp
+ *  @brief the implementation of the offline gazetteer index
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/gazetteer.h"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+// boost
+#include <boost/algorithm/string.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+// this
+#include "geo/normalize.h"
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+const char magic[8] = {'G', 'E', 'O', 'G', 'A', 'Z', '0', '1'};
+const std::uint32_t block_size = 16;
+const std::size_t field_count = 8;
+
+#pragma pack(push, 1)
+struct Header
+{
+  char magic[8];
+  std::uint32_t block_size;
+  std::uint32_t reserved;
+  std::uint64_t keys;
+  std::uint64_t blocks;
+  std::uint64_t records;
+  /** @brief std::uint64_t[blocks], the offsets of the blocks of the keys */
+  std::uint64_t blocks_offset;
+  /** @brief Record[records] */
+  std::uint64_t records_offset;
+  /** @brief the pool: varint size, data */
+  std::uint64_t strings_offset;
+};
+
+struct Record
+{
+  double latitude;
+  double longitude;
+  /** @brief the offsets in the pool: line, country, region, district, place, suburb, street, house */
+  std::uint32_t fields[field_count];
+  std::uint8_t precision;
+  std::uint8_t reserved[7];
+};
+#pragma pack(pop)
+
+void writeVarint(std::string &out, std::uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+std::uint64_t readVarint(const char *&p, const char *end)
+{
+  std::uint64_t result = 0;
+  for (unsigned shift = 0; p < end && shift < 64; shift += 7)
+  {
+    const auto c = static_cast<unsigned char>(*p++);
+    result |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+    if (!(c & 0x80))
+    {
+      return result;
+    }
+  }
+  throw std::runtime_error("[Gazetteer]: invalid varint");
+}
+
+std::string makeLine(const Location &loc)
+{
+  std::string result;
+  for (const auto *i : {&loc.country, &loc.region, &loc.place, &loc.street, &loc.house})
+  {
+    if (!i->empty() && (i != &loc.place || loc.place != loc.region))
+    {
+      result += result.empty() ? "" : ", ";
+      result += *i;
+    }
+  }
+  return result;
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+Locations readGazetteerCsv(const boost::filesystem::path &filename)
+{
+  std::ifstream fin(filename.string());
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("[readGazetteerCsv]: failed open file '" + filename.string() + "'");
+  }
+
+  Locations result;
+  std::string line;
+  std::vector<std::string> row;
+  while (std::getline(fin, line))
+  {
+    boost::algorithm::trim_right(line);
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+
+    boost::split(row, line, boost::is_any_of(";"));
+    if (row.size() != 9 && row.size() != 10)
+    {
+      throw std::runtime_error("[readGazetteerCsv]: invalid line '" + line + "' in '" + filename.string() + "'");
+    }
+
+    Location loc;
+    loc.country = row[0];
+    loc.region = row[1];
+    loc.district = row[2];
+    loc.place = row[3];
+    loc.suburb = row[4];
+    loc.street = row[5];
+    loc.house = row[6];
+    loc.line = makeLine(loc);
+
+    try
+    {
+      loc.coord.latitude = std::stod(row[7]);
+      loc.coord.longitude = std::stod(row[8]);
+    }
+    catch (const std::exception &)
+    {
+      throw std::runtime_error("[readGazetteerCsv]: invalid coordinates '" + line + "' in '" + filename.string() + "'");
+    }
+
+    loc.precision = (row.size() == 10 && !row[9].empty()) ? StringToPrecision(row[9]) : Precision::exact;
+    result.push_back(std::move(loc));
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+class GazetteerBuilder::Impl final
+{
+ public:
+  Impl()
+  {
+    // the offset 0 - empty string
+    strings_.push_back('\0');
+    offsets_.emplace(std::string(), 0);
+  }
+
+  void add(const std::string &key, const Location &loc, bool normalized)
+  {
+    const auto id = static_cast<std::uint32_t>(records_.size());
+
+    Record record{};
+    record.latitude = loc.coord.latitude;
+    record.longitude = loc.coord.longitude;
+    record.precision = static_cast<std::uint8_t>(loc.precision);
+
+    const std::string *fields[field_count] = {&loc.line, &loc.country, &loc.region, &loc.district,
+                                              &loc.place, &loc.suburb, &loc.street, &loc.house};
+    for (std::size_t i = 0; i < field_count; ++i)
+    {
+      record.fields[i] = intern(*fields[i]);
+    }
+    records_.push_back(record);
+
+    if (normalized)
+    {
+      for (auto &i : normalizedKeys(loc))
+      {
+        keys_.emplace_back(std::move(i), id);
+      }
+    }
+    else
+    {
+      auto text = normalize(key);
+      if (!text.empty())
+      {
+        keys_.emplace_back(std::move(text), id);
+      }
+    }
+  }
+
+  void write(const boost::filesystem::path &filename) const
+  {
+    auto keys = keys_;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // the front coded blocks
+    std::string data;
+    std::vector<std::uint64_t> blocks;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      std::size_t shared = 0;
+      if (i % block_size == 0)
+      {
+        blocks.push_back(sizeof(Header) + data.size());
+      }
+      else
+      {
+        const auto &prev = keys[i - 1].first;
+        const auto &key = keys[i].first;
+        const auto max = std::min(prev.size(), key.size());
+        while (shared < max && prev[shared] == key[shared])
+        {
+          ++shared;
+        }
+      }
+
+      const auto &key = keys[i].first;
+      writeVarint(data, shared);
+      writeVarint(data, key.size() - shared);
+      data.append(key, shared, std::string::npos);
+      writeVarint(data, keys[i].second);
+    }
+
+    // align the offsets and the records by 8
+    data.resize((data.size() + 7) & ~static_cast<std::size_t>(7));
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.block_size = block_size;
+    header.keys = keys.size();
+    header.blocks = blocks.size();
+    header.records = records_.size();
+    header.blocks_offset = sizeof(Header) + data.size();
+    header.records_offset = header.blocks_offset + blocks.size() * sizeof(std::uint64_t);
+    header.strings_offset = header.records_offset + records_.size() * sizeof(Record);
+
+    auto tmp = filename;
+    tmp += ".tmp";
+    {
+      std::ofstream fout(tmp.string(), std::ios::binary | std::ios::trunc);
+      if (!fout.is_open())
+      {
+        throw std::runtime_error("[GazetteerBuilder::write]: failed open file '" + tmp.string() + "'");
+      }
+
+      fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      fout.write(data.data(), data.size());
+      fout.write(reinterpret_cast<const char *>(blocks.data()), blocks.size() * sizeof(std::uint64_t));
+      fout.write(reinterpret_cast<const char *>(records_.data()), records_.size() * sizeof(Record));
+      fout.write(strings_.data(), strings_.size());
+
+      if (!fout)
+      {
+        throw std::runtime_error("[GazetteerBuilder::write]: failed write file '" + tmp.string() + "'");
+      }
+    }
+
+    boost::filesystem::rename(tmp, filename);
+  }
+
+ private:
+  std::uint32_t intern(const std::string &text)
+  {
+    const auto it = offsets_.find(text);
+    if (it != offsets_.end())
+    {
+      return it->second;
+    }
+
+    const auto offset = static_cast<std::uint32_t>(strings_.size());
+    writeVarint(strings_, text.size());
+    strings_ += text;
+    offsets_.emplace(text, offset);
+    return offset;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::uint32_t>> keys_;
+  std::vector<Record> records_;
+  std::string strings_;
+  std::map<std::string, std::uint32_t> offsets_;
+};
+//--------------------------------------------------------------------------------------------
+GazetteerBuilder::GazetteerBuilder()
+ : impl_(new Impl)
+{
+}
+//--------------------------------------------------------------------------------------------
+GazetteerBuilder::~GazetteerBuilder() = default;
+//--------------------------------------------------------------------------------------------
+void GazetteerBuilder::add(const Location &loc) { impl_->add(std::string(), loc, true); }
+//--------------------------------------------------------------------------------------------
+void GazetteerBuilder::add(const std::string &key, const Location &loc) { impl_->add(key, loc, false); }
+//--------------------------------------------------------------------------------------------
+void GazetteerBuilder::write(const boost::filesystem::path &filename) const { impl_->write(filename); }
+//--------------------------------------------------------------------------------------------
+class Gazetteer::Impl final
+{
+ public:
+  explicit Impl(const boost::filesystem::path &filename)
+  {
+    if (!boost::filesystem::exists(filename))
+    {
+      throw std::runtime_error("[Gazetteer]: is not found file '" + filename.string() + "'");
+    }
+
+    file_.open(filename.string());
+    begin_ = file_.data();
+    end_ = begin_ + file_.size();
+
+    if (file_.size() < sizeof(Header))
+    {
+      throw std::runtime_error("[Gazetteer]: invalid file '" + filename.string() + "'");
+    }
+
+    // the sections are inside the file (without the overflow), the offsets of the blocks are aligned
+    const auto size = static_cast<std::uint64_t>(file_.size());
+    std::memcpy(&header_, begin_, sizeof(Header));
+    if (std::memcmp(header_.magic, magic, sizeof(magic)) || header_.block_size != block_size || header_.blocks_offset < sizeof(Header) ||
+        header_.blocks_offset > size || header_.blocks_offset % sizeof(std::uint64_t) ||
+        header_.blocks > (size - header_.blocks_offset) / sizeof(std::uint64_t) || header_.blocks != (header_.keys + block_size - 1) / block_size ||
+        header_.records_offset > size || header_.records > (size - header_.records_offset) / sizeof(Record) || header_.strings_offset > size)
+    {
+      throw std::runtime_error("[Gazetteer]: invalid file '" + filename.string() + "'");
+    }
+
+    blocks_ = reinterpret_cast<const std::uint64_t *>(begin_ + header_.blocks_offset);
+    records_ = reinterpret_cast<const Record *>(begin_ + header_.records_offset);
+    strings_ = begin_ + header_.strings_offset;
+
+    // the blocks are ascending, the first key of the block is complete: the binary search reads them without the checks
+    const char *keys_end = begin_ + header_.blocks_offset;
+    for (std::uint64_t i = 0; i < header_.blocks; ++i)
+    {
+      const auto offset = blocks_[i];
+      if (offset < sizeof(Header) || offset >= header_.blocks_offset || (i && offset <= blocks_[i - 1]))
+      {
+        throw std::runtime_error("[Gazetteer]: invalid block " + std::to_string(i) + " of file '" + filename.string() + "'");
+      }
+
+      const char *p = begin_ + offset;
+      const auto shared = readVarint(p, keys_end);
+      const auto length = readVarint(p, keys_end);
+      if (shared != 0 || length > static_cast<std::uint64_t>(keys_end - p))
+      {
+        throw std::runtime_error("[Gazetteer]: invalid block " + std::to_string(i) + " of file '" + filename.string() + "'");
+      }
+    }
+  }
+
+  std::size_t size() const { return header_.keys; }
+  std::size_t records() const { return header_.records; }
+
+  Locations find(const std::string &address) const
+  {
+    Locations result;
+
+    const auto key = normalize(address);
+    scan(key, [&result, &key, this](const std::string &current, std::uint32_t id) {
+      if (current != key)
+      {
+        return false;
+      }
+      result.push_back(record(id));
+      return true;
+    });
+
+    return result;
+  }
+
+  void forEachPrefix(const std::string &prefix, const std::function<bool(const std::string &, std::uint32_t)> &fn) const
+  {
+    scan(prefix, [&prefix, &fn](const std::string &current, std::uint32_t id) {
+      if (current.compare(0, prefix.size(), prefix) != 0)
+      {
+        return false;
+      }
+      return fn(current, id);
+    });
+  }
+
+  Location record(std::uint32_t id) const
+  {
+    if (id >= header_.records)
+    {
+      throw std::runtime_error("[Gazetteer::record]: invalid record " + std::to_string(id));
+    }
+
+    Record rec;
+    std::memcpy(&rec, records_ + id, sizeof(Record));
+
+    Location result;
+    std::string *fields[field_count] = {&result.line,  &result.country, &result.region, &result.district,
+                                        &result.place, &result.suburb,  &result.street, &result.house};
+    for (std::size_t i = 0; i < field_count; ++i)
+    {
+      if (rec.fields[i] >= static_cast<std::uint64_t>(end_ - strings_))
+      {
+        throw std::runtime_error("[Gazetteer::record]: invalid string");
+      }
+      const char *p = strings_ + rec.fields[i];
+      const auto size = readVarint(p, end_);
+      if (size > static_cast<std::uint64_t>(end_ - p))
+      {
+        throw std::runtime_error("[Gazetteer::record]: invalid string");
+      }
+      fields[i]->assign(p, size);
+    }
+
+    result.coord = Coordinates(rec.latitude, rec.longitude);
+    result.precision = static_cast<Precision>(rec.precision);
+    return result;
+  }
+
+ private:
+  /** @brief the first key of the block (checked by the open) */
+  std::string firstKey(std::uint64_t block) const
+  {
+    const char *p = begin_ + blocks_[block];
+    const char *keys_end = begin_ + header_.blocks_offset;
+    readVarint(p, keys_end);
+    const auto size = readVarint(p, keys_end);
+    return std::string(p, size);
+  }
+
+  /** @brief visit the keys >= 'from' in the sorted order while fn returns true */
+  template <typename Function>
+  void scan(const std::string &from, Function fn) const
+  {
+    if (!header_.blocks)
+    {
+      return;
+    }
+
+    // the last block with the first key < 'from' (the equal keys may begin in the previous block)
+    std::uint64_t lo = 0;
+    std::uint64_t hi = header_.blocks;
+    while (lo < hi)
+    {
+      const auto mid = lo + (hi - lo) / 2;
+      if (firstKey(mid) < from)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+
+    auto block = lo ? lo - 1 : 0;
+    const char *p = begin_ + blocks_[block];
+    const char *keys_end = begin_ + header_.blocks_offset;
+
+    std::string key;
+    for (std::uint64_t i = block * block_size; i < header_.keys && p < keys_end; ++i)
+    {
+      const auto shared = readVarint(p, keys_end);
+      const auto size = readVarint(p, keys_end);
+      if (shared > key.size() || size > static_cast<std::uint64_t>(keys_end - p))
+      {
+        throw std::runtime_error("[Gazetteer]: invalid key");
+      }
+      key.resize(shared);
+      key.append(p, size);
+      p += size;
+      const auto id = static_cast<std::uint32_t>(readVarint(p, keys_end));
+
+      if (key < from)
+      {
+        continue;
+      }
+
+      if (!fn(key, id))
+      {
+        break;
+      }
+    }
+  }
+
+ private:
+  boost::iostreams::mapped_file_source file_;
+  const char *begin_{nullptr};
+  const char *end_{nullptr};
+  const char *strings_{nullptr};
+  Header header_;
+  const std::uint64_t *blocks_{nullptr};
+  const Record *records_{nullptr};
+};
+//--------------------------------------------------------------------------------------------
+Gazetteer::Gazetteer(const boost::filesystem::path &filename)
+ : impl_(new Impl(filename))
+{
+}
+//--------------------------------------------------------------------------------------------
+Gazetteer::Gazetteer(Gazetteer &&) = default;
+Gazetteer &Gazetteer::operator=(Gazetteer &&) = default;
+Gazetteer::~Gazetteer() = default;
+//--------------------------------------------------------------------------------------------
+std::size_t Gazetteer::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+std::size_t Gazetteer::records() const { return impl_->records(); }
+//--------------------------------------------------------------------------------------------
+Locations Gazetteer::find(const std::string &address) const { return impl_->find(address); }
+//--------------------------------------------------------------------------------------------
+Location Gazetteer::record(std::uint32_t id) const { return impl_->record(id); }
+//--------------------------------------------------------------------------------------------
+void Gazetteer::forEachPrefix(const std::string &prefix, const std::function<bool(const std::string &, std::uint32_t)> &fn) const
+{
+  impl_->forEachPrefix(prefix, fn);
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -5,16 +5,25 @@
  */
 
 // std
+#include <algorithm>
 #include <iomanip>
+#include <vector>
 
 // boost
 #include <boost/format.hpp>
+#include <boost/optional.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 // this
 #include "geo/geocoderbase.h"
+#include "utils/balancer.h"
+#include "utils/limiter.h"
 #include "utils/libcurl/libcurl.h"
+#include "utils/libcurl/multiplexer.h"
+#include "utils/logger/binary.h"
 #include "utils/logger/logger.h"
+#include "utils/metrics.h"
+#include "utils/recorder.h"
 
 namespace geocoder
 {
@@ -40,23 +49,103 @@ class GeocoderBase::Impl final
     name_ = conf.get<std::string>("name");
     if (const auto conn = conf.get_child_optional("connection"))
     {
-      if (const auto url_opt = conn->get_optional<std::string>("url"))
+      if (conn->get_optional<std::string>("url") || conn->get_child_optional("endpoints"))
       {
-        const auto timeout = conn->get<std::size_t>("timeout", timeout_);
-        const auto conntimeout = conn->get<std::size_t>("conntimeout", conntimeout_);
+        const auto endpoints = utils::readEndpoints(*conn);
+        const auto &url = endpoints.front().url;
+        // the timeouts in milliseconds: 'timeout_ms' ('conntimeout_ms') or 'timeout' ('conntimeout') in seconds
+        const auto timeout = conn->get<std::size_t>("timeout_ms", conn->get<std::size_t>("timeout", timeout_) * 1000);
+        const auto conntimeout = conn->get<std::size_t>("conntimeout_ms", conn->get<std::size_t>("conntimeout", conntimeout_) * 1000);
         const auto verbose = conn->get<bool>("verbose", verbose_);
+        low_speed_limit_ = conn->get<std::uint32_t>("low_speed_limit", 0);
+        low_speed_time_ = conn->get<std::uint32_t>("low_speed_time", 0);
 
         BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: Geocoder param: ";
         BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: name '" << name_ << "'";
-        BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: timeout '" << timeout << "'";
-        BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: conntimeout '" << conntimeout << "'";
+        BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: timeout '" << timeout << "' ms";
+        BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: conntimeout '" << conntimeout << "' ms";
+        BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: low speed '" << low_speed_limit_ << "' bytes/s, '"
+                                                             << low_speed_time_ << "' sec";
         BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBAse::Impl::Impl]: verbose '" << std::boolalpha << verbose << "'";
 
-        conn_param_ = std::make_tuple(*url_opt, timeout, conntimeout, verbose);
+        conn_param_ = std::make_tuple(url, timeout, conntimeout, verbose);
+        for (const auto &i : endpoints)
+        {
+          if (std::find(hosts_.begin(), hosts_.end(), i.url) == hosts_.end())
+          {
+            hosts_.push_back(i.url);
+          }
+        }
+
+        // the endpoints (api keys) with the weights and the daily quotas, common for the all workers
+        if (conn->get_child_optional("endpoints"))
+        {
+          const auto usage = boost::filesystem::path(conn->get<std::string>("usage", std::string()));
+          key_param_ = conn->get<std::string>("key_param", key_param_);
+          balancer_ = utils::Balancer::shared(name_ + " " + usage.string(), endpoints, usage);
+          for (const auto &i : endpoints)
+          {
+            endpoint_requests_.push_back(&utils::metrics::counter("geocoder." + name_ + ".endpoint." + i.id + ".requests"));
+            BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: endpoint '" << i.id << "', weight '" << i.weight
+                                                                 << "', quota '" << i.quota << "'";
+          }
+          BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: usage '" << usage << "'";
+        }
+
+        // the adaptive limit of the requests in flight, common for the all workers of the geocoder
+        if (const auto limiter = conn->get_child_optional("limiter"))
+        {
+          const auto options = utils::readLimiterOptions(*limiter);
+          limiter_ = utils::Limiter::shared(name_ + " " + url, options, "geocoder." + name_ + ".limit");
+          BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: limiter initial '" << options.initial << "', min '"
+                                                               << options.min << "', max '" << options.max << "'";
+        }
+
+        // Accept-Encoding: "gzip, deflate, br", empty - the all supported by libcurl
+        if (const auto encoding = conn->get_optional<std::string>("accept_encoding"))
+        {
+          accept_encoding_ = *encoding;
+          BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: accept_encoding '" << *encoding << "'";
+        }
+
+        // HTTP/1.1: the options are applied once to the handles, the request sets the url and the rest of the deadline
+        utils::curl::LibCurlOptions curl_options;
+        curl_options.timeout_ms = static_cast<std::uint32_t>(timeout);
+        curl_options.conntimeout_ms = static_cast<std::uint32_t>(conntimeout);
+        curl_options.low_speed_limit = low_speed_limit_;
+        curl_options.low_speed_time = low_speed_time_;
+        curl_options.verbose = verbose;
+        curl_options.compression = accept_encoding_.is_initialized();
+        curl_options.accept_encoding = accept_encoding_.value_or(std::string());
+        curl_ = utils::curl::LibCurl(curl_options);
+
+        // HTTP/2: the all workers share one multiplexer (connection) per geocoder
+        const auto http_version = conn->get<std::string>("http_version", "1.1");
+        if (http_version != "1.1")
+        {
+          utils::curl::MultiplexerOptions options;
+          options.version = utils::curl::MultiplexerOptions::textToVersion(http_version);
+          options.max_connections = conn->get<std::size_t>("max_connections", options.max_connections);
+          options.max_streams = conn->get<std::size_t>("max_streams", options.max_streams);
+          options.timeout_ms = static_cast<std::uint32_t>(timeout);
+          options.conntimeout_ms = static_cast<std::uint32_t>(conntimeout);
+          options.low_speed_limit = low_speed_limit_;
+          options.low_speed_time = low_speed_time_;
+          options.verbose = verbose;
+          options.compression = accept_encoding_.is_initialized();
+          options.accept_encoding = accept_encoding_.value_or(std::string());
+
+          BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase::Impl::Impl]: http_version '" << http_version << "'";
+          BOOST_LOG_SEV(logger, utils::logger::Severity::info)
+              << "[GeocoderBase::Impl::Impl]: max_connections '" << options.max_connections << "'";
+
+          multiplexer_ = utils::curl::Multiplexer::shared(name_ + " " + url, options);
+          max_connections_ = options.max_connections;
+        }
       }
       else
       {
-        throw std::runtime_error("[GecoderBase::Impl::Impl]: Failed initialization, is not set 'url' option");
+        throw std::runtime_error("[GecoderBase::Impl::Impl]: Failed initialization, is not set 'url' or 'endpoints' option");
       }
     }
     else
@@ -64,6 +153,18 @@ class GeocoderBase::Impl final
       throw std::runtime_error("[GeocoderBase::Impl::Impl]: Failed initialization, is not exists config section 'connection'");
     }
 
+    if (const auto recorder = conf.get_child_optional("recorder"))
+    {
+      recorder_ = utils::Recorder(*recorder);
+      BOOST_LOG_SEV(logger, utils::logger::Severity::info)
+          << "[GeocoderBase::Impl::Impl]: recorder '" << utils::Recorder::modeToText(recorder_.mode()) << "'";
+    }
+
+    requests_ = &utils::metrics::counter("geocoder." + name_ + ".requests");
+    deadline_exceeded_ = &utils::metrics::counter("geocoder." + name_ + ".deadline_exceeded");
+    bytes_wire_ = &utils::metrics::counter("geocoder." + name_ + ".bytes_wire");
+    bytes_decoded_ = &utils::metrics::counter("geocoder." + name_ + ".bytes_decoded");
+
     BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeocoderBase:Impl::Impl]: Complete initization.";
   }
   Impl(Impl &&) = default;
@@ -71,33 +172,218 @@ class GeocoderBase::Impl final
   Impl(const Impl &) = delete;
   Impl &operator=(const Impl &) = delete;
 
-  std::tuple<std::string, long> get(const std::string &addr)
+  /** @brief the answer is in 'body' (the buffer is reused by the next request)
+   *  @return the response code
+   */
+  long get(const std::string &addr)
   {
-    std::string url;
-    std::size_t timeout{};
-    std::size_t conntimeout{};
-    bool verbose{};
+    const auto &url = std::get<0>(conn_param_);
 
-    std::tie(url, timeout, conntimeout, verbose) = conn_param_;
+    // the request of the first endpoint without key: the name of the recorded response
+    escaped_.clear();
+    curl_.escapeUrl(addr, escaped_);
+    request_.assign(url).append(escaped_).append(params_);
 
-    curl_.setTimeOut(timeout);
-    curl_.setConnTimeOut(conntimeout);
-    curl_.verbose(verbose);
+    auto &logger = geo_logger::get();
+    GEO_LOG_BIN(logger, utils::logger::Severity::trace, "[GeocoderBase::Impl::get]: request '{}'", request_);
 
-    const auto request = url + addr;
+    if (recorder_.mode() == utils::Recorder::Mode::replay)
+    {
+      auto loaded = recorder_.load(request_);
+      body_ = std::move(std::get<0>(loaded));
+      return std::get<1>(loaded);
+    }
 
-    auto &logger = geo_logger::get();
-    BOOST_LOG_SEV(logger, utils::logger::Severity::trace) << "[GeocoderBase::Impl::Impl]: resuest '" << request << "'";
+    long code = 0;
+    // 403 - the key is exhausted for the day, 429 - the rate of the key: the next endpoint
+    for (std::size_t attempt = 0;; ++attempt)
+    {
+      if (!balancer_)
+      {
+        code = send(request_);
+        break;
+      }
+
+      const auto endpoint = balancer_->acquire();
+      const auto &e = balancer_->endpoint(endpoint);
+      endpoint_requests_[endpoint]->add();
+
+      keyed_.assign(e.url).append(escaped_).append(params_);
+      if (!e.key.empty())
+      {
+        keyed_.append("&").append(key_param_).append("=");
+        curl_.escapeUrl(e.key, keyed_);
+      }
+      code = send(keyed_);
+
+      if (code == 403)
+      {
+        balancer_->exhaust(endpoint);
+      }
+      if ((code != 403 && code != 429) || attempt + 1 >= balancer_->size())
+      {
+        break;
+      }
+    }
 
-    return curl_.get(request);
+    if (recorder_.mode() == utils::Recorder::Mode::record)
+    {
+      recorder_.save(request_, body_, code);
+    }
+
+    return code;
   }
 
+  const std::string &body() const { return body_; }
+
   const std::string &getName() const { return name_; }
 
+  void setParams(const std::string &params) { params_ = params; }
+
+  void setDeadline(Clock::time_point deadline, std::chrono::milliseconds min_request)
+  {
+    deadline_ = deadline;
+    min_request_ = min_request;
+  }
+
+  void warmup(std::size_t connections)
+  {
+    if (recorder_.mode() == utils::Recorder::Mode::replay)
+    {
+      return;
+    }
+
+    // the head request: dns, tcp and tls of the each url of the endpoints, the connection stays in the cache
+    for (const auto &url : hosts_)
+    {
+      if (multiplexer_)
+      {
+        multiplexer_->warmup(url, std::min(std::max<std::size_t>(connections, 1), max_connections_));
+      }
+      else
+      {
+        curl_.head(url);
+      }
+    }
+  }
+
+ private:
+  /** @brief the request in the limit of the requests in flight: 429, 503 and the transport error are the overload */
+  long send(const std::string &request)
+  {
+    if (deadline_ != Clock::time_point::max() && deadline_ - Clock::now() < min_request_)
+    {
+      deadline_exceeded_->add();
+      throw std::runtime_error("[GeocoderBase::Impl::send]: the deadline is exceeded, the request of '" + name_ + "' is not started");
+    }
+
+    bool capped = false;
+    if (!limiter_)
+    {
+      return perform(request, capped);
+    }
+
+    // the wait for the limit ends when the rest of the deadline is less than the minimum request
+    const auto ticket = limiter_->acquire((deadline_ == Clock::time_point::max()) ? deadline_ : deadline_ - min_request_);
+    if (!ticket)
+    {
+      deadline_exceeded_->add();
+      throw std::runtime_error("[GeocoderBase::Impl::send]: the deadline is exceeded by the wait for the limit, the request of '" + name_ +
+                               "' is not started");
+    }
+
+    long code = 0;
+    try
+    {
+      code = perform(request, capped);
+    }
+    catch (...)
+    {
+      // the timeout of the deadline is not the overload of the geocoder (the rest is rounded down to the milliseconds)
+      const auto expired = capped && Clock::now() + std::chrono::milliseconds(1) >= deadline_;
+      limiter_->release(*ticket, expired ? utils::Limiter::Outcome::ignore : utils::Limiter::Outcome::overload);
+      throw;
+    }
+
+    if (code == 429 || code == 503)
+    {
+      limiter_->release(*ticket, utils::Limiter::Outcome::overload);
+    }
+    else
+    {
+      limiter_->release(*ticket, (code >= 400) ? utils::Limiter::Outcome::ignore : utils::Limiter::Outcome::success);
+    }
+    return code;
+  }
+
+  /** @brief the request by http/1.1 or the multiplexer, the traffic is counted
+   *  @param capped - the timeout is the rest of the deadline
+   */
+  long perform(const std::string &request, bool &capped)
+  {
+    auto timeout = std::get<1>(conn_param_);
+
+    // the rest of the deadline (the wait for the limiter is spent)
+    if (deadline_ != Clock::time_point::max())
+    {
+      const auto rest = static_cast<std::size_t>(std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now()).count(), 1));
+      // 0 - no timeout
+      capped = (timeout == 0 || rest < timeout);
+      timeout = capped ? rest : timeout;
+    }
+
+    long code = 0;
+    std::uint64_t wire = 0;
+    if (multiplexer_)
+    {
+      // the body is received by the thread of the multiplexer
+      auto result = multiplexer_->get(request, wire, static_cast<std::uint32_t>(timeout));
+      body_ = std::move(std::get<0>(result));
+      code = std::get<1>(result);
+    }
+    else
+    {
+      code = curl_.get(request, body_, static_cast<std::uint32_t>(timeout));
+      wire = curl_.lastWireSize();
+    }
+
+    requests_->add();
+    bytes_wire_->add(wire);
+    bytes_decoded_->add(body_.size());
+    return code;
+  }
+
  private:
   utils::curl::LibCurl curl_;
   std::string name_;
   std::tuple<std::string, std::size_t, std::size_t, bool> conn_param_;
+  std::string params_;
+  // the buffers of the request and the answer, reused by the requests of the worker
+  std::string escaped_;
+  std::string request_;
+  std::string keyed_;
+  std::string body_;
+  utils::Recorder recorder_;
+  std::shared_ptr<utils::curl::Multiplexer> multiplexer_;
+  boost::optional<std::string> accept_encoding_;
+  std::shared_ptr<utils::Balancer> balancer_;
+  std::shared_ptr<utils::Limiter> limiter_;
+  std::string key_param_{"apikey"};
+  std::vector<utils::metrics::Counter *> endpoint_requests_;
+  // traffic counters of the geocoder, 'geocoder.<name>.*'
+  utils::metrics::Counter *requests_{nullptr};
+  utils::metrics::Counter *bytes_wire_{nullptr};
+  utils::metrics::Counter *bytes_decoded_{nullptr};
+  utils::metrics::Counter *deadline_exceeded_{nullptr};
+  // abort of the slow transfer, 0 - disabled
+  std::uint32_t low_speed_limit_{0};
+  std::uint32_t low_speed_time_{0};
+  // the distinct urls of the endpoints (the warm-up)
+  std::vector<std::string> hosts_;
+  std::size_t max_connections_{1};
+  // the deadline of the address (GeoPool)
+  Clock::time_point deadline_{Clock::time_point::max()};
+  std::chrono::milliseconds min_request_{0};
 };
 //--------------------------------------------------------------------------------------------
 const std::size_t GeocoderBase::Impl::timeout_ = 100;
@@ -109,24 +395,48 @@ GeocoderBase::GeocoderBase(const boost::property_tree::ptree &conf)
 {
 }
 //--------------------------------------------------------------------------------------------
-GeocoderBase::Result GeocoderBase::geocode(const std::string &address)
+GeocoderBase::GeocoderBase() = default;
+//--------------------------------------------------------------------------------------------
+void GeocoderBase::setParams(const std::string &params) { impl_->setParams(params); }
+//--------------------------------------------------------------------------------------------
+void GeocoderBase::setDeadline(Clock::time_point deadline, std::chrono::milliseconds min_request)
 {
+  // the local geocoder has no requests
+  if (impl_)
+  {
+    impl_->setDeadline(deadline, min_request);
+  }
+}
+//--------------------------------------------------------------------------------------------
+void GeocoderBase::warmup(std::size_t connections)
+{
+  if (impl_)
+  {
+    impl_->warmup(connections);
+  }
+}
+//--------------------------------------------------------------------------------------------
+GeocoderBase::Result GeocoderBase::geocode(const std::string &address, const ParseOptions &options)
+{
+  if (!impl_)
+  {
+    throw std::logic_error("[GeocoderBase::geocode]: the geocoder without connection");
+  }
+
   // get data from geocoder
-  std::string buffer;
-  long code{};
-  std::tie(buffer, code) = impl_->get(address);
+  const auto code = impl_->get(address);
 
-  // > 400 - error clients
-  if (code > 400)
+  // >= 400 - the error response (400 - the address is rejected), the body is not the answer
+  if (code >= 400)
   {
     boost::format err("[GeocoderBase::geocoder]: failed read data from geocoder '%1%', address = '%2%', return code '%3%'");
     err % impl_->getName();
     err % address;
     err % code;
-    throw std::runtime_error(err.str());
+    throw ResponseError(err.str(), code);
   }
 
-  return parse(buffer);
+  return parse(impl_->body(), options);
 }
 //--------------------------------------------------------------------------------------------
 }  // namespace geo
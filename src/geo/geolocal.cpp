@@ -0,0 +1,174 @@
+/** @file geolocal.cpp
+ *  @brief the implementation of the class GeoLocal
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <map>
+#include <mutex>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+
+// this
+#include "geo/fuzzy.h"
+#include "geo/gazetteer.h"
+#include "geo/geolocal.h"
+#include "utils/logger/logger.h"
+#include "utils/metrics.h"
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief the index is mapped once per process, the geocoders of the all GeoPool share it */
+std::shared_ptr<const Gazetteer> sharedGazetteer(const boost::filesystem::path &filename)
+{
+  static std::mutex lock;
+  static std::map<boost::filesystem::path, std::weak_ptr<const Gazetteer>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  auto &item = registry[filename];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<const Gazetteer>(filename);
+    item = result;
+  }
+
+  return result;
+}
+
+/** @brief the fuzzy index is built once per process for the index file */
+std::shared_ptr<const FuzzyIndex> sharedFuzzyIndex(const boost::filesystem::path &filename, const Gazetteer &gazetteer)
+{
+  static std::mutex lock;
+  static std::map<boost::filesystem::path, std::weak_ptr<const FuzzyIndex>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  auto &item = registry[filename];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<const FuzzyIndex>(gazetteer);
+    item = result;
+  }
+
+  return result;
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+class GeoLocal final : public GeocoderBase
+{
+ public:
+  explicit GeoLocal(const boost::property_tree::ptree &conf)
+  {
+    auto &logger = geo_logger::get();
+
+    const auto name = conf.get<std::string>("name");
+    const auto index = conf.get_optional<std::string>("index");
+    if (!index)
+    {
+      throw std::runtime_error("[GeoLocal::GeoLocal]: Failed initialization, is not set 'index' option");
+    }
+
+    gazetteer_ = sharedGazetteer(*index);
+
+    requests_ = &utils::metrics::counter("geocoder." + name + ".requests");
+    hits_ = &utils::metrics::counter("geocoder." + name + ".hits");
+
+    BOOST_LOG_SEV(logger, utils::logger::Severity::info)
+        << "[GeoLocal::GeoLocal]: index '" << *index << "', keys " << gazetteer_->size() << ", locations " << gazetteer_->records();
+
+    if (conf.get<bool>("fuzzy.enabled", false))
+    {
+      fuzzy_options_.threshold = conf.get<double>("fuzzy.threshold", fuzzy_options_.threshold);
+      fuzzy_options_.max_distance = conf.get<std::size_t>("fuzzy.max_distance", fuzzy_options_.max_distance);
+      fuzzy_options_.candidates = conf.get<std::size_t>("fuzzy.candidates", fuzzy_options_.candidates);
+      fuzzy_options_.exact_numbers = conf.get<bool>("fuzzy.exact_numbers", fuzzy_options_.exact_numbers);
+
+      fuzzy_ = sharedFuzzyIndex(*index, *gazetteer_);
+      fuzzy_hits_ = &utils::metrics::counter("geocoder." + name + ".fuzzy_hits");
+
+      BOOST_LOG_SEV(logger, utils::logger::Severity::info)
+          << "[GeoLocal::GeoLocal]: fuzzy matching, threshold " << fuzzy_options_.threshold << ", max_distance "
+          << fuzzy_options_.max_distance << ", candidates " << fuzzy_options_.candidates;
+    }
+  }
+
+  Result geocode(const std::string &address, const ParseOptions &options = ParseOptions()) override
+  {
+    requests_->add();
+
+    Answer answer;
+    answer.type = Answer::GeocoderType::local;
+    answer.locations = gazetteer_->find(address);
+
+    if (answer.locations.empty() && fuzzy_)
+    {
+      answer.locations = fuzzyFind(address);
+      if (!answer.locations.empty())
+      {
+        fuzzy_hits_->add();
+      }
+    }
+
+    applyParseOptions(options, answer.locations);
+
+    const bool ret = !answer.locations.empty();
+    if (ret)
+    {
+      hits_->add();
+    }
+
+    return std::make_tuple(ret, std::move(answer));
+  }
+
+ protected:
+  Result parse(const std::string &, const ParseOptions &) override { throw std::logic_error("[GeoLocal::parse]: is not used"); }
+
+ private:
+  /** @brief the locations of the best match, empty - is not found or the best score is shared by the different keys */
+  Locations fuzzyFind(const std::string &address) const
+  {
+    Locations result;
+
+    const auto matches = fuzzy_->match(address, fuzzy_options_);
+    if (matches.empty() || (matches.size() > 1 && matches[1].score == matches[0].score))
+    {
+      return result;
+    }
+
+    BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::debug)
+        << "[GeoLocal::fuzzyFind]: '" << address << "' -> '" << matches[0].key << "', score " << matches[0].score;
+
+    for (const auto id : matches[0].ids)
+    {
+      result.push_back(gazetteer_->record(id));
+    }
+    return result;
+  }
+
+ private:
+  std::shared_ptr<const Gazetteer> gazetteer_;
+  std::shared_ptr<const FuzzyIndex> fuzzy_;
+  FuzzyOptions fuzzy_options_;
+  utils::metrics::Counter *fuzzy_hits_{nullptr};
+  utils::metrics::Counter *requests_{nullptr};
+  utils::metrics::Counter *hits_{nullptr};
+};
+//--------------------------------------------------------------------------------------------
+GeocoderPtr createLocalGeocoder(const boost::property_tree::ptree &conf)
+{
+  GeocoderPtr result(new GeoLocal(conf));
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -6,15 +6,20 @@
 
 // std
 #include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
 
 // boost
 #include <boost/property_tree/ptree.hpp>
 
 // this
 #include "geo/geocoderbase.h"
+#include "geo/geolocal.h"
 #include "geo/geopool.h"
 #include "geo/geoyandex.h"
 #include "utils/logger/logger.h"
+#include "utils/negative_cache.h"
 
 namespace geocoder
 {
@@ -34,17 +39,30 @@ class GeoPool::Impl final
     auto &logger = geo_logger::get();
     BOOST_LOG_SEV(logger, Severity::info) << "[GeoPool::Impl::Impl]: Start initialization GeoPool...";
 
+    const auto recorder = conf.get_child_optional("document.recorder");
+
     if (const auto g = conf.get_child_optional("document.geocoders"))
     {
       auto r = g->equal_range("geocoder");
       for (; r.first != r.second; ++r.first)
       {
-        const auto &geo = r.first->second;
+        auto geo = r.first->second;
         const auto name = geo.get<std::string>("name");
+
+        // the recorder is common for the all geocoders
+        if (recorder)
+        {
+          geo.put_child("recorder", *recorder);
+        }
+
         if (name == "yandex")
         {
           geocoders_.push_back(createYandexGeocoder(geo));
         }
+        else if (name == "local")
+        {
+          geocoders_.push_back(createLocalGeocoder(geo));
+        }
       }
     }
     else
@@ -52,34 +70,152 @@ class GeoPool::Impl final
       BOOST_LOG_SEV(logger, Severity::warning) << "[GeoPool::Impl::Impl]: is not found 'document.geocoders'";
     }
 
+    total_ = std::chrono::milliseconds(conf.get<std::int64_t>("document.deadline.total", 0));
+    min_request_ = std::chrono::milliseconds(conf.get<std::int64_t>("document.deadline.min_request", 0));
+    if (total_.count() < 0 || min_request_.count() < 0)
+    {
+      throw std::runtime_error("[GeoPool::Impl::Impl]: negative 'document.deadline'");
+    }
+    if (total_.count() != 0)
+    {
+      BOOST_LOG_SEV(logger, Severity::info) << "[GeoPool::Impl::Impl]: deadline " << total_.count() << " ms, min request " << min_request_.count()
+                                            << " ms";
+    }
+
+    // the default locations of the answer
+    if (const auto parse = conf.get_child_optional("document.parse"))
+    {
+      parse_ = readParseOptions(*parse);
+    }
+
+    // the addresses not resolved by the all geocoders are answered without the requests
+    if (const auto cache = conf.get_child_optional("document.negative_cache"))
+    {
+      const auto options = utils::readNegativeCacheOptions(*cache);
+      if (options.size != 0)
+      {
+        negative_ = utils::NegativeCache::shared("geopool", options);
+        BOOST_LOG_SEV(logger, Severity::info) << "[GeoPool::Impl::Impl]: negative cache size " << options.size << ", ttl "
+                                              << options.ttl.count() << " sec";
+      }
+    }
+
+    // the connections are opened before the first address, kept warm while idle (service mode)
+    prewarm_ = conf.get<bool>("document.prewarm.enabled", false);
+    connections_ = conf.get<std::size_t>("document.prewarm.connections", connections_);
+    keepalive_ = std::chrono::seconds(conf.get<std::int64_t>("document.prewarm.keepalive", 0));
+    if (prewarm_)
+    {
+      BOOST_LOG_SEV(logger, Severity::info) << "[GeoPool::Impl::Impl]: prewarm connections " << connections_ << ", keepalive "
+                                            << keepalive_.count() << " sec";
+      warmup();
+    }
+
     BOOST_LOG_SEV(logger, Severity::info) << "[GeoPool::Impl::Impl]: Complete initialization.";
   }
 
-  Answer get(const std::string &addr)
+  const ParseOptions &parseOptions() const { return parse_; }
+
+  Status status() const { return status_; }
+
+  Answer get(const std::string &addr, const ParseOptions &options)
   {
+    using Clock = GeocoderBase::Clock;
     Answer result;
+    last_ = Clock::now();
 
-    for (const auto &g : geocoders_)
+    // the filtered answer is not the answer of the geocoders
+    const auto complete = options.complete();
+    if (complete && negative_ && negative_->contains(addr))
+    {
+      status_ = Status::not_found;
+      return result;
+    }
+
+    // not found by the all geocoders: the empty answers and the rejected addresses (4xx), not the transient errors
+    bool negative = !geocoders_.empty();
+    status_ = Status::failed;
+
+    // the deadline of the address, the rest is shared equally by the rest of the chain
+    const auto deadline = (total_.count() != 0) ? Clock::now() + total_ : Clock::time_point::max();
+    for (std::size_t n = 0; n < geocoders_.size(); ++n)
     {
+      const auto &g = geocoders_[n];
       try
       {
-        auto ret = g->geocode(addr);
+        if (deadline != Clock::time_point::max())
+        {
+          const auto now = Clock::now();
+          if (deadline - now < min_request_)
+          {
+            BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::warning) << "[GeoPool::Impl::get]: the deadline is exceeded, '" << addr << "'";
+            negative = false;
+            break;
+          }
+          g->setDeadline(now + (deadline - now) / static_cast<int>(geocoders_.size() - n), min_request_);
+        }
+
+        auto ret = g->geocode(addr, options);
         if (std::get<0>(ret))
         {
-          std::swap(result, std::get<1>(ret));
+          result = std::move(std::get<1>(ret));
+          negative = false;
+          status_ = Status::found;
           break;
         }
       }
+      catch (const ResponseError &err)
+      {
+        negative = negative && err.rejected();
+        BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::warning) << "[GeoPool::Impl::get]: failed request data, '" << err.what() << "'";
+      }
       catch (const std::exception &err)
       {
+        negative = false;
         auto &logger = geo_logger::get();
         BOOST_LOG_SEV(logger, utils::logger::Severity::warning) << "[GeoPool::Impl::get]: failed request data, '" << err.what() << "'";
       }
     }
 
+    if (negative)
+    {
+      status_ = Status::not_found;
+      if (complete && negative_)
+      {
+        negative_->insert(addr);
+      }
+    }
+
     return result;
   }
 
+  void warmup()
+  {
+    for (const auto &g : geocoders_)
+    {
+      try
+      {
+        g->warmup(connections_);
+      }
+      catch (const std::exception &err)
+      {
+        BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::warning) << "[GeoPool::Impl::warmup]: " << err.what();
+      }
+    }
+    last_ = GeocoderBase::Clock::now();
+  }
+
+  std::chrono::seconds keepAlivePeriod() const { return prewarm_ ? keepalive_ : std::chrono::seconds(0); }
+
+  void keepAlive()
+  {
+    const auto period = keepAlivePeriod();
+    if (period.count() != 0 && GeocoderBase::Clock::now() - last_ >= period)
+    {
+      warmup();
+    }
+  }
+
   Impl(Impl &&) = default;
   Impl &operator=(Impl &&) = default;
   Impl(const Impl &) = delete;
@@ -87,6 +223,18 @@ class GeoPool::Impl final
 
  private:
   std::vector<GeocoderPtr> geocoders_;
+  /** @brief the deadline of the address, 0 - none */
+  std::chrono::milliseconds total_{0};
+  std::chrono::milliseconds min_request_{0};
+  ParseOptions parse_;
+  std::shared_ptr<utils::NegativeCache> negative_;
+  /** @brief the warm-up of the connections */
+  bool prewarm_{false};
+  std::size_t connections_{1};
+  std::chrono::seconds keepalive_{0};
+  /** @brief the last request or warm-up */
+  GeocoderBase::Clock::time_point last_;
+  Status status_{Status::failed};
 };
 //--------------------------------------------------------------------------------------------
 GeoPool::GeoPool(const boost::property_tree::ptree &conf)
@@ -94,7 +242,19 @@ GeoPool::GeoPool(const boost::property_tree::ptree &conf)
 {
 }
 //--------------------------------------------------------------------------------------------
-Answer GeoPool::geocode(const std::string &addr) { return impl_->get(addr); }
+Answer GeoPool::geocode(const std::string &addr) { return impl_->get(addr, impl_->parseOptions()); }
+//--------------------------------------------------------------------------------------------
+Answer GeoPool::geocode(const std::string &addr, const ParseOptions &options) { return impl_->get(addr, options); }
+//--------------------------------------------------------------------------------------------
+const ParseOptions &GeoPool::parseOptions() const { return impl_->parseOptions(); }
+//--------------------------------------------------------------------------------------------
+GeoPool::Status GeoPool::status() const { return impl_->status(); }
+//--------------------------------------------------------------------------------------------
+void GeoPool::warmup() { impl_->warmup(); }
+//--------------------------------------------------------------------------------------------
+std::chrono::seconds GeoPool::keepAlivePeriod() const { return impl_->keepAlivePeriod(); }
+//--------------------------------------------------------------------------------------------
+void GeoPool::keepAlive() { impl_->keepAlive(); }
 //--------------------------------------------------------------------------------------------
 }  // namespace geo
 }  // namespace geocoder
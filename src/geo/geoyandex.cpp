@@ -5,8 +5,11 @@
  */
 
 // std
+#include <cstdlib>
+#include <cstring>
 #include <map>
 #include <sstream>
+#include <utility>
 
 // boost
 #include <boost/algorithm/string.hpp>
@@ -15,6 +18,7 @@
 
 // this
 #include "geo/geoyandex.h"
+#include "utils/json.h"
 #include "utils/logger/logger.h"
 
 namespace geocoder
@@ -23,20 +27,88 @@ namespace geo
 {
 using GeoData = std::map<std::string, std::string>;
 
-void processTree(const boost::property_tree::ptree &pt, GeoData &data)
+namespace
 {
-  for (const auto &i : pt.get_child(""))
+/** @brief the text fields of the location by the name of the element */
+const std::pair<const char *, ParseOptions::Field> text_fields[] = {{"AddressLine", ParseOptions::line},
+                                                                    {"CountryName", ParseOptions::country},
+                                                                    {"AdministrativeAreaName", ParseOptions::region},
+                                                                    {"SubAdministrativeAreaName", ParseOptions::district},
+                                                                    {"LocalityName", ParseOptions::place},
+                                                                    {"DependentLocalityName", ParseOptions::suburb},
+                                                                    {"ThoroughfareName", ParseOptions::street},
+                                                                    {"PremiseNumber", ParseOptions::house}};
+
+bool isWanted(const std::string &name, const ParseOptions &options)
+{
+  if (name == "pos")
   {
-    const auto &name = i.first;
-    auto desc = pt.get<std::string>(name);
+    return true;
+  }
+  for (const auto &i : text_fields)
+  {
+    if (name == i.first)
+    {
+      return options.has(i.second);
+    }
+  }
+  return false;
+}
+
+/** @brief the count of the names filled by 'processTree' */
+std::size_t countWanted(const ParseOptions &options)
+{
+  std::size_t result = 1;
+  for (const auto &i : text_fields)
+  {
+    result += options.has(i.second) ? 1 : 0;
+  }
+  return result;
+}
+
+/** @brief the first not empty value of the name in the depth-first order */
+bool findFirst(const boost::property_tree::ptree &pt, const char *name, std::string &value)
+{
+  for (const auto &i : pt)
+  {
+    if (i.first == name)
+    {
+      value = boost::algorithm::trim_copy(i.second.data());
+      if (!value.empty())
+      {
+        return true;
+      }
+    }
+    if (findFirst(i.second, name, value))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+/** @brief the values of the wanted names (the first wins), the walk stops when the all are found */
+void processTree(const boost::property_tree::ptree &pt, const ParseOptions &options, std::size_t wanted, GeoData &data)
+{
+  for (const auto &i : pt)
+  {
+    if (data.size() == wanted)
+    {
+      return;
+    }
 
-    boost::algorithm::trim(desc);
-    if (!desc.empty())
+    const auto &name = i.first;
+    if (isWanted(name, options) && data.find(name) == data.end())
     {
-      data.emplace(name, desc);
+      auto desc = boost::algorithm::trim_copy(i.second.data());
+      if (!desc.empty())
+      {
+        data.emplace(name, std::move(desc));
+      }
     }
 
-    processTree(i.second, data);
+    processTree(i.second, options, wanted, data);
   }
 }
 
@@ -72,73 +144,336 @@ Precision textToPrecision(const std::string &precision)
   }
 }
 
-class GeoYandex final : public GeocoderBase
+//--------------------------------------------------------------------------------------------
+Locations parseYandexXml(const std::string &buffer, const ParseOptions &options)
 {
- public:
-  explicit GeoYandex(const boost::property_tree::ptree &conf)
-   : GeocoderBase(conf)
+  namespace pt = boost::property_tree;
+
+  std::istringstream in(buffer);
+
+  Locations result;
+
+  pt::ptree document;
+  pt::read_xml(in, document);
+
+  if (const auto ymaps = document.get_child_optional("ymaps"))
   {
+    if (const auto geo_obj_coll = ymaps->get_child_optional("GeoObjectCollection"))
+    {
+      auto r = geo_obj_coll->equal_range("featureMember");
+      const auto wanted = countWanted(options);
+
+      for (; r.first != r.second; ++r.first)
+      {
+        if (options.max_results != 0 && result.size() >= options.max_results)
+        {
+          break;
+        }
+
+        const auto &geo_obj = r.first->second;
+
+        // the precision is first: the rejected location is not walked
+        std::string precision;
+        findFirst(geo_obj, "precision", precision);
+        const auto prec = textToPrecision(precision);
+        if (!options.accept(prec))
+        {
+          continue;
+        }
+
+        GeoData data;
+        processTree(geo_obj, options, wanted, data);
+
+        auto text_coord = data["pos"];
+        std::vector<std::string> spl_coord;
+        boost::split(spl_coord, text_coord, boost::is_any_of(" "));
+
+        Coordinates coord;
+        coord.longitude = std::stod(spl_coord.at(0));
+        coord.latitude = std::stod(spl_coord.at(1));
+
+        Location loc;
+
+        loc.line = std::move(data["AddressLine"]);
+
+        loc.country = std::move(data["CountryName"]);
+        loc.region = std::move(data["AdministrativeAreaName"]);
+        loc.district = std::move(data["SubAdministrativeAreaName"]);
+        loc.place = std::move(data["LocalityName"]);
+        loc.suburb = std::move(data["DependentLocalityName"]);
+        loc.street = std::move(data["ThoroughfareName"]);
+        loc.house = std::move(data["PremiseNumber"]);
+        loc.coord = coord;
+        loc.precision = prec;
+
+        result.push_back(std::move(loc));
+      }
+    }
   }
 
- protected:
-  virtual Result parse(const std::string &buffer)
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @class YandexJsonHandler
+ *  @brief fill locations from the events of the json reader
+ *  @details response.GeoObjectCollection.featureMember[] - the one element is the one location,
+ *  the fields are taken by the name of the key in any depth of the element (the first wins, as for xml)
+ */
+class YandexJsonHandler final : public utils::json::Handler
+{
+  enum class Field
   {
-    namespace pt = boost::property_tree;
-
-    std::istringstream in(buffer);
+    none,
+    text,
+    pos,
+    precision
+  };
 
-    Answer answer;
-    answer.type = Answer::GeocoderType::yandex;
+ public:
+  YandexJsonHandler(Locations &locs, const ParseOptions &options)
+   : locs_(locs)
+   , options_(options)
+  {
+  }
 
-    pt::ptree document;
-    pt::read_xml(in, document);
+  void startObject() override
+  {
+    ++depth_;
+    if (members_depth_ && depth_ == members_depth_ + 1)
+    {
+      locs_.emplace_back();
+      has_pos_ = false;
+      has_precision_ = false;
+      skip_ = false;
+    }
+    field_ = Field::none;
+  }
 
-    if (const auto ymaps = document.get_child_optional("ymaps"))
+  void endObject() override
+  {
+    if (members_depth_ && depth_ == members_depth_ + 1 && skip_)
+    {
+      // the precision is worse than the wanted one
+      locs_.pop_back();
+    }
+    else if (members_depth_ && depth_ == members_depth_ + 1)
     {
-      if (const auto geo_obj_coll = ymaps->get_child_optional("GeoObjectCollection"))
+      if (!has_pos_)
       {
-        auto r = geo_obj_coll->equal_range("featureMember");
+        throw std::runtime_error("[parseYandexJson]: is not found 'pos'");
+      }
+      if (!has_precision_)
+      {
+        throw std::runtime_error("[parseYandexJson]: is not found 'precision'");
+      }
+      if (options_.max_results != 0 && locs_.size() >= options_.max_results)
+      {
+        stop();
+      }
+    }
+    --depth_;
+    field_ = Field::none;
+  }
 
-        for (; r.first != r.second; ++r.first)
-        {
-          const auto geo_obj = r.first->second;
-          GeoData data;
-          processTree(geo_obj, data);
+  void startArray() override
+  {
+    ++depth_;
+    if (!members_depth_ && is_members_)
+    {
+      members_depth_ = depth_;
+    }
+    field_ = Field::none;
+  }
+
+  void endArray() override
+  {
+    if (members_depth_ == depth_)
+    {
+      members_depth_ = 0;
+    }
+    --depth_;
+    field_ = Field::none;
+  }
+
+  void key(const char *data, std::size_t size) override
+  {
+    is_members_ = equal(data, size, "featureMember");
+    field_ = Field::none;
+
+    if (!members_depth_ || depth_ <= members_depth_ || skip_)
+    {
+      return;
+    }
 
-          auto text_coord = data["pos"];
-          std::vector<std::string> spl_coord;
-          boost::split(spl_coord, text_coord, boost::is_any_of(" "));
+    auto &loc = locs_.back();
+    const auto text = [this, data, size](const char *name, std::string &target) {
+      if (equal(data, size, name) && options_.has(field(name)))
+      {
+        field_ = Field::text;
+        target_ = &target;
+        return true;
+      }
+      return false;
+    };
 
-          Coordinates coord;
-          coord.longitude = std::stof(spl_coord.at(0));
-          coord.latitude = std::stof(spl_coord.at(1));
+    if (equal(data, size, "pos"))
+    {
+      field_ = has_pos_ ? Field::none : Field::pos;
+    }
+    else if (equal(data, size, "precision"))
+    {
+      field_ = has_precision_ ? Field::none : Field::precision;
+    }
+    else if (text("AddressLine", loc.line) || text("CountryName", loc.country) || text("AdministrativeAreaName", loc.region) ||
+             text("SubAdministrativeAreaName", loc.district) || text("LocalityName", loc.place) ||
+             text("DependentLocalityName", loc.suburb) || text("ThoroughfareName", loc.street) || text("PremiseNumber", loc.house))
+    {
+      if (!target_->empty())
+      {
+        field_ = Field::none;
+      }
+    }
+  }
 
-          Location loc;
+  void string(const char *data, std::size_t size) override
+  {
+    switch (field_)
+    {
+      case Field::text:
+        target_->assign(data, size);
+        break;
+      case Field::pos:
+        parsePos(data, size);
+        has_pos_ = true;
+        break;
+      case Field::precision:
+        locs_.back().precision = textToPrecision(std::string(data, size));
+        has_precision_ = true;
+        skip_ = !options_.accept(locs_.back().precision);
+        break;
+      case Field::none:
+        break;
+    }
+    field_ = Field::none;
+  }
 
-          loc.line = data["AddressLine"];
+  void literal(const char *, std::size_t) override { field_ = Field::none; }
 
-          loc.country = data["CountryName"];
-          loc.region = data["AdministrativeAreaName"];
-          loc.district = data["SubAdministrativeAreaName"];
-          loc.place = data["LocalityName"];
-          loc.suburb = data["DependentLocalityName"];
-          loc.street = data["ThoroughfareName"];
-          loc.house = data["PremiseNumber"];
-          loc.coord = coord;
-          loc.precision = textToPrecision(data["precision"]);
+ private:
+  static bool equal(const char *data, std::size_t size, const char *name)
+  {
+    return size == std::strlen(name) && !std::memcmp(data, name, size);
+  }
 
-          answer.locations.push_back(std::move(loc));
-        }
+  static ParseOptions::Field field(const char *name)
+  {
+    for (const auto &i : text_fields)
+    {
+      if (!std::strcmp(i.first, name))
+      {
+        return i.second;
       }
     }
+    return ParseOptions::all;
+  }
 
-    Result result;
-    bool ret = (!answer.locations.empty()) ? true : false;
+  /** @brief "longitude latitude" */
+  void parsePos(const char *data, std::size_t size)
+  {
+    // the value is not terminated by zero
+    char buffer[64];
+    if (size >= sizeof(buffer))
+    {
+      throw std::runtime_error("[parseYandexJson]: invalid 'pos'");
+    }
+    std::memcpy(buffer, data, size);
+    buffer[size] = '\0';
 
-    return std::make_tuple(ret, answer);
+    char *end = nullptr;
+    auto &coord = locs_.back().coord;
+    coord.longitude = std::strtod(buffer, &end);
+    const char *lat = end;
+    coord.latitude = std::strtod(lat, &end);
+    if (lat == buffer || end == lat)
+    {
+      throw std::runtime_error("[parseYandexJson]: invalid 'pos'");
+    }
   }
+
+ private:
+  Locations &locs_;
+  const ParseOptions &options_;
+  std::size_t depth_{0};
+  /** @brief the depth of the array 'featureMember', 0 - outside */
+  std::size_t members_depth_{0};
+  bool is_members_{false};
+  Field field_{Field::none};
+  std::string *target_{nullptr};
+  bool has_pos_{false};
+  bool has_precision_{false};
+  /** @brief the rest of the location is skipped */
+  bool skip_{false};
 };
+}  // namespace
+//--------------------------------------------------------------------------------------------
+Locations parseYandexJson(const std::string &buffer, const ParseOptions &options)
+{
+  Locations result;
+  YandexJsonHandler handler(result, options);
+  utils::json::parse(buffer, handler);
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+class GeoYandex final : public GeocoderBase
+{
+ public:
+  explicit GeoYandex(const boost::property_tree::ptree &conf)
+   : GeocoderBase(conf)
+  {
+    // format=xml|json, results=N (0 - default of the geocoder)
+    const auto format = conf.get<std::string>("format", "xml");
+    const auto results = conf.get<std::size_t>("results", 0);
 
+    if (format != "xml" && format != "json")
+    {
+      throw std::runtime_error("[GeoYandex::GeoYandex]: unknown format '" + format + "'");
+    }
+
+    json_ = (format == "json");
+
+    std::string params;
+    if (json_)
+    {
+      params += "&format=json";
+    }
+    if (results)
+    {
+      params += "&results=" + std::to_string(results);
+    }
+    setParams(params);
+
+    auto &logger = geo_logger::get();
+    BOOST_LOG_SEV(logger, utils::logger::Severity::info) << "[GeoYandex::GeoYandex]: format '" << format << "', results '" << results << "'";
+  }
+
+ protected:
+  virtual Result parse(const std::string &buffer, const ParseOptions &options)
+  {
+    Answer answer;
+    answer.type = Answer::GeocoderType::yandex;
+    answer.locations = json_ ? parseYandexJson(buffer, options) : parseYandexXml(buffer, options);
+
+    const bool ret = !answer.locations.empty();
+
+    return std::make_tuple(ret, std::move(answer));
+  }
+
+ private:
+  bool json_{false};
+};
+//--------------------------------------------------------------------------------------------
 GeocoderPtr createYandexGeocoder(const boost::property_tree::ptree &conf)
 {
   GeocoderPtr result(new GeoYandex(conf));
@@ -0,0 +1,355 @@
+/** @file journal.cpp
+ *  @brief the implementation of the class Journal
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// declare
+#include "geo/journal.h"
+
+// std
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+// posix
+#include <unistd.h>
+
+// boost
+#include <boost/crc.hpp>
+
+// this
+#include "utils/logger/logger.h"
+
+namespace geocoder
+{
+namespace geo
+{
+namespace
+{
+const char signature[8] = {'G', 'E', 'O', 'J', 'R', 'N', 'L', '1'};
+
+/** @brief the header of the record: the size of the payload and crc32 of the payload */
+const std::size_t record_header = 8;
+
+std::uint32_t crc32(const char *data, std::size_t size)
+{
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+template <class T>
+void put(std::string &out, T value)
+{
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void putString(std::string &out, const std::string &value)
+{
+  put(out, static_cast<std::uint32_t>(value.size()));
+  out.append(value);
+}
+
+/** @brief the reader of the payload, false - the payload is broken */
+class Payload final
+{
+ public:
+  Payload(const char *data, std::size_t size)
+   : data_(data)
+   , end_(data + size)
+  {
+  }
+
+  template <class T>
+  bool get(T &value)
+  {
+    if (static_cast<std::size_t>(end_ - data_) < sizeof(value))
+    {
+      return false;
+    }
+    std::memcpy(&value, data_, sizeof(value));
+    data_ += sizeof(value);
+    return true;
+  }
+
+  bool getString(std::string &value)
+  {
+    std::uint32_t size = 0;
+    if (!get(size) || static_cast<std::size_t>(end_ - data_) < size)
+    {
+      return false;
+    }
+    value.assign(data_, size);
+    data_ += size;
+    return true;
+  }
+
+  bool end() const { return data_ == end_; }
+
+ private:
+  const char *data_;
+  const char *end_;
+};
+
+void encode(std::size_t index, const std::string &address, const Answer &answer, std::string &out)
+{
+  const auto start = out.size();
+  out.append(record_header, '\0');
+
+  put(out, static_cast<std::uint64_t>(index));
+  put(out, hashAddress(address));
+  put(out, static_cast<std::int8_t>(answer.type));
+  put(out, static_cast<std::uint32_t>(answer.locations.size()));
+  for (const auto &i : answer.locations)
+  {
+    for (const auto *s : {&i.line, &i.country, &i.region, &i.district, &i.place, &i.suburb, &i.street, &i.house})
+    {
+      putString(out, *s);
+    }
+    put(out, i.coord.latitude);
+    put(out, i.coord.longitude);
+    put(out, static_cast<std::uint8_t>(i.precision));
+  }
+
+  const auto size = static_cast<std::uint32_t>(out.size() - start - record_header);
+  const auto crc = crc32(out.data() + start + record_header, size);
+  std::memcpy(&out[start], &size, sizeof(size));
+  std::memcpy(&out[start + sizeof(size)], &crc, sizeof(crc));
+}
+
+bool decode(const char *data, std::size_t size, std::uint64_t &index, std::uint64_t &hash, Answer &answer)
+{
+  Payload payload(data, size);
+
+  std::int8_t type = 0;
+  std::uint32_t count = 0;
+  if (!payload.get(index) || !payload.get(hash) || !payload.get(type) || !payload.get(count))
+  {
+    return false;
+  }
+
+  answer.type = static_cast<Answer::GeocoderType>(type);
+  answer.locations.clear();
+  for (std::uint32_t n = 0; n < count; ++n)
+  {
+    Location loc;
+    for (auto *s : {&loc.line, &loc.country, &loc.region, &loc.district, &loc.place, &loc.suburb, &loc.street, &loc.house})
+    {
+      if (!payload.getString(*s))
+      {
+        return false;
+      }
+    }
+    std::uint8_t precision = 0;
+    if (!payload.get(loc.coord.latitude) || !payload.get(loc.coord.longitude) || !payload.get(precision))
+    {
+      return false;
+    }
+    loc.precision = static_cast<Precision>(precision);
+    answer.locations.push_back(std::move(loc));
+  }
+  return payload.end();
+}
+
+bool hasSignature(std::ifstream &fin)
+{
+  char head[sizeof(signature)];
+  return fin.read(head, sizeof(head)) && std::memcmp(head, signature, sizeof(signature)) == 0;
+}
+
+/** @brief read the records of the journal up to the first broken one
+ *  @return size of the valid part of the file, 0 - no signature
+ */
+std::uint64_t scan(const boost::filesystem::path &filename, const std::function<void(const char *, std::size_t)> &record)
+{
+  std::ifstream fin(filename.string(), std::ios::binary);
+  if (!hasSignature(fin))
+  {
+    return 0;
+  }
+
+  const auto size = boost::filesystem::file_size(filename);
+  std::uint64_t result = sizeof(signature);
+  std::string payload;
+  for (;;)
+  {
+    std::uint32_t frame[2];
+    if (!fin.read(reinterpret_cast<char *>(frame), sizeof(frame)))
+    {
+      break;
+    }
+    // the size of the torn tail is not allocated
+    if (frame[0] > size - result - record_header)
+    {
+      break;
+    }
+    payload.resize(frame[0]);
+    if (!fin.read(&payload[0], frame[0]) || crc32(payload.data(), payload.size()) != frame[1])
+    {
+      break;
+    }
+    record(payload.data(), payload.size());
+    result += record_header + frame[0];
+  }
+  return result;
+}
+}  // namespace
+
+/** @class Journal::Impl
+ *  @brief the implementation of the journal
+ */
+class Journal::Impl final
+{
+ public:
+  Impl(const boost::filesystem::path &filename, std::size_t group)
+   : filename_(filename)
+   , group_(std::max<std::size_t>(group, 1))
+  {
+    namespace fs = boost::filesystem;
+    auto &logger = geo_logger::get();
+    using utils::logger::Severity;
+
+    const auto valid = fs::exists(filename) ? scan(filename, [](const char *, std::size_t) {}) : 0;
+    if (valid == 0 && fs::exists(filename) && fs::file_size(filename) != 0)
+    {
+      throw std::runtime_error("[Journal::Journal]: '" + filename.string() + "' is not the journal");
+    }
+    if (valid == 0)
+    {
+      file_ = std::fopen(filename.string().c_str(), "wb");
+      if (file_ != nullptr && std::fwrite(signature, 1, sizeof(signature), file_) != sizeof(signature))
+      {
+        std::fclose(file_);
+        file_ = nullptr;
+      }
+    }
+    else
+    {
+      // the torn tail of the crashed run
+      if (valid < fs::file_size(filename))
+      {
+        BOOST_LOG_SEV(logger, Severity::warning) << "[Journal]: truncate '" << filename << "' " << fs::file_size(filename) << " -> " << valid;
+        fs::resize_file(filename, valid);
+      }
+      file_ = std::fopen(filename.string().c_str(), "ab");
+    }
+
+    if (file_ == nullptr)
+    {
+      throw std::runtime_error("[Journal::Journal]: failed open '" + filename.string() + "'");
+    }
+  }
+
+  ~Impl()
+  {
+    try
+    {
+      flush();
+    }
+    catch (const std::exception &err)
+    {
+      BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::error) << "[Journal]: " << err.what();
+    }
+    std::fclose(file_);
+  }
+
+  void append(std::size_t index, const std::string &address, const Answer &answer)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    encode(index, address, answer, pending_);
+    if (++count_ >= group_)
+    {
+      write();
+    }
+  }
+
+  void flush()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write();
+  }
+
+ private:
+  /** @brief the lock is held */
+  void write()
+  {
+    if (count_ == 0)
+    {
+      return;
+    }
+    if (std::fwrite(pending_.data(), 1, pending_.size(), file_) != pending_.size() || std::fflush(file_) != 0)
+    {
+      throw std::runtime_error("[Journal::flush]: failed write '" + filename_.string() + "'");
+    }
+    // the group survives the crash of the system
+    ::fdatasync(::fileno(file_));
+    pending_.clear();
+    count_ = 0;
+  }
+
+  const boost::filesystem::path filename_;
+  const std::size_t group_;
+
+  std::mutex mutex_;
+  std::FILE *file_{nullptr};
+  std::string pending_;
+  std::size_t count_{0};
+};
+//--------------------------------------------------------------------------------------------
+Journal::Journal(const boost::filesystem::path &filename, std::size_t group)
+ : impl_(new Impl(filename, group))
+{
+}
+//--------------------------------------------------------------------------------------------
+Journal::~Journal() = default;
+Journal::Journal(Journal &&) = default;
+Journal &Journal::operator=(Journal &&) = default;
+//--------------------------------------------------------------------------------------------
+void Journal::append(std::size_t index, const std::string &address, const Answer &answer) { impl_->append(index, address, answer); }
+//--------------------------------------------------------------------------------------------
+void Journal::flush() { impl_->flush(); }
+//--------------------------------------------------------------------------------------------
+std::size_t Journal::load(const boost::filesystem::path &filename, const Addresses &addrs, Answers &answers, std::vector<bool> &done)
+{
+  answers.assign(addrs.size(), Answer());
+  done.assign(addrs.size(), false);
+
+  std::size_t result = 0;
+  std::size_t ignored = 0;
+  Answer answer;
+  scan(filename, [&](const char *data, std::size_t size) {
+    std::uint64_t index = 0;
+    std::uint64_t hash = 0;
+    if (!decode(data, size, index, hash, answer) || index >= addrs.size() || hash != hashAddress(addrs[index]))
+    {
+      ++ignored;
+      return;
+    }
+    if (!done[index])
+    {
+      done[index] = true;
+      ++result;
+    }
+    answers[index] = std::move(answer);
+  });
+
+  if (ignored != 0)
+  {
+    BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::warning) << "[Journal::load]: ignored records of the other addresses " << ignored;
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+bool Journal::isJournal(const boost::filesystem::path &filename)
+{
+  std::ifstream fin(filename.string(), std::ios::binary);
+  return hasSignature(fin);
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
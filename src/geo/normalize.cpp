@@ -0,0 +1,193 @@
+/** @file normalize.cpp
+ *  @brief the implementation of the normalization of the address text
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/normalize.h"
+
+// std
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <initializer_list>
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief the types of the streets and settlements (normalized), are removed from the keys */
+const char *const stop_words[] = {"улица", "ул",  "проспект", "просп", "пр-т",  "бульвар", "б-р", "бул", "переулок",   "пер",
+                                  "шоссе", "ш",   "площадь",  "пл",    "проезд", "пр-д",    "тупик", "набережная", "наб", "город",
+                                  "г",     "дом", "д",        "поселок", "пос",  "деревня", "дер"};
+
+bool isStopWord(const char *data, std::size_t size)
+{
+  for (const auto *i : stop_words)
+  {
+    if (std::strlen(i) == size && !std::memcmp(i, data, size))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** @brief append lower case of the UTF-8 text, the separators -> ' ' */
+void lower(const std::string &text, std::string &out)
+{
+  for (std::size_t i = 0; i < text.size(); ++i)
+  {
+    const auto c = static_cast<unsigned char>(text[i]);
+
+    if (c < 0x80)
+    {
+      if (std::isalnum(c) || c == '-')
+      {
+        out.push_back(static_cast<char>(std::tolower(c)));
+      }
+      else
+      {
+        out.push_back(' ');
+      }
+    }
+    else if (c == 0xD0 && i + 1 < text.size())
+    {
+      const auto n = static_cast<unsigned char>(text[++i]);
+      if (n >= 0x90 && n <= 0x9F)
+      {
+        // А-П -> а-п
+        out.push_back(static_cast<char>(0xD0));
+        out.push_back(static_cast<char>(n + 0x20));
+      }
+      else if (n >= 0xA0 && n <= 0xAF)
+      {
+        // Р-Я -> р-я
+        out.push_back(static_cast<char>(0xD1));
+        out.push_back(static_cast<char>(n - 0x20));
+      }
+      else if (n == 0x81)
+      {
+        // Ё -> е
+        out.push_back(static_cast<char>(0xD0));
+        out.push_back(static_cast<char>(0xB5));
+      }
+      else
+      {
+        out.push_back(static_cast<char>(c));
+        out.push_back(static_cast<char>(n));
+      }
+    }
+    else if (c == 0xD1 && i + 1 < text.size() && static_cast<unsigned char>(text[i + 1]) == 0x91)
+    {
+      // ё -> е
+      ++i;
+      out.push_back(static_cast<char>(0xD0));
+      out.push_back(static_cast<char>(0xB5));
+    }
+    else
+    {
+      out.push_back(static_cast<char>(c));
+    }
+  }
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+std::string normalize(const std::string &address)
+{
+  std::string text;
+  text.reserve(address.size());
+  lower(address, text);
+
+  std::string result;
+  result.reserve(text.size());
+
+  std::size_t pos = 0;
+  while (pos < text.size())
+  {
+    const auto begin = text.find_first_not_of(' ', pos);
+    if (begin == std::string::npos)
+    {
+      break;
+    }
+
+    auto end = text.find(' ', begin);
+    if (end == std::string::npos)
+    {
+      end = text.size();
+    }
+    pos = end;
+
+    // "ул" and "ул-" as the one word, the rest hyphens are separators ("ростов-на-дону")
+    const auto size = end - begin;
+    if (isStopWord(text.data() + begin, size))
+    {
+      continue;
+    }
+
+    for (auto i = begin; i < end; ++i)
+    {
+      if (text[i] == '-')
+      {
+        if (!result.empty() && result.back() != ' ')
+        {
+          result.push_back(' ');
+        }
+      }
+      else
+      {
+        if (i == begin && !result.empty() && result.back() != ' ')
+        {
+          result.push_back(' ');
+        }
+        result.push_back(text[i]);
+      }
+    }
+  }
+
+  while (!result.empty() && result.back() == ' ')
+  {
+    result.pop_back();
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+std::vector<std::string> normalizedKeys(const Location &loc)
+{
+  const auto join = [](std::initializer_list<const std::string *> parts) {
+    std::string result;
+    for (const auto *i : parts)
+    {
+      if (!i->empty())
+      {
+        result += *i;
+        result += ' ';
+      }
+    }
+    return normalize(result);
+  };
+
+  std::vector<std::string> result;
+  const auto add = [&result](std::string key) {
+    if (!key.empty() && std::find(result.begin(), result.end(), key) == result.end())
+    {
+      result.push_back(std::move(key));
+    }
+  };
+
+  // "Москва, Москва, ..." - the region is equal the place
+  const auto &region = (loc.region == loc.place) ? std::string() : loc.region;
+
+  add(join({&loc.place, &loc.street, &loc.house}));
+  add(join({&region, &loc.place, &loc.street, &loc.house}));
+  add(join({&loc.country, &region, &loc.place, &loc.street, &loc.house}));
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -0,0 +1,121 @@
+/** @file parse_options.cpp
+ *  @brief the implementation of the options of the parse
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/parse_options.h"
+
+// std
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+
+// boost
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+std::uint32_t textToFields(const std::string &text)
+{
+  std::vector<std::string> names;
+  boost::split(names, text, boost::is_any_of(","));
+
+  std::uint32_t result = 0;
+  for (auto &i : names)
+  {
+    boost::algorithm::trim(i);
+    if (i == "all")
+    {
+      result |= ParseOptions::all;
+    }
+    else if (i == "line")
+    {
+      result |= ParseOptions::line;
+    }
+    else if (i == "country")
+    {
+      result |= ParseOptions::country;
+    }
+    else if (i == "region")
+    {
+      result |= ParseOptions::region;
+    }
+    else if (i == "district")
+    {
+      result |= ParseOptions::district;
+    }
+    else if (i == "place")
+    {
+      result |= ParseOptions::place;
+    }
+    else if (i == "suburb")
+    {
+      result |= ParseOptions::suburb;
+    }
+    else if (i == "street")
+    {
+      result |= ParseOptions::street;
+    }
+    else if (i == "house")
+    {
+      result |= ParseOptions::house;
+    }
+    else if (!i.empty())
+    {
+      throw std::runtime_error("[textToFields]: unknown field '" + i + "'");
+    }
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+ParseOptions readParseOptions(const boost::property_tree::ptree &parse)
+{
+  ParseOptions result;
+  result.max_results = parse.get<std::size_t>("max_results", result.max_results);
+  if (const auto precision = parse.get_optional<std::string>("min_precision"))
+  {
+    result.min_precision = StringToPrecision(*precision);
+  }
+  if (const auto fields = parse.get_optional<std::string>("fields"))
+  {
+    result.fields = textToFields(*fields);
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+void applyParseOptions(const ParseOptions &options, Locations &locs)
+{
+  locs.erase(std::remove_if(locs.begin(), locs.end(), [&options](const Location &loc) { return !options.accept(loc.precision); }), locs.end());
+  if (options.max_results != 0 && locs.size() > options.max_results)
+  {
+    locs.resize(options.max_results);
+  }
+
+  if (options.fields == ParseOptions::all)
+  {
+    return;
+  }
+  for (auto &i : locs)
+  {
+    const std::pair<ParseOptions::Field, std::string *> fields[] = {{ParseOptions::line, &i.line},         {ParseOptions::country, &i.country},
+                                                                   {ParseOptions::region, &i.region},     {ParseOptions::district, &i.district},
+                                                                   {ParseOptions::place, &i.place},       {ParseOptions::suburb, &i.suburb},
+                                                                   {ParseOptions::street, &i.street},     {ParseOptions::house, &i.house}};
+    for (const auto &f : fields)
+    {
+      if (!options.has(f.first))
+      {
+        f.second->clear();
+      }
+    }
+  }
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -0,0 +1,294 @@
+/** @file prefix.cpp
+ *  @brief the implementation of the class PrefixIndex
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/prefix.h"
+
+// std
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+// this
+#include "geo/normalize.h"
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+PrefixIndex::~PrefixIndex() = default;
+PrefixIndex::PrefixIndex(PrefixIndex &&) = default;
+PrefixIndex &PrefixIndex::operator=(PrefixIndex &&) = default;
+//--------------------------------------------------------------------------------------------
+class PrefixIndex::Impl final
+{
+  static constexpr std::size_t block_bits = 6;
+  static constexpr std::size_t block_size = std::size_t(1) << block_bits;
+
+  /** @brief the range of the keys [first, last] and the position of the best key of the range */
+  struct Range
+  {
+    std::size_t best;
+    std::size_t first;
+    std::size_t last;
+  };
+
+ public:
+  explicit Impl(Locations locs)
+  {
+    // merge the equal locations
+    std::vector<std::uint32_t> weights;
+    {
+      std::map<std::tuple<std::string, double, double>, std::uint32_t> unique;
+      for (auto &i : locs)
+      {
+        auto key = std::make_tuple(i.line, i.coord.latitude, i.coord.longitude);
+        const auto it = unique.find(key);
+        if (it == unique.end())
+        {
+          unique.emplace(std::move(key), static_cast<std::uint32_t>(locs_.size()));
+          locs_.push_back(std::move(i));
+          weights.push_back(1);
+        }
+        else
+        {
+          ++weights[it->second];
+        }
+      }
+    }
+
+    std::vector<std::pair<std::string, std::uint32_t>> keys;
+    for (std::uint32_t i = 0; i < locs_.size(); ++i)
+    {
+      auto current = normalizedKeys(locs_[i]);
+      current.push_back(normalize(locs_[i].street + " " + locs_[i].house));
+      for (auto &k : current)
+      {
+        if (!k.empty())
+        {
+          keys.emplace_back(std::move(k), i);
+        }
+      }
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    offsets_.reserve(keys.size() + 1);
+    ids_.reserve(keys.size());
+    weights_.reserve(keys.size());
+    offsets_.push_back(0);
+    for (const auto &i : keys)
+    {
+      text_ += i.first;
+      offsets_.push_back(text_.size());
+      ids_.push_back(i.second);
+      weights_.push_back(weights[i.second]);
+    }
+
+    build();
+  }
+
+  std::size_t size() const { return ids_.size(); }
+  std::size_t locations() const { return locs_.size(); }
+
+  Matches complete(const std::string &text, std::size_t k) const
+  {
+    Matches result;
+
+    auto prefix = normalize(text);
+    if (prefix.empty() || k == 0)
+    {
+      return result;
+    }
+    // the last word is completed
+    const auto last = static_cast<unsigned char>(text.back());
+    if (last < 0x80 && !std::isalnum(last))
+    {
+      prefix.push_back(' ');
+    }
+
+    // the keys starting with the prefix
+    std::size_t first = 0;
+    std::size_t count = size();
+    while (count > 0)
+    {
+      const auto step = count / 2;
+      if (compare(first + step, prefix) < 0)
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+    std::size_t last_key = first;
+    count = size() - first;
+    while (count > 0)
+    {
+      const auto step = count / 2;
+      if (compare(last_key + step, prefix) == 0)
+      {
+        last_key += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+    if (first == last_key)
+    {
+      return result;
+    }
+
+    // the best of the range, then the best of the both rest parts
+    const auto worse = [this](const Range &lhs, const Range &rhs) {
+      return weights_[lhs.best] < weights_[rhs.best] || (weights_[lhs.best] == weights_[rhs.best] && lhs.best > rhs.best);
+    };
+    std::priority_queue<Range, std::vector<Range>, decltype(worse)> queue(worse);
+    queue.push(Range{best(first, last_key - 1), first, last_key - 1});
+
+    std::vector<std::uint32_t> seen;
+    while (!queue.empty() && result.size() < k)
+    {
+      const auto range = queue.top();
+      queue.pop();
+
+      // the location is completed by the several keys
+      const auto id = ids_[range.best];
+      if (std::find(seen.begin(), seen.end(), id) == seen.end())
+      {
+        seen.push_back(id);
+
+        Match m;
+        m.location = &locs_[id];
+        m.key.assign(text_, offsets_[range.best], offsets_[range.best + 1] - offsets_[range.best]);
+        m.weight = weights_[range.best];
+        result.push_back(std::move(m));
+      }
+
+      if (range.best > range.first)
+      {
+        queue.push(Range{best(range.first, range.best - 1), range.first, range.best - 1});
+      }
+      if (range.best < range.last)
+      {
+        queue.push(Range{best(range.best + 1, range.last), range.best + 1, range.last});
+      }
+    }
+
+    return result;
+  }
+
+ private:
+  /** @brief compare the key with the prefix, 0 - the key is started with the prefix */
+  int compare(std::size_t key, const std::string &prefix) const
+  {
+    const auto size = offsets_[key + 1] - offsets_[key];
+    const auto ret = std::memcmp(text_.data() + offsets_[key], prefix.data(), std::min<std::size_t>(size, prefix.size()));
+    if (ret != 0)
+    {
+      return ret;
+    }
+    return (size < prefix.size()) ? -1 : 0;
+  }
+
+  /** @brief the better of the keys, the left one of the equal weights */
+  std::size_t better(std::size_t lhs, std::size_t rhs) const { return (weights_[rhs] > weights_[lhs]) ? rhs : lhs; }
+
+  std::size_t scan(std::size_t first, std::size_t last) const
+  {
+    auto result = first;
+    for (auto i = first + 1; i <= last; ++i)
+    {
+      result = better(result, i);
+    }
+    return result;
+  }
+
+  /** @brief the position of the best key of [first, last] */
+  std::size_t best(std::size_t first, std::size_t last) const
+  {
+    const auto first_block = first >> block_bits;
+    const auto last_block = last >> block_bits;
+    if (first_block == last_block)
+    {
+      return scan(first, last);
+    }
+
+    auto result = scan(first, ((first_block + 1) << block_bits) - 1);
+    if (first_block + 1 < last_block)
+    {
+      const auto from = first_block + 1;
+      const auto to = last_block - 1;
+      std::size_t level = 0;
+      while ((std::size_t(2) << level) <= to - from + 1)
+      {
+        ++level;
+      }
+      result = better(result, better(table_[level][from], table_[level][to + 1 - (std::size_t(1) << level)]));
+    }
+    return better(result, scan(last_block << block_bits, last));
+  }
+
+  /** @brief the sparse table of the best keys of the blocks: level l - the best of 2^l blocks */
+  void build()
+  {
+    const auto blocks = (size() + block_size - 1) / block_size;
+    if (blocks == 0)
+    {
+      return;
+    }
+
+    table_.emplace_back(blocks);
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+      table_[0][b] = static_cast<std::uint32_t>(scan(b << block_bits, std::min(size(), (b + 1) << block_bits) - 1));
+    }
+
+    for (std::size_t level = 1; (std::size_t(1) << level) <= blocks; ++level)
+    {
+      const auto half = std::size_t(1) << (level - 1);
+      const auto &prev = table_[level - 1];
+      std::vector<std::uint32_t> current(blocks - (std::size_t(1) << level) + 1);
+      for (std::size_t b = 0; b < current.size(); ++b)
+      {
+        current[b] = static_cast<std::uint32_t>(better(prev[b], prev[b + half]));
+      }
+      table_.push_back(std::move(current));
+    }
+  }
+
+ private:
+  Locations locs_;
+  // the sorted keys: text, offsets of the keys in the text, the locations and the weights of the keys
+  std::string text_;
+  std::vector<std::uint64_t> offsets_;
+  std::vector<std::uint32_t> ids_;
+  std::vector<std::uint32_t> weights_;
+  std::vector<std::vector<std::uint32_t>> table_;
+};
+//--------------------------------------------------------------------------------------------
+PrefixIndex::PrefixIndex(Locations locs)
+ : impl_(new Impl(std::move(locs)))
+{
+}
+//--------------------------------------------------------------------------------------------
+std::size_t PrefixIndex::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+std::size_t PrefixIndex::locations() const { return impl_->locations(); }
+//--------------------------------------------------------------------------------------------
+PrefixIndex::Matches PrefixIndex::complete(const std::string &text, std::size_t k) const { return impl_->complete(text, k); }
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -0,0 +1,281 @@
+/** @file reverse.cpp
+ *  @brief the implementation of the class ReverseIndex
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/reverse.h"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <thread>
+
+// boost
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/columnar.h"
+#include "geo/geoyandex.h"
+#include "utils/logger/logger.h"
+#include "utils/recorder.h"
+
+namespace geocoder
+{
+namespace geo
+{
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+//--------------------------------------------------------------------------------------------
+namespace
+{
+const double earth_radius = 6371008.8;
+const double deg_to_rad = M_PI / 180.0;
+
+using Point = bg::model::point<double, 3, bg::cs::cartesian>;
+using Value = std::pair<Point, std::uint32_t>;
+using Tree = bgi::rtree<Value, bgi::rstar<16>>;
+
+Point toPoint(const Coordinates &coord)
+{
+  const auto lat = coord.latitude * deg_to_rad;
+  const auto lon = coord.longitude * deg_to_rad;
+  const auto cos_lat = std::cos(lat);
+  return Point(cos_lat * std::cos(lon), cos_lat * std::sin(lon), std::sin(lat));
+}
+
+/** @brief chord on the unit sphere -> meters */
+double chordToMeters(double chord) { return 2.0 * earth_radius * std::asin(std::min(chord / 2.0, 1.0)); }
+}  // namespace
+//--------------------------------------------------------------------------------------------
+double distance(const Coordinates &lhs, const Coordinates &rhs)
+{
+  const auto dlat = (rhs.latitude - lhs.latitude) * deg_to_rad;
+  const auto dlon = (rhs.longitude - lhs.longitude) * deg_to_rad;
+  const auto a = std::pow(std::sin(dlat / 2), 2) +
+                 std::cos(lhs.latitude * deg_to_rad) * std::cos(rhs.latitude * deg_to_rad) * std::pow(std::sin(dlon / 2), 2);
+  return 2.0 * earth_radius * std::asin(std::min(std::sqrt(a), 1.0));
+}
+//--------------------------------------------------------------------------------------------
+class ReverseIndex::Impl final
+{
+ public:
+  explicit Impl(Locations locs)
+  {
+    locs_.reserve(locs.size());
+    std::vector<Value> values;
+    values.reserve(locs.size());
+
+    for (auto &i : locs)
+    {
+      if (i.coord.isValid())
+      {
+        values.emplace_back(toPoint(i.coord), static_cast<std::uint32_t>(locs_.size()));
+        locs_.push_back(std::move(i));
+      }
+    }
+
+    // the packing constructor (STR): the balanced tree on build
+    tree_ = Tree(values.begin(), values.end());
+  }
+
+  std::size_t size() const { return locs_.size(); }
+
+  Matches nearest(const Coordinates &coord, std::size_t k, double max_distance) const
+  {
+    Matches result;
+    if (!coord.isValid() || !k)
+    {
+      return result;
+    }
+
+    const auto point = toPoint(coord);
+
+    std::vector<Value> values;
+    values.reserve(k);
+    tree_.query(bgi::nearest(point, static_cast<unsigned>(k)), std::back_inserter(values));
+
+    for (const auto &i : values)
+    {
+      const auto meters = chordToMeters(bg::distance(point, i.first));
+      if (meters <= max_distance)
+      {
+        result.push_back(Match{&locs_[i.second], meters});
+      }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) { return lhs.distance < rhs.distance; });
+    return result;
+  }
+
+  Match nearestOne(const Coordinates &coord, double max_distance) const
+  {
+    Match result;
+    if (!coord.isValid())
+    {
+      return result;
+    }
+
+    const auto point = toPoint(coord);
+    // the pointer as the output iterator, without allocation
+    Value found;
+    if (tree_.query(bgi::nearest(point, 1), &found))
+    {
+      const auto meters = chordToMeters(bg::distance(point, found.first));
+      if (meters <= max_distance)
+      {
+        result.location = &locs_[found.second];
+        result.distance = meters;
+      }
+    }
+
+    return result;
+  }
+
+  Matches nearest(const std::vector<Coordinates> &points, double max_distance, std::size_t threads) const
+  {
+    Matches result(points.size());
+
+    if (!threads)
+    {
+      threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, std::max<std::size_t>(points.size() / 1024, 1));
+
+    const auto chunk = (points.size() + threads - 1) / threads;
+    std::vector<std::future<void>> futures;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+      const auto begin = t * chunk;
+      const auto end = std::min(points.size(), begin + chunk);
+      futures.push_back(std::async(std::launch::async, [this, &points, &result, begin, end, max_distance] {
+        for (auto i = begin; i < end; ++i)
+        {
+          result[i] = nearestOne(points[i], max_distance);
+        }
+      }));
+    }
+
+    for (auto &i : futures)
+    {
+      i.get();
+    }
+
+    return result;
+  }
+
+ private:
+  Locations locs_;
+  Tree tree_;
+};
+//--------------------------------------------------------------------------------------------
+ReverseIndex::ReverseIndex(Locations locs)
+ : impl_(new Impl(std::move(locs)))
+{
+}
+//--------------------------------------------------------------------------------------------
+ReverseIndex::ReverseIndex(ReverseIndex &&) = default;
+ReverseIndex &ReverseIndex::operator=(ReverseIndex &&) = default;
+ReverseIndex::~ReverseIndex() = default;
+//--------------------------------------------------------------------------------------------
+std::size_t ReverseIndex::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+ReverseIndex::Matches ReverseIndex::nearest(const Coordinates &coord, std::size_t k, double max_distance) const
+{
+  return impl_->nearest(coord, k, max_distance);
+}
+//--------------------------------------------------------------------------------------------
+ReverseIndex::Matches ReverseIndex::nearest(const std::vector<Coordinates> &points, double max_distance, std::size_t threads) const
+{
+  return impl_->nearest(points, max_distance, threads);
+}
+//--------------------------------------------------------------------------------------------
+Locations loadLocations(const boost::filesystem::path &path)
+{
+  namespace fs = boost::filesystem;
+
+  Locations result;
+
+  if (fs::is_directory(path))
+  {
+    auto &logger = geo_logger::get();
+
+    utils::Recorder recorder(utils::Recorder::Mode::replay, path);
+    recorder.forEach([&result, &logger](const std::string &url, const std::string &body, long code) {
+      if (code != 200)
+      {
+        return;
+      }
+
+      try
+      {
+        const auto first = body.find_first_not_of(" \t\r\n");
+        auto locs = (first != std::string::npos && body[first] == '{') ? parseYandexJson(body) : parseYandexXml(body);
+        std::move(locs.begin(), locs.end(), std::back_inserter(result));
+      }
+      catch (const std::exception &err)
+      {
+        BOOST_LOG_SEV(logger, utils::logger::Severity::warning)
+            << "[loadLocations]: failed parse response of '" << url << "', '" << err.what() << "'";
+      }
+    });
+  }
+  else if (isColumnarFile(path))
+  {
+    const ColumnarReader reader(path);
+    result.reserve(reader.rows());
+    for (auto &i : reader.read())
+    {
+      std::move(i.locations.begin(), i.locations.end(), std::back_inserter(result));
+    }
+  }
+  else
+  {
+    for (auto &i : readAnswers(path))
+    {
+      std::move(i.locations.begin(), i.locations.end(), std::back_inserter(result));
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+std::vector<Coordinates> readPoints(const boost::filesystem::path &filename)
+{
+  std::ifstream fin(filename.string());
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("[readPoints]: failed open filename '" + filename.string() + "'");
+  }
+
+  std::vector<Coordinates> result;
+  std::string line;
+  while (std::getline(fin, line))
+  {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+    {
+      continue;
+    }
+
+    std::replace_if(line.begin(), line.end(), [](char c) { return c == ';' || c == ','; }, ' ');
+
+    Coordinates coord;
+    if (std::sscanf(line.c_str(), "%lf %lf", &coord.latitude, &coord.longitude) != 2)
+    {
+      throw std::runtime_error("[readPoints]: invalid line '" + line + "' in '" + filename.string() + "'");
+    }
+
+    result.push_back(coord);
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
@@ -0,0 +1,732 @@
+/** @file server.cpp
+ *  @brief the implementation of the class Server
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/server.h"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <csignal>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/tabular.h"
+#include "utils/json.h"
+#include "utils/logger/logger.h"
+#include "utils/metrics.h"
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+using local = asio::local::stream_protocol;
+
+/** @brief the maximum size of the request line and the headers */
+const std::size_t max_header = 65536;
+
+/** @brief the addresses of the part of the batch, the parts are geocoded by the workers in parallel */
+const std::size_t batch_part = 32;
+
+/** @brief the geocoders of the worker thread */
+thread_local GeoPool *current_pool = nullptr;
+
+struct Response
+{
+  int code{200};
+  std::string type{"text/plain; charset=utf-8"};
+  std::string body;
+  bool close{false};
+};
+
+/** @brief the completion of the request: the response is sent by the thread of the last part of the batch */
+using Done = std::function<void(Response)>;
+
+/** @brief the batch in progress: the rows and the errors of the parts */
+struct Batch
+{
+  Addresses addrs;
+  ParseOptions parse;
+  std::vector<std::string> rows;
+  std::vector<std::string> errors;
+  std::atomic<std::size_t> remaining{0};
+  Done done;
+};
+
+Response error(int code, const std::string &text)
+{
+  Response result;
+  result.code = code;
+  result.body = text + "\n";
+  return result;
+}
+
+const char *statusText(int code)
+{
+  switch (code)
+  {
+    case 200:
+      return "OK";
+    case 400:
+      return "Bad Request";
+    case 404:
+      return "Not Found";
+    case 405:
+      return "Method Not Allowed";
+    case 413:
+      return "Payload Too Large";
+    default:
+      return "Internal Server Error";
+  }
+}
+
+int hex(char c)
+{
+  if (c >= '0' && c <= '9')
+  {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f')
+  {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F')
+  {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/** @brief the value of the parameter of the query (percent-encoding, '+' - space), empty - is not found */
+std::string queryParam(const std::string &target, const std::string &name)
+{
+  const auto query = target.find('?');
+  if (query == std::string::npos)
+  {
+    return std::string();
+  }
+
+  std::size_t begin = query + 1;
+  while (begin < target.size())
+  {
+    auto end = target.find('&', begin);
+    if (end == std::string::npos)
+    {
+      end = target.size();
+    }
+
+    if (target.compare(begin, name.size() + 1, name + "=") == 0)
+    {
+      std::string result;
+      for (auto i = begin + name.size() + 1; i < end; ++i)
+      {
+        if (target[i] == '+')
+        {
+          result += ' ';
+        }
+        else if (target[i] == '%' && i + 2 < end && hex(target[i + 1]) >= 0 && hex(target[i + 2]) >= 0)
+        {
+          result += static_cast<char>(hex(target[i + 1]) * 16 + hex(target[i + 2]));
+          i += 2;
+        }
+        else
+        {
+          result += target[i];
+        }
+      }
+      return result;
+    }
+
+    begin = end + 1;
+  }
+
+  return std::string();
+}
+
+/** @brief the json array of the strings */
+class BatchHandler final : public utils::json::Handler
+{
+ public:
+  explicit BatchHandler(Addresses &addrs)
+   : addrs_(addrs)
+  {
+  }
+
+  void startArray() override { check(++depth_ == 1); }
+  void endArray() override { --depth_; }
+  void startObject() override { check(false); }
+  void string(const char *data, std::size_t size) override
+  {
+    check(depth_ == 1);
+    addrs_.emplace_back(data, size);
+  }
+  void literal(const char *, std::size_t) override { check(false); }
+
+ private:
+  void check(bool valid)
+  {
+    if (!valid)
+    {
+      throw std::runtime_error("the batch is not the array of the strings");
+    }
+  }
+
+  Addresses &addrs_;
+  std::size_t depth_{0};
+};
+
+/** @brief the addresses of the batch: the json array of the strings or one address per line */
+Addresses parseBatch(const std::string &body)
+{
+  Addresses result;
+
+  const auto first = body.find_first_not_of(" \t\r\n");
+  if (first != std::string::npos && body[first] == '[')
+  {
+    BatchHandler handler(result);
+    utils::json::parse(body, handler);
+    return result;
+  }
+
+  std::size_t begin = 0;
+  while (begin < body.size())
+  {
+    auto end = body.find('\n', begin);
+    if (end == std::string::npos)
+    {
+      end = body.size();
+    }
+    result.emplace_back(body, begin, ((end > begin && body[end - 1] == '\r') ? end - 1 : end) - begin);
+    begin = end + 1;
+  }
+  return result;
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+class Server::Impl final
+{
+  template <class Socket>
+  class Session;
+
+ public:
+  Impl(const boost::property_tree::ptree &conf, const ServerOptions &options)
+   : conf_(conf)
+   , options_(options)
+   , signals_(io_)
+  {
+    auto &logger = geo_logger::get();
+    using utils::logger::Severity;
+
+    try
+    {
+      const std::string unix_prefix = "unix:";
+      if (options_.endpoint.compare(0, unix_prefix.size(), unix_prefix) == 0)
+      {
+        path_ = options_.endpoint.substr(unix_prefix.size());
+        // the stale socket of the previous run is replaced, the other files are kept
+        const auto type = boost::filesystem::status(path_).type();
+        if (type == boost::filesystem::socket_file)
+        {
+          boost::filesystem::remove(path_);
+        }
+        else if (type != boost::filesystem::file_not_found)
+        {
+          throw std::runtime_error("'" + path_ + "' exists and is not a socket");
+        }
+        local_.reset(new local::acceptor(io_, local::endpoint(path_)));
+        acceptLocal();
+      }
+      else
+      {
+        const auto colon = options_.endpoint.rfind(':');
+        if (colon == std::string::npos)
+        {
+          throw std::runtime_error("is not set port");
+        }
+        const auto host = options_.endpoint.substr(0, colon);
+        const auto port = static_cast<std::uint16_t>(std::stoul(options_.endpoint.substr(colon + 1)));
+        tcp_.reset(new tcp::acceptor(io_, tcp::endpoint(asio::ip::make_address(host), port)));
+        acceptTcp();
+      }
+    }
+    catch (const std::exception &err)
+    {
+      throw std::runtime_error("[Server::Impl::Impl]: failed listen '" + options_.endpoint + "', " + err.what());
+    }
+
+    requests_ = &utils::metrics::counter("server.requests");
+    addresses_ = &utils::metrics::counter("server.addresses");
+    errors_ = &utils::metrics::counter("server.errors");
+
+    BOOST_LOG_SEV(logger, Severity::info) << "[Server::Impl::Impl]: listen '" << options_.endpoint << "', port " << port() << ", threads "
+                                          << options_.threads;
+  }
+
+  ~Impl()
+  {
+    if (!path_.empty())
+    {
+      boost::system::error_code ignore;
+      boost::filesystem::remove(path_, ignore);
+    }
+  }
+
+  void run()
+  {
+    if (options_.signals)
+    {
+      signals_.add(SIGINT);
+      signals_.add(SIGTERM);
+      signals_.async_wait([this](const boost::system::error_code &ec, int signal) {
+        if (!ec)
+        {
+          BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::info) << "[Server::Impl::run]: signal " << signal << ", stop";
+          stop();
+        }
+      });
+    }
+
+    // the warm geocoders (connections, caches) live while the server runs
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < std::max<std::size_t>(options_.threads, 1); ++i)
+    {
+      threads.emplace_back([this] {
+        try
+        {
+          GeoPool pool(conf_);
+          current_pool = &pool;
+          const auto period = pool.keepAlivePeriod();
+          if (period.count() == 0)
+          {
+            io_.run();
+          }
+          else
+          {
+            // the connections of the idle worker are kept warm
+            while (!io_.stopped())
+            {
+              io_.run_for(period);
+              if (!io_.stopped())
+              {
+                pool.keepAlive();
+              }
+            }
+          }
+          current_pool = nullptr;
+        }
+        catch (const std::exception &err)
+        {
+          BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::fatal) << "[Server::Impl::run]: " << err.what();
+          stop();
+        }
+      });
+    }
+
+    for (auto &i : threads)
+    {
+      i.join();
+    }
+  }
+
+  void stop() { io_.stop(); }
+
+  std::uint16_t port() const { return tcp_ ? tcp_->local_endpoint().port() : 0; }
+
+  std::size_t maxBody() const { return options_.max_body; }
+
+  /** @brief the response is passed to 'done' (by the current thread or by the worker of the last part of the batch) */
+  void handle(const std::string &method, const std::string &target, const std::string &body, Done done)
+  {
+    requests_->add();
+
+    auto finish = [this, method, target, done](Response result) {
+      if (result.code != 200)
+      {
+        errors_->add();
+      }
+
+      BOOST_LOG_SEV(geo_logger::get(), utils::logger::Severity::debug)
+          << "[Server::Impl::handle]: " << method << " '" << target << "' " << result.code << ", " << result.body.size() << " bytes";
+      done(std::move(result));
+    };
+
+    auto batch = std::make_shared<Batch>();
+    auto result = route(method, target, body, *batch);
+    if (result.code != 200 || batch->addrs.empty())
+    {
+      finish(std::move(result));
+      return;
+    }
+
+    // the parts are queued to the workers: the batch does not hold the worker, the idle ones help
+    const auto parts = (batch->addrs.size() + batch_part - 1) / batch_part;
+    batch->rows.resize(parts);
+    batch->errors.resize(parts);
+    batch->remaining = parts;
+    batch->done = std::move(finish);
+    for (std::size_t i = 0; i < parts; ++i)
+    {
+      asio::post(io_, [this, batch, i] { geocode(*batch, i); });
+    }
+  }
+
+ private:
+  /** @brief the addresses and the options of /geocode are set to the batch, the response - the error or the other paths */
+  Response route(const std::string &method, const std::string &target, const std::string &body, Batch &batch)
+  {
+    const auto path = target.substr(0, target.find('?'));
+
+    if (path == "/health" || path == "/metrics")
+    {
+      if (method != "GET")
+      {
+        return error(405, "method '" + method + "' is not allowed");
+      }
+
+      Response result;
+      if (path == "/health")
+      {
+        result.body = "ok\n";
+      }
+      else
+      {
+        std::ostringstream out;
+        utils::metrics::print(out, utils::metrics::snapshot());
+        result.body = out.str();
+      }
+      return result;
+    }
+    else if (path != "/geocode")
+    {
+      return error(404, "unknown path '" + path + "'");
+    }
+
+    auto &addrs = batch.addrs;
+    if (method == "GET")
+    {
+      addrs.push_back(queryParam(target, "address"));
+      if (addrs.front().empty())
+      {
+        return error(400, "is not set parameter 'address'");
+      }
+    }
+    else if (method == "POST")
+    {
+      try
+      {
+        addrs = parseBatch(body);
+      }
+      catch (const std::exception &err)
+      {
+        return error(400, std::string("invalid batch, ") + err.what());
+      }
+      if (addrs.size() > options_.max_batch)
+      {
+        return error(413, "the batch is larger than " + std::to_string(options_.max_batch) + " addresses");
+      }
+    }
+    else
+    {
+      return error(405, "method '" + method + "' is not allowed");
+    }
+
+    // the locations of the answer: results=N, precision=exact|number|..., fields=line,street,house
+    auto &parse = batch.parse;
+    parse = current_pool->parseOptions();
+    try
+    {
+      const auto results = queryParam(target, "results");
+      if (!results.empty())
+      {
+        parse.max_results = std::stoul(results);
+      }
+      const auto precision = queryParam(target, "precision");
+      if (!precision.empty())
+      {
+        parse.min_precision = StringToPrecision(precision);
+      }
+      const auto fields = queryParam(target, "fields");
+      if (!fields.empty())
+      {
+        parse.fields = textToFields(fields);
+      }
+    }
+    catch (const std::exception &err)
+    {
+      return error(400, std::string("invalid parameter, ") + err.what());
+    }
+
+    Response result;
+    result.type = "application/x-ndjson; charset=utf-8";
+    return result;
+  }
+
+  /** @brief the part of the batch by the geocoders of the worker, the last part joins the rows and sends the response */
+  void geocode(Batch &batch, std::size_t part)
+  {
+    const auto begin = part * batch_part;
+    const auto end = std::min(begin + batch_part, batch.addrs.size());
+    try
+    {
+      for (auto i = begin; i < end; ++i)
+      {
+        appendRows(TabularFormat::jsonl, i + 1, current_pool->geocode(batch.addrs[i], batch.parse), batch.rows[part]);
+      }
+    }
+    catch (const std::exception &err)
+    {
+      batch.errors[part] = err.what();
+    }
+
+    if (--batch.remaining != 0)
+    {
+      return;
+    }
+
+    Response result;
+    result.type = "application/x-ndjson; charset=utf-8";
+    for (std::size_t i = 0; i < batch.rows.size(); ++i)
+    {
+      if (!batch.errors[i].empty())
+      {
+        batch.done(error(500, batch.errors[i]));
+        return;
+      }
+      result.body += batch.rows[i];
+    }
+    addresses_->add(batch.addrs.size());
+    batch.done(std::move(result));
+  }
+
+  void acceptTcp();
+  void acceptLocal();
+
+ private:
+  const boost::property_tree::ptree conf_;
+  const ServerOptions options_;
+
+  asio::io_context io_;
+  asio::signal_set signals_;
+  std::unique_ptr<tcp::acceptor> tcp_;
+  std::unique_ptr<local::acceptor> local_;
+  std::string path_;
+
+  utils::metrics::Counter *requests_{nullptr};
+  utils::metrics::Counter *addresses_{nullptr};
+  utils::metrics::Counter *errors_{nullptr};
+};
+//--------------------------------------------------------------------------------------------
+/** @class Session
+ *  @brief one client connection (keep-alive), the request is handled by the worker thread of the connection
+ */
+template <class Socket>
+class Server::Impl::Session final : public std::enable_shared_from_this<Session<Socket>>
+{
+ public:
+  Session(Socket socket, Impl &server)
+   : socket_(std::move(socket))
+   , buffer_(max_header + server.maxBody())
+   , server_(server)
+  {
+  }
+
+  void start() { read(); }
+
+ private:
+  void read()
+  {
+    auto self = this->shared_from_this();
+    asio::async_read_until(socket_, buffer_, "\r\n\r\n", [this, self](const boost::system::error_code &ec, std::size_t n) {
+      if (!ec)
+      {
+        header(n);
+      }
+    });
+  }
+
+  void header(std::size_t n)
+  {
+    std::string text(asio::buffers_begin(buffer_.data()), asio::buffers_begin(buffer_.data()) + n);
+    buffer_.consume(n);
+
+    std::istringstream in(text);
+    std::string version;
+    in >> method_ >> target_ >> version;
+    if (method_.empty() || target_.empty() || version.compare(0, 5, "HTTP/") != 0)
+    {
+      auto response = error(400, "invalid request line");
+      response.close = true;
+      write(std::move(response));
+      return;
+    }
+
+    keep_alive_ = (version != "HTTP/1.0");
+    std::size_t length = 0;
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line) && line != "\r")
+    {
+      const auto colon = line.find(':');
+      if (colon == std::string::npos)
+      {
+        continue;
+      }
+
+      auto name = line.substr(0, colon);
+      auto value = line.substr(colon + 1);
+      std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+      std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+      if (name == "content-length")
+      {
+        length = std::strtoull(value.c_str(), nullptr, 10);
+      }
+      else if (name == "connection")
+      {
+        keep_alive_ = (value.find("close") == std::string::npos) && (keep_alive_ || value.find("keep-alive") != std::string::npos);
+      }
+    }
+
+    if (length > server_.maxBody())
+    {
+      auto response = error(413, "the body is larger than " + std::to_string(server_.maxBody()) + " bytes");
+      response.close = true;
+      write(std::move(response));
+      return;
+    }
+
+    if (buffer_.size() >= length)
+    {
+      body(length);
+      return;
+    }
+
+    auto self = this->shared_from_this();
+    asio::async_read(socket_, buffer_, asio::transfer_exactly(length - buffer_.size()),
+                     [this, self, length](const boost::system::error_code &ec, std::size_t) {
+                       if (!ec)
+                       {
+                         body(length);
+                       }
+                     });
+  }
+
+  void body(std::size_t length)
+  {
+    const std::string text(asio::buffers_begin(buffer_.data()), asio::buffers_begin(buffer_.data()) + length);
+    buffer_.consume(length);
+
+    auto self = this->shared_from_this();
+    try
+    {
+      server_.handle(method_, target_, text, [this, self](Response response) { write(std::move(response)); });
+    }
+    catch (const std::exception &err)
+    {
+      write(error(500, err.what()));
+    }
+  }
+
+  void write(Response response)
+  {
+    if (response.close)
+    {
+      keep_alive_ = false;
+    }
+
+    header_ = "HTTP/1.1 " + std::to_string(response.code) + " " + statusText(response.code) + "\r\nContent-Type: " + response.type +
+              "\r\nContent-Length: " + std::to_string(response.body.size()) + "\r\nConnection: " + (keep_alive_ ? "keep-alive" : "close") +
+              "\r\n\r\n";
+    body_ = std::move(response.body);
+
+    auto self = this->shared_from_this();
+    const std::vector<asio::const_buffer> buffers = {asio::buffer(header_), asio::buffer(body_)};
+    asio::async_write(socket_, buffers, [this, self](const boost::system::error_code &ec, std::size_t) {
+      if (!ec && keep_alive_)
+      {
+        read();
+        return;
+      }
+
+      boost::system::error_code ignore;
+      socket_.shutdown(Socket::shutdown_both, ignore);
+      socket_.close(ignore);
+    });
+  }
+
+ private:
+  Socket socket_;
+  asio::streambuf buffer_;
+  Impl &server_;
+
+  std::string method_;
+  std::string target_;
+  bool keep_alive_{true};
+  std::string header_;
+  std::string body_;
+};
+//--------------------------------------------------------------------------------------------
+void Server::Impl::acceptTcp()
+{
+  tcp_->async_accept([this](const boost::system::error_code &ec, tcp::socket socket) {
+    if (ec == asio::error::operation_aborted)
+    {
+      return;
+    }
+    if (!ec)
+    {
+      socket.set_option(tcp::no_delay(true));
+      std::make_shared<Session<tcp::socket>>(std::move(socket), *this)->start();
+    }
+    acceptTcp();
+  });
+}
+//--------------------------------------------------------------------------------------------
+void Server::Impl::acceptLocal()
+{
+  local_->async_accept([this](const boost::system::error_code &ec, local::socket socket) {
+    if (ec == asio::error::operation_aborted)
+    {
+      return;
+    }
+    if (!ec)
+    {
+      std::make_shared<Session<local::socket>>(std::move(socket), *this)->start();
+    }
+    acceptLocal();
+  });
+}
+//--------------------------------------------------------------------------------------------
+Server::Server(const boost::property_tree::ptree &conf, const ServerOptions &options)
+ : impl_(new Impl(conf, options))
+{
+}
+//--------------------------------------------------------------------------------------------
+Server::~Server() = default;
+//--------------------------------------------------------------------------------------------
+void Server::run() { impl_->run(); }
+//--------------------------------------------------------------------------------------------
+void Server::stop() { impl_->stop(); }
+//--------------------------------------------------------------------------------------------
+std::uint16_t Server::port() const { return impl_->port(); }
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
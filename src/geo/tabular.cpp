@@ -0,0 +1,491 @@
+/** @file tabular.cpp
+ *  @brief the implementation of the machine readable output: CSV and JSON Lines
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "geo/tabular.h"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace geocoder
+{
+namespace geo
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief count of the answers formatted by the thread at once */
+const std::size_t block_size = 8192;
+
+const char *const csv_header = "id,type,line,country,region,district,place,suburb,street,house,latitude,longitude,precision\n";
+
+/** @brief the size of the buffers of the files of the merge */
+const std::size_t stream_buffer = 1 << 20;
+
+void appendNumber(std::size_t value, std::string &out)
+{
+  char buf[24];
+  auto *end = buf + sizeof(buf);
+  auto *begin = end;
+  do
+  {
+    *--begin = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value);
+  out.append(begin, end);
+}
+
+/** @brief the field is quoted only if it contains the separator, the quote or the end of line */
+void appendCsv(const std::string &value, std::string &out)
+{
+  if (value.find_first_of(",\"\r\n") == std::string::npos)
+  {
+    out += value;
+    return;
+  }
+
+  out += '"';
+  std::size_t begin = 0;
+  for (auto quote = value.find('"'); quote != std::string::npos; quote = value.find('"', begin))
+  {
+    out.append(value, begin, quote - begin + 1);
+    out += '"';
+    begin = quote + 1;
+  }
+  out.append(value, begin, std::string::npos);
+  out += '"';
+}
+
+/** @brief the json string, UTF-8 as is, the control characters are escaped */
+void appendJson(const std::string &value, std::string &out)
+{
+  static const char hex[] = "0123456789abcdef";
+
+  out += '"';
+  std::size_t begin = 0;
+  for (std::size_t i = 0; i < value.size(); ++i)
+  {
+    const auto c = static_cast<unsigned char>(value[i]);
+    if (c >= 0x20 && c != '"' && c != '\\')
+    {
+      continue;
+    }
+
+    out.append(value, begin, i - begin);
+    begin = i + 1;
+    switch (c)
+    {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        out += "\\u00";
+        out += hex[c >> 4];
+        out += hex[c & 0x0F];
+    }
+  }
+  out.append(value, begin, std::string::npos);
+  out += '"';
+}
+
+void appendCsvRow(std::size_t id, const std::string &type, const Location &loc, std::string &out)
+{
+  appendNumber(id, out);
+  out += ',';
+  out += type;
+  for (const auto *i : {&loc.line, &loc.country, &loc.region, &loc.district, &loc.place, &loc.suburb, &loc.street, &loc.house})
+  {
+    out += ',';
+    appendCsv(*i, out);
+  }
+  out += ',';
+  appendDouble(loc.coord.latitude, out);
+  out += ',';
+  appendDouble(loc.coord.longitude, out);
+  out += ',';
+  out += PrecisionToString(loc.precision);
+  out += '\n';
+}
+
+void appendJsonRow(std::size_t id, const std::string &type, const Location &loc, std::string &out)
+{
+  // the non finite coordinates are not valid json numbers
+  const auto coordinate = [&out](double value) {
+    if (std::isfinite(value))
+    {
+      appendDouble(value, out);
+    }
+    else
+    {
+      out += "null";
+    }
+  };
+
+  out += "{\"id\":";
+  appendNumber(id, out);
+  out += ",\"type\":\"";
+  out += type;
+  out += "\",\"line\":";
+  appendJson(loc.line, out);
+  out += ",\"country\":";
+  appendJson(loc.country, out);
+  out += ",\"region\":";
+  appendJson(loc.region, out);
+  out += ",\"district\":";
+  appendJson(loc.district, out);
+  out += ",\"place\":";
+  appendJson(loc.place, out);
+  out += ",\"suburb\":";
+  appendJson(loc.suburb, out);
+  out += ",\"street\":";
+  appendJson(loc.street, out);
+  out += ",\"house\":";
+  appendJson(loc.house, out);
+  out += ",\"latitude\":";
+  coordinate(loc.coord.latitude);
+  out += ",\"longitude\":";
+  coordinate(loc.coord.longitude);
+  out += ",\"precision\":\"";
+  out += PrecisionToString(loc.precision);
+  out += "\"}\n";
+}
+/** @class ShardReader
+ *  @brief the rows of the output of the shard (csv or jsonl) with the ids
+ */
+class ShardReader final
+{
+ public:
+  explicit ShardReader(const boost::filesystem::path &filename)
+   : filename_(filename)
+   , buffer_(stream_buffer)
+  {
+    fin_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    fin_.open(filename.string(), std::ios::binary);
+    if (!fin_.is_open())
+    {
+      throw std::runtime_error("[mergeTabular]: failed open filename '" + filename.string() + "'");
+    }
+
+    // csv has the header, jsonl has not: the first line is compared before the joining of the quoted fields
+    const std::string header(csv_header, std::strlen(csv_header) - 1);
+    empty_ = !std::getline(fin_, row_);
+    if (!empty_ && row_ != header)
+    {
+      format_ = TabularFormat::jsonl;
+      pending_ = true;
+    }
+  }
+
+  TabularFormat format() const { return format_; }
+  /** @brief the file has no lines: the format is unknown, the shard matches any one */
+  bool empty() const { return empty_; }
+  std::size_t id() const { return id_; }
+  const std::string &row() const { return row_; }
+
+  /** @brief the next row, false - the end of file */
+  bool next()
+  {
+    if (!pending_ && !read())
+    {
+      return false;
+    }
+    pending_ = false;
+
+    const auto prev = id_;
+    const char *begin = row_.c_str();
+    if (format_ == TabularFormat::jsonl)
+    {
+      const auto pos = row_.find("\"id\":");
+      begin = (pos == std::string::npos) ? nullptr : begin + pos + 5;
+    }
+
+    char *end = nullptr;
+    id_ = begin ? std::strtoull(begin, &end, 10) : 0;
+    if (begin == nullptr || end == begin || id_ == 0)
+    {
+      throw std::runtime_error("[mergeTabular]: is not found the id of the row '" + row_ + "' in '" + filename_.string() + "'");
+    }
+    if (id_ < prev)
+    {
+      throw std::runtime_error("[mergeTabular]: the ids are not ascending in '" + filename_.string() + "'");
+    }
+    return true;
+  }
+
+ private:
+  /** @brief the record: csv quoted field may contain the end of line */
+  bool read()
+  {
+    if (!std::getline(fin_, row_))
+    {
+      return false;
+    }
+    if (format_ == TabularFormat::csv)
+    {
+      std::string line;
+      while (std::count(row_.begin(), row_.end(), '"') % 2 != 0 && std::getline(fin_, line))
+      {
+        row_ += '\n';
+        row_ += line;
+      }
+    }
+    return true;
+  }
+
+  const boost::filesystem::path filename_;
+  std::vector<char> buffer_;
+  std::ifstream fin_;
+  TabularFormat format_{TabularFormat::csv};
+  std::string row_;
+  std::size_t id_{0};
+  bool pending_{false};
+  bool empty_{true};
+};
+}  // namespace
+//--------------------------------------------------------------------------------------------
+void appendDouble(double value, std::string &out)
+{
+  if (!std::isfinite(value))
+  {
+    return;
+  }
+
+  // the fixed point: the least count of the decimals k that n / 10^k is the value, n < 10^15.
+  // The division of the exact integers is rounded as strtod, so the check is the round trip without the parsing
+  static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  const auto magnitude = std::fabs(value);
+  for (std::size_t k = 0; k < sizeof(powers) / sizeof(powers[0]); ++k)
+  {
+    const auto scaled = std::floor(magnitude * powers[k] + 0.5);
+    if (scaled >= 1e15)
+    {
+      break;
+    }
+    if (scaled / powers[k] != magnitude)
+    {
+      continue;
+    }
+
+    char buf[24];
+    auto *end = buf + sizeof(buf);
+    auto *begin = end;
+    auto n = static_cast<std::uint64_t>(scaled);
+    for (std::size_t i = 0; i < k; ++i)
+    {
+      *--begin = static_cast<char>('0' + n % 10);
+      n /= 10;
+    }
+    if (k)
+    {
+      *--begin = '.';
+    }
+    do
+    {
+      *--begin = static_cast<char>('0' + n % 10);
+      n /= 10;
+    } while (n);
+    if (std::signbit(value))
+    {
+      *--begin = '-';
+    }
+    out.append(begin, end);
+    return;
+  }
+
+  // the round trip of the 15 digits is the shortest (trailing zeros are dropped by %g),
+  // else the 16 digits if it is read back, else 17 digits always are
+  char buf[32];
+  for (int precision = 15;; ++precision)
+  {
+    const auto size = std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+    if (precision == 17 || std::strtod(buf, nullptr) == value)
+    {
+      out.append(buf, static_cast<std::size_t>(size));
+      return;
+    }
+  }
+}
+//--------------------------------------------------------------------------------------------
+void appendHeader(TabularFormat format, std::string &out)
+{
+  if (format == TabularFormat::csv)
+  {
+    out += csv_header;
+  }
+}
+//--------------------------------------------------------------------------------------------
+void appendRows(TabularFormat format, std::size_t id, const Answer &answer, std::string &out)
+{
+  const auto type = Answer::GeoTypeToText(answer.type);
+  for (const auto &i : answer.locations)
+  {
+    if (format == TabularFormat::csv)
+    {
+      appendCsvRow(id, type, i, out);
+    }
+    else
+    {
+      appendJsonRow(id, type, i, out);
+    }
+  }
+}
+//--------------------------------------------------------------------------------------------
+void printTabular(const boost::filesystem::path &filename, const Answers &answers, TabularFormat format, std::size_t threads,
+                  const std::vector<std::size_t> &ids)
+{
+  std::ofstream fout(filename.string(), std::ios::binary | std::ios::trunc);
+
+  if (!fout.is_open())
+  {
+    throw std::runtime_error("[printTabular]: failed open filename '" + filename.string() + "'");
+  }
+
+  if (!ids.empty() && ids.size() != answers.size())
+  {
+    throw std::runtime_error("[printTabular]: count of the ids differs from count of the answers");
+  }
+
+  if (!threads)
+  {
+    threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  threads = std::min(threads, std::max<std::size_t>((answers.size() + block_size - 1) / block_size, 1));
+
+  // the buffers of the threads are reused by the blocks
+  std::vector<std::string> buffers(threads);
+  appendHeader(format, buffers.front());
+
+  const auto format_block = [&answers, &ids, format](std::size_t begin, std::size_t end, std::string &out) {
+    for (auto i = begin; i < end; ++i)
+    {
+      appendRows(format, ids.empty() ? i + 1 : ids[i], answers[i], out);
+    }
+  };
+
+  for (std::size_t begin = 0; begin < answers.size() || !buffers.front().empty();)
+  {
+    std::vector<std::future<void>> futures;
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+      const auto first = std::min(answers.size(), begin + t * block_size);
+      const auto last = std::min(answers.size(), first + block_size);
+      futures.push_back(std::async(std::launch::async, format_block, first, last, std::ref(buffers[t])));
+    }
+    format_block(begin, std::min(answers.size(), begin + block_size), buffers.front());
+
+    for (auto &i : futures)
+    {
+      i.get();
+    }
+
+    for (auto &i : buffers)
+    {
+      fout.write(i.data(), static_cast<std::streamsize>(i.size()));
+      i.clear();
+    }
+    begin = std::min(answers.size(), begin + threads * block_size);
+  }
+
+  if (!fout)
+  {
+    throw std::runtime_error("[printTabular]: failed write filename '" + filename.string() + "'");
+  }
+}
+//--------------------------------------------------------------------------------------------
+void mergeTabular(const std::vector<boost::filesystem::path> &inputs, const boost::filesystem::path &output)
+{
+  std::vector<std::unique_ptr<ShardReader>> readers;
+  const ShardReader *first = nullptr;
+  for (const auto &i : inputs)
+  {
+    readers.emplace_back(new ShardReader(i));
+    if (readers.back()->empty())
+    {
+      continue;
+    }
+    if (first == nullptr)
+    {
+      first = readers.back().get();
+    }
+    else if (readers.back()->format() != first->format())
+    {
+      throw std::runtime_error("[mergeTabular]: the format of '" + i.string() + "' differs from the previous shards");
+    }
+  }
+
+  std::ofstream fout;
+  std::vector<char> buffer(stream_buffer);
+  fout.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  fout.open(output.string(), std::ios::binary | std::ios::trunc);
+  if (!fout.is_open())
+  {
+    throw std::runtime_error("[mergeTabular]: failed open filename '" + output.string() + "'");
+  }
+
+  if (first != nullptr && first->format() == TabularFormat::csv)
+  {
+    fout << csv_header;
+  }
+
+  // the min heap of the current rows by the id, the rows of the answer are in the same shard
+  using Head = std::pair<std::size_t, std::size_t>;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+  for (std::size_t i = 0; i < readers.size(); ++i)
+  {
+    if (readers[i]->next())
+    {
+      heap.emplace(readers[i]->id(), i);
+    }
+  }
+
+  while (!heap.empty())
+  {
+    const auto i = heap.top().second;
+    heap.pop();
+
+    const auto &row = readers[i]->row();
+    fout.write(row.data(), static_cast<std::streamsize>(row.size()));
+    fout.put('\n');
+
+    if (readers[i]->next())
+    {
+      heap.emplace(readers[i]->id(), i);
+    }
+  }
+
+  fout.flush();
+  if (!fout)
+  {
+    throw std::runtime_error("[mergeTabular]: failed write filename '" + output.string() + "'");
+  }
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace geo
+}  // namespace geocoder
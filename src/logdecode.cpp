@@ -0,0 +1,88 @@
+/** @file logdecode.cpp
+ *  @brief the entry point of the decoder of the binary log
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/program_options.hpp>
+
+// this
+#include "GeocoderVersion.h"
+#include "utils/logger/binary.h"
+
+int main(int argc, char *argv[])
+{
+  namespace bp = boost::program_options;
+
+  std::vector<std::string> inputs;
+  std::string output;
+
+  bp::options_description option_desc("Allowed options");
+  option_desc.add_options()("help,h", "Display the program usage and exit")("version,v", "Display the program version and exit")(
+      "input,i", bp::value<std::vector<std::string>>(&inputs), "Binary log file (required)")("output,o", bp::value<std::string>(&output),
+                                                                                               "Output text file (optional, default stdout)");
+
+  bp::positional_options_description positional;
+  positional.add("input", -1);
+
+  try
+  {
+    bp::variables_map vm;
+    bp::store(bp::command_line_parser(argc, argv).options(option_desc).positional(positional).run(), vm);
+    if (vm.count("help"))
+    {
+      std::cerr << option_desc << std::endl;
+      return 0;
+    }
+    else if (vm.count("version"))
+    {
+      std::cout << geocoder::version::getText() << std::endl;
+      return 0;
+    }
+
+    bp::notify(vm);
+
+    if (inputs.empty())
+    {
+      std::cerr << option_desc << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::ofstream fout;
+    if (!output.empty())
+    {
+      fout.open(output);
+      if (!fout.is_open())
+      {
+        throw std::runtime_error("failed open file '" + output + "'");
+      }
+    }
+
+    std::ostream &out = output.empty() ? std::cout : fout;
+
+    for (const auto &i : inputs)
+    {
+      std::ifstream fin(i, std::ios::binary);
+      if (!fin.is_open())
+      {
+        throw std::runtime_error("failed open file '" + i + "'");
+      }
+
+      geocoder::utils::logger::binary::decode(fin, out);
+    }
+  }
+  catch (const std::exception &err)
+  {
+    std::cerr << err.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
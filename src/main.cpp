@@ -5,10 +5,14 @@
  */
 
 // std
-#include <fstream>
-#include <future>
 #include <iostream>
-#include <map>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// posix
+#include <unistd.h>
 
 // boost
 #include <boost/filesystem.hpp>
@@ -17,141 +21,200 @@
 
 // this
 #include "GeocoderVersion.h"
-#include "geo/geopool.h"
+#include "geo/batch.h"
+#include "geo/columnar.h"
+#include "geo/journal.h"
+#include "geo/prefix.h"
+#include "geo/reverse.h"
+#include "geo/server.h"
+#include "geo/tabular.h"
+#include "utils/logger/binary.h"
 #include "utils/logger/logger.h"
+#include "utils/metrics.h"
 #include "utils/parse_cmd.h"
 #include "utils/utils.h"
 
-using Answers = std::vector<geocoder::geo::Answer>;
-using Addresses = std::vector<std::string>;
-
-Addresses readFromFile(const boost::filesystem::path &filename)
+namespace
 {
-  std::ifstream fin{filename.string()};
-
-  std::string line;
-  Addresses result;
-
-  while (std::getline(fin, line))
+/** @brief write answers in the format of the command line
+ *  @param ids - the ids of the answers of the shard (csv, jsonl), empty - the number of the answer
+ */
+void print(const geocoder::utils::CmdOptions &options, const boost::filesystem::path &output, const geocoder::geo::Answers &answers,
+           const std::vector<std::size_t> &ids = std::vector<std::size_t>())
+{
+  if (options.format == "columnar")
+  {
+    geocoder::geo::printColumnar(output, answers);
+  }
+  else if (options.format == "csv")
+  {
+    geocoder::geo::printTabular(output, answers, geocoder::geo::TabularFormat::csv, 0, ids);
+  }
+  else if (options.format == "jsonl")
   {
-    result.emplace_back(line);
+    geocoder::geo::printTabular(output, answers, geocoder::geo::TabularFormat::jsonl, 0, ids);
+  }
+  else
+  {
+    geocoder::geo::print(output, answers);
   }
-  return result;
 }
 
-Answers geocode(const Addresses &addrs, const boost::property_tree::ptree &conf)
+/** @brief reverse geocoding of the points by the local index, without network */
+void reverse(const geocoder::utils::CmdOptions &options, const boost::filesystem::path &output)
 {
+  namespace geo = geocoder::geo;
+
   auto &logger = geo_logger::get();
   using geocoder::utils::logger::Severity;
 
-  BOOST_LOG_SEV(logger, Severity::info) << "[geocode]: Start geocoding.";
+  BOOST_LOG_SEV(logger, Severity::info) << "[reverse]: points '" << options.reverse << "', index '" << options.index << "'";
 
-  const auto maxthreads = (addrs.size() > 1) ? static_cast<std::size_t>(2) : static_cast<std::size_t>(1);
-  const auto addr_per_thread = std::ceil(static_cast<float>(addrs.size()) / static_cast<float>(maxthreads));
+  const geo::ReverseIndex index(geo::loadLocations(options.index));
+  BOOST_LOG_SEV(logger, Severity::info) << "[reverse]: index size " << index.size();
 
-  auto start_it = std::cbegin(addrs);
+  const auto points = geo::readPoints(options.reverse);
+  const auto max_distance = (options.max_distance > 0.0) ? options.max_distance : std::numeric_limits<double>::infinity();
 
-  Answers result;
-  std::vector<std::future<Answers>> futures;
-
-  for (std::size_t i = 0; i < maxthreads; ++i)
+  geo::Answers answers;
+  answers.reserve(points.size());
+  for (const auto &i : index.nearest(points, max_distance))
   {
-    const auto dist = std::distance(start_it, std::cend(addrs));
-    if (dist <= 0)
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::local;
+    if (i.location)
     {
-      break;
+      answer.locations.push_back(*i.location);
     }
+    answers.push_back(std::move(answer));
+  }
 
-    const auto count_addrs = (dist > addr_per_thread) ? addr_per_thread : dist;
-    auto begin_it = start_it;
-    std::advance(start_it, count_addrs);
+  print(options, output, answers);
+}
 
-    Addresses tmp{begin_it, start_it};
+/** @brief autocomplete of the partial addresses by the local index, without network */
+void complete(const geocoder::utils::CmdOptions &options, const boost::filesystem::path &output)
+{
+  namespace geo = geocoder::geo;
 
-    auto fut = std::async(std::launch::async, [tmp = std::move(tmp), conf] {
-      auto &logger = geo_logger::get();
-      geocoder::geo::GeoPool pool(conf);
-      Answers answers;
-      for (const auto &i : tmp)
-      {
-        try
-        {
-          auto answer = pool.geocode(i);
-          answers.push_back(answer);
-        }
-        catch (const std::exception &err)
-        {
-          BOOST_LOG_SEV(logger, Severity::error) << "[geocode] Failed geocode '" << i << "'";
-        }
-      }
+  auto &logger = geo_logger::get();
+  using geocoder::utils::logger::Severity;
 
-      return answers;
-    });
+  BOOST_LOG_SEV(logger, Severity::info) << "[complete]: partial addresses '" << options.complete << "', index '" << options.index << "'";
 
-    futures.push_back(std::move(fut));
-  }
+  const geo::PrefixIndex index(geo::loadLocations(options.index));
+  BOOST_LOG_SEV(logger, Severity::info) << "[complete]: index keys " << index.size() << ", locations " << index.locations();
+
+  const auto addrs = geo::readFromFile(options.complete);
 
-  for (auto &i : futures)
+  geo::Answers answers;
+  answers.reserve(addrs.size());
+  for (const auto &i : addrs)
   {
-    auto answers = i.get();
-    result.insert(std::cend(result), std::cbegin(answers), std::cend(answers));
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::local;
+    for (const auto &m : index.complete(i, options.top))
+    {
+      answer.locations.push_back(*m.location);
+    }
+    answers.push_back(std::move(answer));
   }
 
-  return result;
+  print(options, output, answers);
+}
+
+/** @brief the daemon mode: the warm geocoders answer over HTTP until SIGINT, SIGTERM */
+void serve(const geocoder::utils::CmdOptions &options, const boost::property_tree::ptree &document)
+{
+  geocoder::geo::ServerOptions server_options;
+  server_options.endpoint = options.serve;
+  server_options.threads = document.get<std::size_t>("document.server.threads", server_options.threads);
+  server_options.max_body = document.get<std::size_t>("document.server.max_body", server_options.max_body);
+  server_options.max_batch = document.get<std::size_t>("document.server.max_batch", server_options.max_batch);
+  server_options.signals = true;
+
+  geocoder::geo::Server server(document, server_options);
+  server.run();
+}
+
+/** @brief the filter mode: the addresses from stdin, the answers to stdout as the batches complete */
+void stream(const geocoder::utils::CmdOptions &options, const boost::property_tree::ptree &document)
+{
+  geocoder::geo::StreamOptions stream_options;
+  stream_options.format = options.format;
+  stream_options.batch = document.get<std::size_t>("document.stream.batch", stream_options.batch);
+  stream_options.threads = document.get<std::size_t>("document.stream.threads", stream_options.threads);
+
+  geocoder::geo::geocodeStream(STDIN_FILENO, stdout, document, stream_options);
 }
 
-void print(const boost::filesystem::path &filename, const Answers &answers)
+/** @brief the batch of the address file with the journal of the progress, '--resume' skips the completed addresses */
+geocoder::geo::Answers checkpoint(const geocoder::utils::CmdOptions &options, const boost::property_tree::ptree &document,
+                                  const geocoder::geo::Addresses &addrs, const boost::filesystem::path &journal_file)
 {
-  std::ofstream fout(filename.string());
+  namespace fs = boost::filesystem;
+
+  auto &logger = geo_logger::get();
+  using geocoder::utils::logger::Severity;
 
-  if (!fout.is_open())
+  geocoder::geo::Answers answers;
+  std::vector<bool> done;
+  if (options.resume && fs::exists(journal_file))
   {
-    throw std::runtime_error("[print]: failed open filename '" + filename.string() + "'");
+    const auto completed = geocoder::geo::Journal::load(journal_file, addrs, answers, done);
+    BOOST_LOG_SEV(logger, Severity::info) << "[main]: resume '" << journal_file << "', completed " << completed << " of " << addrs.size();
   }
-
-  std::ostringstream out;
-  for (const auto &i : answers)
+  else if (fs::exists(journal_file))
   {
-    out << "geocoder type = '" << geocoder::geo::Answer::GeoTypeToText(i.type) << "'\n";
-
-    for (const auto &j : i.locations)
+    // the file of the other data is not overwritten
+    if (fs::file_size(journal_file) != 0 && !geocoder::geo::Journal::isJournal(journal_file))
     {
-      out << j.line << "\n";
-      out << "--> country = '" << j.country << "'\n";
-      out << "--> region = '" << j.region << "'\n";
-      out << "--> district = '" << j.district << "'\n";
-      out << "--> place = '" << j.place << "'\n";
-      out << "--> suburb = '" << j.suburb << "'\n";
-      out << "--> street = '" << j.street << "'\n";
-      out << "--> house = '" << j.house << "'\n";
-      out << "--> coord {" << j.coord.latitude << ", " << j.coord.longitude << "}\n";
-      out << "--> precision = '" << geocoder::geo::PrecisionToString(j.precision) << "'\n";
+      throw std::runtime_error("[main]: '" + journal_file.string() + "' is not the journal");
     }
-
-    out << "----------------------------------------------------------\n";
-    const auto &txt = out.str();
-    fout.write(txt.c_str(), txt.length());
-    out.str(std::string());
+    fs::remove(journal_file);
   }
+
+  geocoder::geo::Journal journal(journal_file, document.get<std::size_t>("document.journal.group", 1024));
+  geocoder::geo::geocode(addrs, document, answers, done, &journal);
+  return answers;
 }
+}  // namespace
 
 int main(int argc, char *argv[])
 {
   namespace fs = boost::filesystem;
 
-  fs::path config_filename;
-  fs::path addr_filename;
-  std::string addr;
-  fs::path out_filename;
+  // the subcommand: merge the outputs of the shards, without the config
+  if (argc > 1 && std::string(argv[1]) == "merge")
+  {
+    geocoder::utils::MergeOptions merge_options;
+    try
+    {
+      if (geocoder::utils::parseMergeCmd(argc - 1, argv + 1, merge_options))
+      {
+        geocoder::geo::mergeTabular(merge_options.inputs, merge_options.output);
+      }
+    }
+    catch (const std::exception &err)
+    {
+      std::cerr << err.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    return 0;
+  }
+
+  geocoder::utils::CmdOptions options;
 
   // parse cmd
-  if (!geocoder::utils::parseCmd(argc, argv, config_filename, addr, addr_filename, out_filename))
+  if (!geocoder::utils::parseCmd(argc, argv, options))
   {
     return 0;
   }
 
-  const auto config = geocoder::utils::getRealFileName(config_filename);
-  const auto file_result = geocoder::utils::getRealFileName(out_filename);
+  const auto &addr = options.address;
+  const auto &addr_filename = options.addr_file;
+  const auto config = geocoder::utils::getRealFileName(options.config);
+  const auto file_result = geocoder::utils::getRealFileName(options.output);
 
   // init logger
   geocoder::utils::logger::Logger::initFromFile(config);
@@ -172,26 +235,91 @@ int main(int argc, char *argv[])
     pt::ptree document;
     pt::read_xml(config.string(), document);
 
-    if (!addr.empty() && fs::exists(addr_filename))
+    if (!options.record.empty())
     {
-      BOOST_LOG_SEV(logger, Severity::fatal) << "[main]: Ambiguity parameters -a or -A";
-      return EXIT_FAILURE;
+      BOOST_LOG_SEV(logger, Severity::info) << "[main]: record responses to '" << options.record << "'";
+      document.put("document.recorder.mode", "record");
+      document.put("document.recorder.dir", options.record.string());
+    }
+    else if (!options.replay.empty())
+    {
+      BOOST_LOG_SEV(logger, Severity::info) << "[main]: replay responses from '" << options.replay << "'";
+      document.put("document.recorder.mode", "replay");
+      document.put("document.recorder.dir", options.replay.string());
     }
 
-    Addresses addrs;
-    if (!addr.empty())
+    if (!options.serve.empty())
+    {
+      serve(options, document);
+    }
+    else if (options.stream)
+    {
+      stream(options, document);
+    }
+    else if (!options.reverse.empty())
+    {
+      reverse(options, file_result);
+    }
+    else if (!options.complete.empty())
     {
-      BOOST_LOG_SEV(logger, Severity::debug) << "[main]: address '" << addr << "'";
-      addrs.push_back(addr);
+      complete(options, file_result);
     }
-    else if (fs::exists(addr_filename))
+    else
     {
-      auto addr_from_file = readFromFile(addr_filename);
-      std::swap(addrs, addr_from_file);
+      if (!addr.empty() && fs::exists(addr_filename))
+      {
+        BOOST_LOG_SEV(logger, Severity::fatal) << "[main]: Ambiguity parameters -a or -A";
+        return EXIT_FAILURE;
+      }
+
+      geocoder::geo::Addresses addrs;
+      if (!addr.empty())
+      {
+        BOOST_LOG_SEV(logger, Severity::debug) << "[main]: address '" << addr << "'";
+        addrs.push_back(addr);
+      }
+      else if (fs::exists(addr_filename))
+      {
+        auto addr_from_file = geocoder::geo::readFromFile(addr_filename);
+        std::swap(addrs, addr_from_file);
+      }
+
+      // the slice of the input, the ids of the output rows are the lines of the whole file
+      std::vector<std::size_t> ids;
+      if (!options.shard.empty())
+      {
+        const auto key = (options.shard_by == "hash") ? geocoder::geo::Shard::Key::hash : geocoder::geo::Shard::Key::line;
+        const auto shard = geocoder::geo::parseShard(options.shard, key);
+        const auto total = addrs.size();
+        addrs = geocoder::geo::selectShard(addrs, shard, ids);
+        BOOST_LOG_SEV(logger, Severity::info) << "[main]: shard " << options.shard << " by " << options.shard_by << ", addresses " << addrs.size()
+                                              << " of " << total;
+      }
+
+      // the journal of the address file, it is removed after the output is written
+      auto journal_file = options.journal;
+      if (journal_file.empty() && !options.output.empty())
+      {
+        journal_file = file_result.string() + ".journal";
+      }
+
+      if (addr.empty() && !journal_file.empty())
+      {
+        auto result = checkpoint(options, document, addrs, journal_file);
+        print(options, file_result, result, ids);
+        fs::remove(journal_file);
+      }
+      else
+      {
+        auto result = geocoder::geo::geocode(addrs, document);
+        print(options, file_result, result, ids);
+      }
     }
 
-    auto result = geocode(addrs, document);
-    print(file_result, result);
+    for (const auto &i : geocoder::utils::metrics::snapshot())
+    {
+      BOOST_LOG_SEV(logger, Severity::info) << "[main]: metric '" << i.first << "' = " << i.second;
+    }
   }
   catch (const std::exception &err)
   {
@@ -200,6 +328,7 @@ int main(int argc, char *argv[])
   }
 
   BOOST_LOG_SEV(logger, Severity::info) << "[main]: complete geocoder.";
+  geocoder::utils::logger::binary::stop();
   boost::log::core::get()->remove_all_sinks();
 
   return 0;
@@ -0,0 +1,433 @@
+/** @file balancer.cpp
+ *  @brief the implementation of the class Balancer
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/balancer.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+// this
+#include "utils/logger/logger.h"
+
+namespace geocoder
+{
+namespace utils
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief days since epoch (UTC) */
+std::int64_t today()
+{
+  using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+  return std::chrono::duration_cast<Days>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/** @brief YYYY-MM-DD */
+std::string dayToText(std::int64_t day)
+{
+  const auto time = static_cast<std::time_t>(day * 86400);
+  std::tm tm{};
+  gmtime_r(&time, &tm);
+
+  char buf[16];
+  std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+  return buf;
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+Endpoints readEndpoints(const boost::property_tree::ptree &connection)
+{
+  const auto url = connection.get<std::string>("url", std::string());
+
+  Endpoints result;
+  if (const auto endpoints = connection.get_child_optional("endpoints"))
+  {
+    auto r = endpoints->equal_range("endpoint");
+    for (; r.first != r.second; ++r.first)
+    {
+      const auto &conf = r.first->second;
+
+      Endpoint endpoint;
+      endpoint.id = conf.get<std::string>("id", std::to_string(result.size()));
+      endpoint.url = conf.get<std::string>("url", url);
+      endpoint.key = conf.get<std::string>("key", std::string());
+      endpoint.weight = conf.get<std::size_t>("weight", endpoint.weight);
+      endpoint.quota = conf.get<std::uint64_t>("quota", endpoint.quota);
+      result.push_back(endpoint);
+    }
+  }
+  else if (!url.empty())
+  {
+    Endpoint endpoint;
+    endpoint.id = "0";
+    endpoint.url = url;
+    result.push_back(endpoint);
+  }
+
+  if (result.empty())
+  {
+    throw std::runtime_error("[readEndpoints]: is not set 'url' or 'endpoints' option");
+  }
+
+  for (const auto &i : result)
+  {
+    if (i.url.empty())
+    {
+      throw std::runtime_error("[readEndpoints]: is not set 'url' of the endpoint '" + i.id + "'");
+    }
+    if (!i.weight)
+    {
+      throw std::runtime_error("[readEndpoints]: zero weight of the endpoint '" + i.id + "'");
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+class Balancer::Impl final
+{
+ public:
+  Impl(Endpoints endpoints, const boost::filesystem::path &usage, std::size_t flush)
+   : endpoints_(std::move(endpoints))
+   , usage_(usage)
+   , flush_(std::max<std::size_t>(flush, 1))
+   , used_(endpoints_.size(), 0)
+   , exhausted_(endpoints_.size(), false)
+   , current_(endpoints_.size(), 0)
+   , day_(today())
+  {
+    if (endpoints_.empty())
+    {
+      throw std::runtime_error("[Balancer::Impl::Impl]: is empty endpoints");
+    }
+
+    load();
+  }
+
+  ~Impl()
+  {
+    try
+    {
+      Usage usage;
+      {
+        std::lock_guard<std::mutex> locker(lock_);
+        if (!pending_)
+        {
+          return;
+        }
+        usage = snapshot();
+      }
+      write(usage);
+    }
+    catch (const std::exception &err)
+    {
+      BOOST_LOG_SEV(geo_logger::get(), logger::Severity::error) << "[Balancer::Impl::~Impl]: " << err.what();
+    }
+  }
+
+  std::size_t acquire()
+  {
+    Usage usage;
+    const auto result = next(usage);
+    if (usage.sequence)
+    {
+      writeLogged(usage);
+    }
+    return result;
+  }
+
+  void exhaust(std::size_t i)
+  {
+    Usage usage;
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      rollover();
+
+      if (exhausted_.at(i))
+      {
+        return;
+      }
+      exhausted_[i] = true;
+      BOOST_LOG_SEV(geo_logger::get(), logger::Severity::warning)
+          << "[Balancer::exhaust]: endpoint '" << endpoints_[i].id << "' is exhausted for " << dayToText(day_) << ", requests " << used_[i];
+      usage = snapshot();
+    }
+    writeLogged(usage);
+  }
+
+  std::size_t size() const { return endpoints_.size(); }
+
+  const Endpoint &endpoint(std::size_t i) const { return endpoints_.at(i); }
+
+  std::uint64_t used(std::size_t i) const
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    return (day_ == today()) ? used_.at(i) : 0;
+  }
+
+  bool exhausted(std::size_t i) const
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    return (day_ == today()) && !available(i);
+  }
+
+  void save() const
+  {
+    Usage usage;
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      usage = snapshot();
+    }
+    write(usage);
+  }
+
+ private:
+  /** @struct Usage
+   *  @brief the copy of the counters for the file, written outside the lock of the requests
+   */
+  struct Usage
+  {
+    /** @brief the order of the copies, 0 - none */
+    std::uint64_t sequence{0};
+    std::int64_t day{0};
+    std::vector<std::uint64_t> used;
+    std::vector<bool> exhausted;
+  };
+
+  /** @brief the endpoint of the request, the copy of the counters every 'flush' requests */
+  std::size_t next(Usage &usage)
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    rollover();
+
+    // smooth weighted round robin of the available endpoints
+    std::size_t best = endpoints_.size();
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < endpoints_.size(); ++i)
+    {
+      if (!available(i))
+      {
+        continue;
+      }
+
+      const auto weight = static_cast<std::int64_t>(endpoints_[i].weight);
+      current_[i] += weight;
+      total += weight;
+      if (best == endpoints_.size() || current_[i] > current_[best])
+      {
+        best = i;
+      }
+    }
+
+    if (best == endpoints_.size())
+    {
+      throw std::runtime_error("[Balancer::acquire]: the quotas of the all endpoints are exhausted for " + dayToText(day_));
+    }
+
+    current_[best] -= total;
+    ++used_[best];
+
+    if (++pending_ >= flush_)
+    {
+      usage = snapshot();
+    }
+
+    return best;
+  }
+
+  /** @brief the lock is held */
+  Usage snapshot() const
+  {
+    pending_ = 0;
+
+    Usage result;
+    result.sequence = ++sequence_;
+    result.day = day_;
+    result.used = used_;
+    result.exhausted = exhausted_;
+    return result;
+  }
+
+  bool available(std::size_t i) const
+  {
+    const auto &endpoint = endpoints_[i];
+    return !exhausted_[i] && (!endpoint.quota || used_[i] < endpoint.quota);
+  }
+
+  /** @brief the new day: the quotas are restored */
+  void rollover()
+  {
+    const auto day = today();
+    if (day != day_)
+    {
+      day_ = day;
+      std::fill(used_.begin(), used_.end(), 0);
+      std::fill(exhausted_.begin(), exhausted_.end(), false);
+      std::fill(current_.begin(), current_.end(), 0);
+    }
+  }
+
+  /** @brief read the usage of today, the usage of the other days is ignored */
+  void load()
+  {
+    namespace pt = boost::property_tree;
+
+    if (usage_.empty() || !boost::filesystem::exists(usage_))
+    {
+      return;
+    }
+
+    using logger::Severity;
+    auto &logger = geo_logger::get();
+    try
+    {
+      pt::ptree document;
+      pt::read_xml(usage_.string(), document);
+
+      if (document.get<std::string>("usage.day") != dayToText(day_))
+      {
+        BOOST_LOG_SEV(logger, Severity::info) << "[Balancer::Impl::load]: the usage of the other day '" << usage_ << "'";
+        return;
+      }
+
+      auto r = document.get_child("usage").equal_range("endpoint");
+      for (; r.first != r.second; ++r.first)
+      {
+        const auto id = r.first->second.get<std::string>("id");
+        for (std::size_t i = 0; i < endpoints_.size(); ++i)
+        {
+          if (endpoints_[i].id == id)
+          {
+            used_[i] = r.first->second.get<std::uint64_t>("requests", 0);
+            exhausted_[i] = r.first->second.get<bool>("exhausted", false);
+          }
+        }
+      }
+    }
+    catch (const std::exception &err)
+    {
+      BOOST_LOG_SEV(logger, Severity::warning) << "[Balancer::Impl::load]: failed read usage '" << usage_ << "', " << err.what();
+    }
+  }
+
+  /** @brief the usage is written to the temporary file and renamed (the file is always complete),
+   *  the copy older than the written one is skipped
+   */
+  void write(const Usage &usage) const
+  {
+    namespace pt = boost::property_tree;
+
+    if (usage_.empty())
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> locker(write_lock_);
+    if (usage.sequence <= written_)
+    {
+      return;
+    }
+
+    pt::ptree document;
+    auto &root = document.put_child("usage", pt::ptree());
+    root.put("day", dayToText(usage.day));
+    for (std::size_t i = 0; i < endpoints_.size(); ++i)
+    {
+      auto &endpoint = root.add_child("endpoint", pt::ptree());
+      endpoint.put("id", endpoints_[i].id);
+      endpoint.put("requests", usage.used[i]);
+      endpoint.put("exhausted", static_cast<bool>(usage.exhausted[i]));
+    }
+
+    auto tmp = usage_;
+    tmp += ".tmp";
+    pt::write_xml(tmp.string(), document);
+    boost::filesystem::rename(tmp, usage_);
+    written_ = usage.sequence;
+  }
+
+  /** @brief the failed write is not the failure of the request */
+  void writeLogged(const Usage &usage) const
+  {
+    try
+    {
+      write(usage);
+    }
+    catch (const std::exception &err)
+    {
+      BOOST_LOG_SEV(geo_logger::get(), logger::Severity::error) << "[Balancer::Impl::write]: failed write usage '" << usage_ << "', " << err.what();
+    }
+  }
+
+ private:
+  const Endpoints endpoints_;
+  const boost::filesystem::path usage_;
+  const std::size_t flush_;
+
+  mutable std::mutex lock_;
+  std::vector<std::uint64_t> used_;
+  std::vector<bool> exhausted_;
+  std::vector<std::int64_t> current_;
+  std::int64_t day_;
+  mutable std::size_t pending_{0};
+  mutable std::uint64_t sequence_{0};
+
+  /** @brief the writes of the file, the last written copy */
+  mutable std::mutex write_lock_;
+  mutable std::uint64_t written_{0};
+};
+//--------------------------------------------------------------------------------------------
+Balancer::Balancer(Endpoints endpoints, const boost::filesystem::path &usage, std::size_t flush)
+ : impl_(new Impl(std::move(endpoints), usage, flush))
+{
+}
+//--------------------------------------------------------------------------------------------
+Balancer::~Balancer() = default;
+//--------------------------------------------------------------------------------------------
+std::size_t Balancer::acquire() { return impl_->acquire(); }
+//--------------------------------------------------------------------------------------------
+void Balancer::exhaust(std::size_t i) { impl_->exhaust(i); }
+//--------------------------------------------------------------------------------------------
+std::size_t Balancer::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+const Endpoint &Balancer::endpoint(std::size_t i) const { return impl_->endpoint(i); }
+//--------------------------------------------------------------------------------------------
+std::uint64_t Balancer::used(std::size_t i) const { return impl_->used(i); }
+//--------------------------------------------------------------------------------------------
+bool Balancer::exhausted(std::size_t i) const { return impl_->exhausted(i); }
+//--------------------------------------------------------------------------------------------
+void Balancer::save() const { impl_->save(); }
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<Balancer> Balancer::shared(const std::string &key, const Endpoints &endpoints, const boost::filesystem::path &usage)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<Balancer>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  auto &item = registry[key];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<Balancer>(endpoints, usage);
+    item = result;
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace utils
+}  // namespace geocoder
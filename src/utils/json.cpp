@@ -0,0 +1,404 @@
+/** @file json.cpp
+ *  @brief the implementation of the single pass (SAX) json reader
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/json.h"
+
+// std
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace json
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @class Reader
+ *  @brief recursive descent over the buffer, the strings without escapes are passed without copy
+ */
+class Reader final
+{
+  static const std::size_t max_depth_ = 512;
+
+ public:
+  Reader(const char *data, std::size_t size, Handler &handler)
+   : begin_(data)
+   , p_(data)
+   , end_(data + size)
+   , handler_(handler)
+  {
+  }
+
+  void run()
+  {
+    value(0);
+    if (handler_.stopped())
+    {
+      return;
+    }
+    skipSpace();
+    if (p_ != end_)
+    {
+      error("unexpected data after the document");
+    }
+  }
+
+ private:
+  [[noreturn]] void error(const char *what) const
+  {
+    throw std::runtime_error(std::string("[json::parse]: ") + what + " at offset " + std::to_string(p_ - begin_));
+  }
+
+  void skipSpace()
+  {
+    while (p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+    {
+      ++p_;
+    }
+  }
+
+  char next()
+  {
+    skipSpace();
+    if (p_ == end_)
+    {
+      error("unexpected end of the document");
+    }
+    return *p_;
+  }
+
+  void expect(char c)
+  {
+    if (next() != c)
+    {
+      error("unexpected character");
+    }
+    ++p_;
+  }
+
+  void value(std::size_t depth)
+  {
+    if (depth > max_depth_)
+    {
+      error("too deep nesting");
+    }
+
+    switch (next())
+    {
+      case '{':
+        object(depth);
+        break;
+      case '[':
+        array(depth);
+        break;
+      case '"':
+      {
+        const char *data = nullptr;
+        std::size_t size = 0;
+        string(data, size);
+        handler_.string(data, size);
+        break;
+      }
+      default:
+        literal();
+    }
+  }
+
+  void object(std::size_t depth)
+  {
+    ++p_;
+    handler_.startObject();
+
+    if (next() == '}')
+    {
+      ++p_;
+      handler_.endObject();
+      return;
+    }
+
+    for (;;)
+    {
+      if (next() != '"')
+      {
+        error("expected key");
+      }
+
+      const char *data = nullptr;
+      std::size_t size = 0;
+      string(data, size);
+      handler_.key(data, size);
+
+      expect(':');
+      value(depth + 1);
+      if (handler_.stopped())
+      {
+        return;
+      }
+
+      const auto c = next();
+      ++p_;
+      if (c == '}')
+      {
+        break;
+      }
+      else if (c != ',')
+      {
+        --p_;
+        error("expected ',' or '}'");
+      }
+    }
+
+    handler_.endObject();
+  }
+
+  void array(std::size_t depth)
+  {
+    ++p_;
+    handler_.startArray();
+
+    if (next() == ']')
+    {
+      ++p_;
+      handler_.endArray();
+      return;
+    }
+
+    for (;;)
+    {
+      value(depth + 1);
+      if (handler_.stopped())
+      {
+        return;
+      }
+
+      const auto c = next();
+      ++p_;
+      if (c == ']')
+      {
+        break;
+      }
+      else if (c != ',')
+      {
+        --p_;
+        error("expected ',' or ']'");
+      }
+    }
+
+    handler_.endArray();
+  }
+
+  void literal()
+  {
+    const char *start = p_;
+    while (p_ != end_ && (std::isalnum(static_cast<unsigned char>(*p_)) || *p_ == '-' || *p_ == '+' || *p_ == '.'))
+    {
+      ++p_;
+    }
+
+    const auto size = static_cast<std::size_t>(p_ - start);
+    if (!size)
+    {
+      error("unexpected character");
+    }
+
+    const auto is = [start, size](const char *text) { return size == std::strlen(text) && !std::memcmp(start, text, size); };
+    if (!is("true") && !is("false") && !is("null") && !(*start == '-' || std::isdigit(static_cast<unsigned char>(*start))))
+    {
+      p_ = start;
+      error("invalid literal");
+    }
+
+    handler_.literal(start, size);
+  }
+
+  /** @brief p_ on the open quote */
+  void string(const char *&data, std::size_t &size)
+  {
+    const char *start = ++p_;
+
+    // fast path: no escapes
+    while (p_ != end_ && *p_ != '"' && *p_ != '\\')
+    {
+      if (static_cast<unsigned char>(*p_) < 0x20)
+      {
+        error("control character in string");
+      }
+      ++p_;
+    }
+
+    if (p_ == end_)
+    {
+      error("unterminated string");
+    }
+
+    if (*p_ == '"')
+    {
+      data = start;
+      size = static_cast<std::size_t>(p_ - start);
+      ++p_;
+      return;
+    }
+
+    scratch_.assign(start, p_);
+    while (p_ != end_ && *p_ != '"')
+    {
+      if (*p_ == '\\')
+      {
+        ++p_;
+        if (p_ == end_)
+        {
+          break;
+        }
+
+        switch (*p_)
+        {
+          case '"':
+          case '\\':
+          case '/':
+            scratch_.push_back(*p_);
+            break;
+          case 'b':
+            scratch_.push_back('\b');
+            break;
+          case 'f':
+            scratch_.push_back('\f');
+            break;
+          case 'n':
+            scratch_.push_back('\n');
+            break;
+          case 'r':
+            scratch_.push_back('\r');
+            break;
+          case 't':
+            scratch_.push_back('\t');
+            break;
+          case 'u':
+            unicode();
+            continue;
+          default:
+            error("invalid escape");
+        }
+        ++p_;
+      }
+      else if (static_cast<unsigned char>(*p_) < 0x20)
+      {
+        error("control character in string");
+      }
+      else
+      {
+        scratch_.push_back(*p_++);
+      }
+    }
+
+    if (p_ == end_)
+    {
+      error("unterminated string");
+    }
+
+    ++p_;
+    data = scratch_.data();
+    size = scratch_.size();
+  }
+
+  std::uint32_t hex4()
+  {
+    if (end_ - p_ < 4)
+    {
+      error("invalid unicode escape");
+    }
+
+    std::uint32_t result = 0;
+    for (int i = 0; i < 4; ++i, ++p_)
+    {
+      const auto c = *p_;
+      result <<= 4;
+      if (c >= '0' && c <= '9')
+      {
+        result |= static_cast<std::uint32_t>(c - '0');
+      }
+      else if (c >= 'a' && c <= 'f')
+      {
+        result |= static_cast<std::uint32_t>(c - 'a' + 10);
+      }
+      else if (c >= 'A' && c <= 'F')
+      {
+        result |= static_cast<std::uint32_t>(c - 'A' + 10);
+      }
+      else
+      {
+        error("invalid unicode escape");
+      }
+    }
+
+    return result;
+  }
+
+  /** @brief p_ on 'u' of \uXXXX, the surrogate pairs are joined */
+  void unicode()
+  {
+    ++p_;
+    auto code = hex4();
+
+    if (code >= 0xD800 && code <= 0xDBFF)
+    {
+      if (end_ - p_ < 6 || p_[0] != '\\' || p_[1] != 'u')
+      {
+        error("invalid surrogate pair");
+      }
+      p_ += 2;
+      const auto low = hex4();
+      if (low < 0xDC00 || low > 0xDFFF)
+      {
+        error("invalid surrogate pair");
+      }
+      code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (code < 0x80)
+    {
+      scratch_.push_back(static_cast<char>(code));
+    }
+    else if (code < 0x800)
+    {
+      scratch_.push_back(static_cast<char>(0xC0 | (code >> 6)));
+      scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000)
+    {
+      scratch_.push_back(static_cast<char>(0xE0 | (code >> 12)));
+      scratch_.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+      scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+      scratch_.push_back(static_cast<char>(0xF0 | (code >> 18)));
+      scratch_.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+      scratch_.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+      scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+  }
+
+ private:
+  const char *begin_;
+  const char *p_;
+  const char *end_;
+  Handler &handler_;
+  std::string scratch_;
+};
+}  // namespace
+//--------------------------------------------------------------------------------------------
+void parse(const char *data, std::size_t size, Handler &handler) { Reader(data, size, handler).run(); }
+//--------------------------------------------------------------------------------------------
+void parse(const std::string &text, Handler &handler) { parse(text.data(), text.size(), handler); }
+//--------------------------------------------------------------------------------------------
+}  // namespace json
+}  // namespace utils
+}  // namespace geocoder
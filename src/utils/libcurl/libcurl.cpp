@@ -7,13 +7,18 @@
 #include "utils/libcurl/libcurl.h"
 
 // std
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <sstream>
+#include <stdexcept>
 
 // curl
 #include <curl/curl.h>
@@ -32,8 +37,6 @@ auto CurlCleaner(CURL *p)
   assert(p && "Is not nullptr curl pointer");
   curl_easy_cleanup(p);
 }
-using TCurlListCleaner = std::function<void(curl_slist *)>;
-using CurlListPtr = std::unique_ptr<curl_slist, TCurlListCleaner>;
 auto CurlListCleaner(curl_slist *t)
 {
   if (t)
@@ -72,147 +75,244 @@ class CurlGlobalInitializator final
   bool init_{false};
 };
 
+bool globalInit()
+{
+  static CurlGlobalInitializator initializator;
+  return initializator;
+}
+
+namespace
+{
+/** @brief body size on the wire of the last transfer of the thread */
+thread_local std::uint64_t last_wire_size = 0;
+
+/** @brief the home slot of the thread in the pools of the handles: the threads take the different handles */
+std::size_t homeSlot()
+{
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t result = next.fetch_add(1, std::memory_order_relaxed);
+  return result;
+}
+}  // namespace
+
 LibCurl::LibCurl(LibCurl &&) = default;
 LibCurl &LibCurl::operator=(LibCurl &&) = default;
 LibCurl::~LibCurl() = default;
 
 class LibCurl::Impl final
 {
- public:
-  Impl()
-   : curl_{nullptr, CurlCleaner}
-   , curl_list_{nullptr, CurlListCleaner}
+  /** @struct Handle
+   * @brief the easy handle with the options applied
+   */
+  struct Handle
+  {
+    CurlPtr curl{nullptr, CurlCleaner};
+    /** @brief the generation of the options applied, 0 - the handle is changed by the request (post, head) */
+    std::uint64_t generation{0};
+    /** @brief the list of the headers is used by curl until the options are applied again */
+    std::shared_ptr<curl_slist> headers;
+    /** @brief the timeouts of the options and the current ones (the deadline of the request) */
+    std::uint32_t timeout_ms{0};
+    std::uint32_t conntimeout_ms{0};
+    std::uint32_t current_timeout_ms{0};
+    std::uint32_t current_conntimeout_ms{0};
+    /** @brief the buffer of the answer of the current request */
+    std::string *body{nullptr};
+    std::array<char, CURL_ERROR_SIZE> error;
+  };
+
+  /** @brief the slot of the pool, the threads of the different slots do not share the cache line */
+  struct alignas(64) Slot
   {
-    static CurlGlobalInitializator initializator;
+    std::atomic<Handle *> handle{nullptr};
+  };
+  using SlotsPtr = std::unique_ptr<Slot[], void (*)(void *)>;
 
-    if (!initializator)
+  /** @brief the slots aligned to the cache line ('new' of C++14 does not align above alignof(std::max_align_t)) */
+  static SlotsPtr allocateSlots(std::size_t size)
+  {
+    void *memory = nullptr;
+    if (::posix_memalign(&memory, alignof(Slot), size * sizeof(Slot)) != 0)
+    {
+      throw std::bad_alloc();
+    }
+    auto *result = static_cast<Slot *>(memory);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      new (result + i) Slot();
+    }
+    return SlotsPtr(result, std::free);
+  }
+
+  /** @class Lease
+   * @brief the handle taken from the pool, returned by the destructor
+   */
+  class Lease final
+  {
+   public:
+    explicit Lease(Impl &impl)
+     : impl_(impl)
+     , handle_(impl.checkout())
     {
-      throw std::runtime_error("[LibCurl::init]: failed global initialization.");
     }
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    ~Lease() { impl_.checkin(handle_); }
+
+    Handle &operator*() const { return *handle_; }
+
+   private:
+    Impl &impl_;
+    Handle *handle_;
+  };
 
-    CURL *p = curl_easy_init();
-    if (!p)
+ public:
+  explicit Impl(const LibCurlOptions &options)
+   : options_(options)
+   , size_(std::max<std::size_t>(options.handles, 1))
+   , slots_(allocateSlots(size_))
+  {
+    if (!globalInit())
     {
-      throw std::runtime_error("[LibCurl::init]: failed 'curl_easy_init()'.");
+      throw std::runtime_error("[LibCurl::init]: failed global initialization.");
     }
+  }
 
-    curl_.reset(p);
+  ~Impl()
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      delete slots_[i].handle.load(std::memory_order_acquire);
+    }
   }
 
+  Impl(const Impl &) = delete;
+  Impl &operator=(const Impl &) = delete;
+
   //----------------------------------------------------------------------------------------
   void verbose(bool enable)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_VERBOSE, static_cast<long>(enable), "LibCurl::verbose", "CURLOPT_VERBOSE");
+    update([&] { options_.verbose = enable; });
   }
   //----------------------------------------------------------------------------------------
   void setTimeOut(std::uint32_t t)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_TIMEOUT, static_cast<long>(t), "LibCurl::setTimeOut", "CURLOPT_TIMEOUT");
+    update([&] { options_.timeout_ms = t * 1000; });
   }
   //----------------------------------------------------------------------------------------
   void setConnTimeOut(std::uint32_t t)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_CONNECTTIMEOUT, static_cast<long>(t), "LibCurl::setConnTimeOut", "CURLOPT_CONNECTTIMEOUT");
+    update([&] { options_.conntimeout_ms = t * 1000; });
+  }
+  //----------------------------------------------------------------------------------------
+  void setTimeOutMs(std::uint32_t t)
+  {
+    update([&] { options_.timeout_ms = t; });
+  }
+  //----------------------------------------------------------------------------------------
+  void setConnTimeOutMs(std::uint32_t t)
+  {
+    update([&] { options_.conntimeout_ms = t; });
+  }
+  //----------------------------------------------------------------------------------------
+  void setLowSpeed(std::uint32_t limit, std::uint32_t time)
+  {
+    update([&] {
+      options_.low_speed_limit = limit;
+      options_.low_speed_time = time;
+    });
+  }
+  //----------------------------------------------------------------------------------------
+  void setAcceptEncoding(const std::string &encoding)
+  {
+    update([&] {
+      options_.compression = true;
+      options_.accept_encoding = encoding;
+    });
   }
   //----------------------------------------------------------------------------------------
   void setUserPassw(const std::string &login, const std::string &passw)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_USERNAME, login.data(), "LibCurl::setUserPassw", "CURLOPT_USERNAME");
-    curlSetOpt(CURLOPT_PASSWORD, passw.data(), "LibCurl::setUasePassw", "CURLOPT_PASSWORD");
+    update([&] {
+      login_ = login;
+      passw_ = passw;
+    });
   }
   //----------------------------------------------------------------------------------------
   void setHeaders(const std::string &encoding, const Headers &h)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_ENCODING, encoding.c_str(), "LibCurl::setHeaders", "CURLOPT_ENCODING");
-
-    curl_slist *headers = nullptr;
+    curl_slist *list = nullptr;
     for (const auto &i : h)
     {
-      headers = curl_slist_append(headers, i.data());
+      list = curl_slist_append(list, i.data());
     }
+    std::shared_ptr<curl_slist> headers(list, CurlListCleaner);
 
-    curl_list_.reset(headers);
-
-    curlSetOpt(CURLOPT_HTTPHEADER, curl_list_.get(), "LibCurl::setHeaders", "CURLOPT_HTTPHEADER");
+    update([&] {
+      encoding_ = encoding;
+      headers_ = std::move(headers);
+    });
   }
   //----------------------------------------------------------------------------------------
-  std::tuple<std::string, long> get(const std::string &url)
+  long get(const std::string &url, std::string &buffer, std::uint32_t timeout_ms)
   {
-    std::unique_lock<std::mutex> locker(lock_);
-
-    curlSetOpt(CURLOPT_URL, url.data(), "LibCurl::get", "CURLOPT_URL");
-    std::array<char, CURL_ERROR_SIZE> errBuffer;
-    curlSetOpt(CURLOPT_ERRORBUFFER, errBuffer.data(), "LibCurl::get", "CURLOPT_ERRORBUFFER");
-
-    curlSetOpt(CURLOPT_WRITEFUNCTION, writer, "LibCurl::get", "CURLOPT_WRITEFUNCTION");
+    Lease lease(*this);
+    auto &handle = *lease;
+    auto *curl = handle.curl.get();
 
-    std::string buffer;
-    curlSetOpt(CURLOPT_WRITEDATA, &buffer, "LibCurl::get", "CURLOPT_WRITEDATA");
+    setTimeOuts(handle, timeout_ms);
+    curlSetOpt(curl, CURLOPT_URL, url.c_str(), "LibCurl::get", "CURLOPT_URL");
 
-    if (curl_list_)
-    {
-      curlSetOpt(CURLOPT_HEADER, 1, "LibCurl::get", "CURLOPT_HEADER");
-    }
+    buffer.clear();
+    handle.body = &buffer;
+    auto result = curl_easy_perform(curl);
+    handle.body = nullptr;
 
     auto responseCode = static_cast<long>(0);
-    auto result = curl_easy_perform(curl_.get());
-    auto retGetInfo = curl_easy_getinfo(curl_.get(), CURLINFO_RESPONSE_CODE, &responseCode);
+    auto retGetInfo = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
     if (CURLE_OK != retGetInfo)
     {
       throwCurlError(retGetInfo, "LibCurl::get", "CURLINFO_RESPONSE_CODE");
     }
 
-    curl_easy_reset(curl_.get());
-    curl_list_.reset();
+    curl_off_t wire = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+    last_wire_size = static_cast<std::uint64_t>(wire);
 
     if (CURLE_OK != result)
     {
       throwCurlError(result, "LibCurl::get", std::string());
     }
 
-    return std::make_tuple(std::move(buffer), responseCode);
+    return responseCode;
   }
   //----------------------------------------------------------------------------------------
   std::tuple<std::string, long> post(const std::string &url)
   {
-    std::unique_lock<std::mutex> locker(lock_);
+    Lease lease(*this);
+    auto &handle = *lease;
+    auto *curl = handle.curl.get();
 
-    curlSetOpt(CURLOPT_URL, url.data(), "LibCurl::post", "CURLOPT_URL");
-    std::array<char, CURL_ERROR_SIZE> errBuffer;
-    curlSetOpt(CURLOPT_ERRORBUFFER, errBuffer.data(), "LibCurl::post", "CURLOPT_ERRORBUFFER");
-    curlSetOpt(CURLOPT_POST, 1L, "LibCurl::get", "CURLOPT_POST");
+    // the handle is changed: the options are applied again by the next request
+    handle.generation = 0;
 
-    curlSetOpt(CURLOPT_READFUNCTION, writer, "LibCurl::post", "CURLOPT_READFUNCTION");
+    curlSetOpt(curl, CURLOPT_URL, url.c_str(), "LibCurl::post", "CURLOPT_URL");
+    curlSetOpt(curl, CURLOPT_POST, 1L, "LibCurl::post", "CURLOPT_POST");
+    // the empty body, not read from stdin
+    curlSetOpt(curl, CURLOPT_POSTFIELDS, "", "LibCurl::post", "CURLOPT_POSTFIELDS");
+    curlSetOpt(curl, CURLOPT_POSTFIELDSIZE, 0L, "LibCurl::post", "CURLOPT_POSTFIELDSIZE");
 
     std::string buffer;
-    curlSetOpt(CURLOPT_READDATA, &buffer, "LibCurl::post", "CURLOPT_READDATA");
-
-    if (curl_list_)
-    {
-      curlSetOpt(CURLOPT_HEADER, 1, "LibCurl::post", "CURLOPT_HEADER");
-    }
-
+    handle.body = &buffer;
     auto responseCode = static_cast<long>(0);
-    auto result = curl_easy_perform(curl_.get());
-    auto retGetInfo = curl_easy_getinfo(curl_.get(), CURLINFO_RESPONSE_CODE, &responseCode);
+    auto result = curl_easy_perform(curl);
+    handle.body = nullptr;
+    auto retGetInfo = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
     if (CURLE_OK != retGetInfo)
     {
       throwCurlError(retGetInfo, "LibCurl::post", "CURLINFO_RESPONSE_CODE");
     }
 
-    curl_easy_reset(curl_.get());
-    curl_list_.reset();
-
     if (CURLE_OK != result)
     {
       throwCurlError(result, "LibCurl::post", std::string());
@@ -221,31 +321,186 @@ class LibCurl::Impl final
     return std::make_tuple(std::move(buffer), responseCode);
   }
   //----------------------------------------------------------------------------------------
-  std::string escapeUrl(const std::string &url)
+  long head(const std::string &url)
   {
-    std::unique_lock<std::mutex> locker(lock_);
+    Lease lease(*this);
+    auto &handle = *lease;
+    auto *curl = handle.curl.get();
 
-    char *ptr = curl_easy_escape(curl_.get(), url.data(), url.size());
-    std::string result{ptr};
-    curl_free(ptr);
-    return result;
+    // the reset by the next request keeps the connections and the dns cache
+    handle.generation = 0;
+
+    curlSetOpt(curl, CURLOPT_URL, url.c_str(), "LibCurl::head", "CURLOPT_URL");
+    curlSetOpt(curl, CURLOPT_NOBODY, 1L, "LibCurl::head", "CURLOPT_NOBODY");
+
+    auto responseCode = static_cast<long>(0);
+    auto result = curl_easy_perform(curl);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+
+    if (CURLE_OK != result)
+    {
+      throwCurlError(result, "LibCurl::head", std::string());
+    }
+
+    return responseCode;
+  }
+  //----------------------------------------------------------------------------------------
+  static void escapeUrl(const std::string &url, std::string &out)
+  {
+    static const char hex[] = "0123456789ABCDEF";
+    for (const auto c : url)
+    {
+      const auto u = static_cast<unsigned char>(c);
+      if ((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '-' || u == '.' || u == '_' || u == '~')
+      {
+        out.push_back(c);
+      }
+      else
+      {
+        out.push_back('%');
+        out.push_back(hex[u >> 4]);
+        out.push_back(hex[u & 0x0f]);
+      }
+    }
   }
-  //---------------------------------------------------------------------------------------
-  /** @brief disable copy semantics */
-  Impl(const Impl &) = delete;
-  Impl &operator=(const Impl &) = delete;
-  /** @brief move semantics */
-  Impl(Impl &&) = default;
-  Impl &operator=(Impl &&) = default;
-  ~Impl() = default;
 
  private:
+  /** @brief the handle of the pool (the home slot of the thread first), the new one if the pool is empty */
+  Handle *checkout()
+  {
+    const auto home = homeSlot();
+    Handle *result = nullptr;
+    for (std::size_t i = 0; i < size_ && !result; ++i)
+    {
+      auto &slot = slots_[(home + i) % size_].handle;
+      if (slot.load(std::memory_order_relaxed))
+      {
+        result = slot.exchange(nullptr, std::memory_order_acquire);
+      }
+    }
+
+    if (!result)
+    {
+      std::unique_ptr<Handle> handle(new Handle());
+      handle->curl.reset(curl_easy_init());
+      if (!handle->curl)
+      {
+        throw std::runtime_error("[LibCurl::init]: failed 'curl_easy_init()'.");
+      }
+      result = handle.release();
+    }
+
+    if (result->generation != generation_.load(std::memory_order_acquire))
+    {
+      try
+      {
+        apply(*result);
+      }
+      catch (...)
+      {
+        delete result;
+        throw;
+      }
+    }
+    return result;
+  }
+
+  /** @brief the handle returns to the free slot (the home slot of the thread first), destroyed if the pool is full */
+  void checkin(Handle *handle)
+  {
+    const auto home = homeSlot();
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      Handle *expected = nullptr;
+      if (slots_[(home + i) % size_].handle.compare_exchange_strong(expected, handle, std::memory_order_release, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+    delete handle;
+  }
+
+  /** @brief the options are applied once: the new handle, the options are changed, the handle is changed by the request */
+  void apply(Handle &handle)
+  {
+    auto *curl = handle.curl.get();
+    curl_easy_reset(curl);
+
+    std::lock_guard<std::mutex> locker(lock_);
+
+    curlSetOpt(curl, CURLOPT_VERBOSE, static_cast<long>(options_.verbose), "LibCurl::apply", "CURLOPT_VERBOSE");
+    curlSetOpt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(options_.timeout_ms), "LibCurl::apply", "CURLOPT_TIMEOUT_MS");
+    curlSetOpt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(options_.conntimeout_ms), "LibCurl::apply", "CURLOPT_CONNECTTIMEOUT_MS");
+    curlSetOpt(curl, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(options_.low_speed_limit), "LibCurl::apply", "CURLOPT_LOW_SPEED_LIMIT");
+    curlSetOpt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(options_.low_speed_time), "LibCurl::apply", "CURLOPT_LOW_SPEED_TIME");
+    if (options_.compression)
+    {
+      curlSetOpt(curl, CURLOPT_ACCEPT_ENCODING, options_.accept_encoding.c_str(), "LibCurl::apply", "CURLOPT_ACCEPT_ENCODING");
+    }
+    if (!login_.empty())
+    {
+      curlSetOpt(curl, CURLOPT_USERNAME, login_.c_str(), "LibCurl::apply", "CURLOPT_USERNAME");
+      curlSetOpt(curl, CURLOPT_PASSWORD, passw_.c_str(), "LibCurl::apply", "CURLOPT_PASSWORD");
+    }
+    if (headers_)
+    {
+      curlSetOpt(curl, CURLOPT_ENCODING, encoding_.c_str(), "LibCurl::apply", "CURLOPT_ENCODING");
+      curlSetOpt(curl, CURLOPT_HTTPHEADER, headers_.get(), "LibCurl::apply", "CURLOPT_HTTPHEADER");
+      curlSetOpt(curl, CURLOPT_HEADER, 1L, "LibCurl::apply", "CURLOPT_HEADER");
+    }
+
+    curlSetOpt(curl, CURLOPT_ERRORBUFFER, handle.error.data(), "LibCurl::apply", "CURLOPT_ERRORBUFFER");
+    curlSetOpt(curl, CURLOPT_WRITEFUNCTION, bodyWriter, "LibCurl::apply", "CURLOPT_WRITEFUNCTION");
+    curlSetOpt(curl, CURLOPT_WRITEDATA, &handle, "LibCurl::apply", "CURLOPT_WRITEDATA");
+
+    handle.headers = headers_;
+    handle.timeout_ms = handle.current_timeout_ms = options_.timeout_ms;
+    handle.conntimeout_ms = handle.current_conntimeout_ms = options_.conntimeout_ms;
+    handle.generation = generation_.load(std::memory_order_relaxed);
+  }
+
+  /** @brief the timeouts of the request are set only if changed (the deadline of the previous request) */
+  static void setTimeOuts(Handle &handle, std::uint32_t timeout_ms)
+  {
+    auto timeout = handle.timeout_ms;
+    auto conntimeout = handle.conntimeout_ms;
+    if (timeout_ms != 0)
+    {
+      timeout = (timeout == 0) ? timeout_ms : std::min(timeout, timeout_ms);
+      if (conntimeout == 0 || conntimeout > timeout)
+      {
+        conntimeout = timeout;
+      }
+    }
+
+    auto *curl = handle.curl.get();
+    if (timeout != handle.current_timeout_ms)
+    {
+      curlSetOpt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout), "LibCurl::get", "CURLOPT_TIMEOUT_MS");
+      handle.current_timeout_ms = timeout;
+    }
+    if (conntimeout != handle.current_conntimeout_ms)
+    {
+      curlSetOpt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(conntimeout), "LibCurl::get", "CURLOPT_CONNECTTIMEOUT_MS");
+      handle.current_conntimeout_ms = conntimeout;
+    }
+  }
+
+  /** @brief change the options under the lock, the handles apply them on the next checkout */
+  template <typename F>
+  void update(F &&f)
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    f();
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+
   /** @brief throw curl error
    * @param code - return code libcurl function
    * @param source - source error
    * @param optname - name option
    */
-  void throwCurlError(CURLcode code, const std::string &source, const std::string &optname)
+  static void throwCurlError(CURLcode code, const std::string &source, const std::string &optname)
   {
     auto str = curl_easy_strerror(code);
     std::ostringstream err;
@@ -261,61 +516,105 @@ class LibCurl::Impl final
     throw std::runtime_error(err.str());
   }
 
-  void throwCurlError(CURLcode code, std::string &&source, std::string &&optname) { throwCurlError(code, source, optname); }
-
+  /** @brief the names are the literals: the option of the every request is set without the allocation */
   template <typename T>
-  void curlSetOpt(std::uint32_t opt, T t, std::string &&source, std::string &&optname)
+  static void curlSetOpt(CURL *curl, std::uint32_t opt, T t, const char *source, const char *optname)
   {
-    auto ret = curl_easy_setopt(curl_.get(), static_cast<CURLoption>(opt), t);
+    auto ret = curl_easy_setopt(curl, static_cast<CURLoption>(opt), t);
     if (CURLE_OK != ret)
     {
       throwCurlError(ret, source, optname);
     }
   }
 
-  /** @brief callback writer function */
-  static std::size_t writer(char *data, std::size_t size, std::size_t nmemb, void *buffer)
+  /** @brief callback writer function, the first chunk reserves the buffer by Content-Length */
+  static std::size_t bodyWriter(char *data, std::size_t size, std::size_t nmemb, void *handle)
   {
-    auto result = static_cast<std::size_t>(0);
-
-    std::string *ptr = static_cast<std::string *>(buffer);
+    auto *ptr = static_cast<Handle *>(handle);
+    if (!ptr->body)
+    {
+      return size * nmemb;
+    }
 
-    if (ptr)
+    if (ptr->body->empty())
     {
-      ptr->append(data, size * nmemb);
-      result = size * nmemb;
+      curl_off_t length = -1;
+      if (curl_easy_getinfo(ptr->curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length > 0)
+      {
+        ptr->body->reserve(static_cast<std::size_t>(length));
+      }
     }
 
-    return result;
+    ptr->body->append(data, size * nmemb);
+    return size * nmemb;
   }
 
  private:
-  CurlPtr curl_;
-  CurlListPtr curl_list_;
+  /** @brief the options, the headers and the credentials are changed by the setters under the lock */
+  LibCurlOptions options_;
+  std::string login_;
+  std::string passw_;
+  std::string encoding_;
+  std::shared_ptr<curl_slist> headers_;
   std::mutex lock_;
+  std::atomic<std::uint64_t> generation_{1};
+
+  const std::size_t size_;
+  SlotsPtr slots_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 LibCurl::LibCurl()
- : impl_(new Impl())
+ : impl_(new Impl(LibCurlOptions()))
 {
 }
 //------------------------------------------------------------------------------
-std::tuple<std::string, long> LibCurl::get(const std::string &url) { return impl_->get(url); }
+LibCurl::LibCurl(const LibCurlOptions &options)
+ : impl_(new Impl(options))
+{
+}
+//------------------------------------------------------------------------------
+std::tuple<std::string, long> LibCurl::get(const std::string &url)
+{
+  std::string body;
+  const auto code = impl_->get(url, body, 0);
+  return std::make_tuple(std::move(body), code);
+}
+//------------------------------------------------------------------------------
+long LibCurl::get(const std::string &url, std::string &body, std::uint32_t timeout_ms) { return impl_->get(url, body, timeout_ms); }
 //------------------------------------------------------------------------------
 std::tuple<std::string, long> LibCurl::post(const std::string &url) { return impl_->post(url); }
 //------------------------------------------------------------------------------
+long LibCurl::head(const std::string &url) { return impl_->head(url); }
+//------------------------------------------------------------------------------
 void LibCurl::verbose(bool enable) { impl_->verbose(enable); }
 //------------------------------------------------------------------------------
 void LibCurl::setTimeOut(std::uint32_t t) { impl_->setTimeOut(t); }
 //------------------------------------------------------------------------------
 void LibCurl::setConnTimeOut(std::uint32_t t) { impl_->setConnTimeOut(t); }
 //------------------------------------------------------------------------------
+void LibCurl::setTimeOutMs(std::uint32_t t) { impl_->setTimeOutMs(t); }
+//------------------------------------------------------------------------------
+void LibCurl::setConnTimeOutMs(std::uint32_t t) { impl_->setConnTimeOutMs(t); }
+//------------------------------------------------------------------------------
+void LibCurl::setLowSpeed(std::uint32_t limit, std::uint32_t time) { impl_->setLowSpeed(limit, time); }
+//------------------------------------------------------------------------------
+void LibCurl::setAcceptEncoding(const std::string &encoding) { impl_->setAcceptEncoding(encoding); }
+//------------------------------------------------------------------------------
+std::uint64_t LibCurl::lastWireSize() const { return last_wire_size; }
+//------------------------------------------------------------------------------
 void LibCurl::setHeaders(const std::string &encoding, const Headers &h) { impl_->setHeaders(encoding, h); }
 //------------------------------------------------------------------------------
 void LibCurl::setUserPassw(const std::string &login, const std::string &passw) { impl_->setUserPassw(login, passw); }
 //------------------------------------------------------------------------------
-std::string LibCurl::escapeUrl(const std::string &url) { return impl_->escapeUrl(url); }
+std::string LibCurl::escapeUrl(const std::string &url)
+{
+  std::string result;
+  Impl::escapeUrl(url, result);
+  return result;
+}
+//------------------------------------------------------------------------------
+void LibCurl::escapeUrl(const std::string &url, std::string &out) { Impl::escapeUrl(url, out); }
 //------------------------------------------------------------------------------
 }  // namespace curl
 }  // namespace utils
@@ -0,0 +1,420 @@
+/** @file multiplexer.cpp
+ * @brief The implementation of the class Multiplexer
+ * @author agent
+ * @date 19.10.2026
+ */
+// this
+#include "utils/libcurl/multiplexer.h"
+
+// std
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// curl
+#include <curl/curl.h>
+
+// this
+#include "utils/libcurl/libcurl.h"
+
+namespace geocoder
+{
+namespace utils
+{
+namespace curl
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief the options as the part of the key of the shared multiplexer */
+std::string optionsKey(const MultiplexerOptions &options)
+{
+  std::ostringstream out;
+  out << MultiplexerOptions::versionToText(options.version) << ' ' << options.max_connections << ' ' << options.max_streams << ' '
+      << options.timeout_ms << ' ' << options.conntimeout_ms << ' ' << options.low_speed_limit << ' ' << options.low_speed_time << ' '
+      << options.verbose << ' ' << options.compression << ' ' << options.accept_encoding << '\n' << options.cainfo;
+  return out.str();
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+MultiplexerOptions::HttpVersion MultiplexerOptions::textToVersion(const std::string &text)
+{
+  if (text == "1.1")
+  {
+    return HttpVersion::http1_1;
+  }
+  else if (text == "2")
+  {
+    return HttpVersion::http2;
+  }
+  else if (text == "2-prior-knowledge")
+  {
+    return HttpVersion::http2_prior_knowledge;
+  }
+  else
+  {
+    throw std::runtime_error("[MultiplexerOptions::textToVersion]: unknown http version '" + text + "'");
+  }
+}
+//--------------------------------------------------------------------------------------------
+std::string MultiplexerOptions::versionToText(HttpVersion version)
+{
+  switch (version)
+  {
+    case HttpVersion::http1_1:
+      return "1.1";
+    case HttpVersion::http2:
+      return "2";
+    case HttpVersion::http2_prior_knowledge:
+      return "2-prior-knowledge";
+    default:
+      throw std::runtime_error("[MultiplexerOptions::versionToText]: unknown http version");
+  }
+}
+//--------------------------------------------------------------------------------------------
+Multiplexer::~Multiplexer() = default;
+//--------------------------------------------------------------------------------------------
+class Multiplexer::Impl final
+{
+  using Result = std::tuple<std::string, long>;
+  using Transfer = std::tuple<std::string, long, std::uint64_t>;
+
+  /** @brief the one transfer */
+  struct Request
+  {
+    std::string url;
+    std::string body;
+    std::array<char, CURL_ERROR_SIZE> error{};
+    std::promise<Transfer> result;
+    CURL *handle{nullptr};
+    /** @brief milliseconds, 0 - the timeout of the options */
+    std::uint32_t timeout_ms{0};
+    /** @brief the head request on the new connection (the warm-up) */
+    bool head{false};
+  };
+
+  using RequestPtr = std::unique_ptr<Request>;
+
+ public:
+  explicit Impl(const MultiplexerOptions &options)
+   : options_(options)
+  {
+    if (!globalInit())
+    {
+      throw std::runtime_error("[Multiplexer::Impl]: failed global initialization.");
+    }
+
+    multi_ = curl_multi_init();
+    if (!multi_)
+    {
+      throw std::runtime_error("[Multiplexer::Impl]: failed 'curl_multi_init()'.");
+    }
+
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(options_.max_connections));
+    curl_multi_setopt(multi_, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(options_.max_streams));
+
+    thread_ = std::thread([this] { run(); });
+  }
+
+  ~Impl()
+  {
+    stop_ = true;
+    curl_multi_wakeup(multi_);
+    thread_.join();
+
+    for (auto *i : free_)
+    {
+      curl_easy_cleanup(i);
+    }
+
+    curl_multi_cleanup(multi_);
+  }
+
+  Result get(const std::string &url, std::uint64_t &wire, std::uint32_t timeout_ms)
+  {
+    RequestPtr request(new Request);
+    request->url = url;
+    request->timeout_ms = timeout_ms;
+    auto result = request->result.get_future();
+
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      pending_.push_back(std::move(request));
+    }
+    curl_multi_wakeup(multi_);
+
+    auto transfer = result.get();
+    wire = std::get<2>(transfer);
+    return std::make_tuple(std::move(std::get<0>(transfer)), std::get<1>(transfer));
+  }
+
+  void warmup(const std::string &url, std::size_t count)
+  {
+    std::vector<std::future<Transfer>> results;
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        RequestPtr request(new Request);
+        request->url = url;
+        request->head = true;
+        results.push_back(request->result.get_future());
+        pending_.push_back(std::move(request));
+      }
+    }
+    curl_multi_wakeup(multi_);
+
+    for (auto &i : results)
+    {
+      i.get();
+    }
+  }
+
+  std::size_t connections() const { return connections_; }
+
+ private:
+  static std::size_t writer(char *data, std::size_t size, std::size_t nmemb, void *buffer)
+  {
+    static_cast<std::string *>(buffer)->append(data, size * nmemb);
+    return size * nmemb;
+  }
+
+  long httpVersion() const
+  {
+    switch (options_.version)
+    {
+      case MultiplexerOptions::HttpVersion::http1_1:
+        return CURL_HTTP_VERSION_1_1;
+      case MultiplexerOptions::HttpVersion::http2:
+        return CURL_HTTP_VERSION_2TLS;
+      case MultiplexerOptions::HttpVersion::http2_prior_knowledge:
+        return CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+      default:
+        throw std::runtime_error("[Multiplexer::Impl::httpVersion]: unknown http version");
+    }
+  }
+
+  /** @brief the easy handle for the request (reused between transfers) */
+  CURL *createHandle(Request *request)
+  {
+    CURL *handle = nullptr;
+    if (!free_.empty())
+    {
+      handle = free_.back();
+      free_.pop_back();
+      curl_easy_reset(handle);
+    }
+    else
+    {
+      handle = curl_easy_init();
+      if (!handle)
+      {
+        throw std::runtime_error("[Multiplexer::Impl]: failed 'curl_easy_init()'.");
+      }
+    }
+
+    curl_easy_setopt(handle, CURLOPT_URL, request->url.c_str());
+    curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, request->error.data());
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writer);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &request->body);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, request);
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, httpVersion());
+    if (request->head)
+    {
+      // the parallel warm-up requests open the own connections (up to 'max_connections')
+      curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+    }
+    else
+    {
+      // wait for the multiplexing on the existing connection instead of opening new one
+      curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    }
+    // the connection is not longer than the request, 0 - no timeout (the default of curl for the connection)
+    const auto timeout_ms = request->timeout_ms ? request->timeout_ms : options_.timeout_ms;
+    auto conntimeout_ms = options_.conntimeout_ms;
+    if (timeout_ms && (!conntimeout_ms || conntimeout_ms > timeout_ms))
+    {
+      conntimeout_ms = timeout_ms;
+    }
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout_ms));
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(conntimeout_ms));
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(options_.low_speed_limit));
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, static_cast<long>(options_.low_speed_time));
+    curl_easy_setopt(handle, CURLOPT_VERBOSE, static_cast<long>(options_.verbose));
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    if (options_.compression)
+    {
+      curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, options_.accept_encoding.c_str());
+    }
+    if (!options_.cainfo.empty())
+    {
+      curl_easy_setopt(handle, CURLOPT_CAINFO, options_.cainfo.c_str());
+    }
+
+    return handle;
+  }
+
+  void complete(CURL *handle, CURLcode code)
+  {
+    Request *ptr = nullptr;
+    curl_easy_getinfo(handle, CURLINFO_PRIVATE, &ptr);
+
+    auto it = active_.find(ptr);
+    RequestPtr request = std::move(it->second);
+    active_.erase(it);
+
+    long connects = 0;
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+    connections_ += static_cast<std::size_t>(connects);
+
+    long response_code = 0;
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
+
+    curl_off_t wire = 0;
+    curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+
+    curl_multi_remove_handle(multi_, handle);
+    free_.push_back(handle);
+
+    if (CURLE_OK != code)
+    {
+      std::ostringstream err;
+      err << "[Multiplexer::get]: " << curl_easy_strerror(code);
+      if (request->error[0])
+      {
+        err << ", " << request->error.data();
+      }
+      request->result.set_exception(std::make_exception_ptr(std::runtime_error(err.str())));
+    }
+    else
+    {
+      request->result.set_value(std::make_tuple(std::move(request->body), response_code, static_cast<std::uint64_t>(wire)));
+    }
+  }
+
+  void run()
+  {
+    while (!stop_)
+    {
+      std::deque<RequestPtr> pending;
+      {
+        std::lock_guard<std::mutex> locker(lock_);
+        std::swap(pending, pending_);
+      }
+
+      for (auto &i : pending)
+      {
+        try
+        {
+          i->handle = createHandle(i.get());
+          curl_multi_add_handle(multi_, i->handle);
+          active_.emplace(i.get(), std::move(i));
+        }
+        catch (const std::exception &)
+        {
+          i->result.set_exception(std::current_exception());
+        }
+      }
+
+      int running = 0;
+      curl_multi_perform(multi_, &running);
+
+      int queued = 0;
+      while (CURLMsg *msg = curl_multi_info_read(multi_, &queued))
+      {
+        if (msg->msg == CURLMSG_DONE)
+        {
+          complete(msg->easy_handle, msg->data.result);
+        }
+      }
+
+      curl_multi_poll(multi_, nullptr, 0, 100, nullptr);
+    }
+
+    // fail the rest requests
+    const auto fail = [](Request &request) {
+      request.result.set_exception(std::make_exception_ptr(std::runtime_error("[Multiplexer::get]: multiplexer is stopped")));
+    };
+
+    for (auto &i : active_)
+    {
+      curl_multi_remove_handle(multi_, i.second->handle);
+      curl_easy_cleanup(i.second->handle);
+      fail(*i.second);
+    }
+    active_.clear();
+
+    std::lock_guard<std::mutex> locker(lock_);
+    for (auto &i : pending_)
+    {
+      fail(*i);
+    }
+  }
+
+ private:
+  const MultiplexerOptions options_;
+  CURLM *multi_{nullptr};
+  std::thread thread_;
+  std::atomic<bool> stop_{false};
+  std::atomic<std::size_t> connections_{0};
+
+  std::mutex lock_;
+  std::deque<RequestPtr> pending_;
+  // the next members are used only by the thread of the multiplexer
+  std::map<Request *, RequestPtr> active_;
+  std::vector<CURL *> free_;
+};
+//--------------------------------------------------------------------------------------------
+Multiplexer::Multiplexer(const MultiplexerOptions &options)
+ : impl_(new Impl(options))
+{
+}
+//--------------------------------------------------------------------------------------------
+std::tuple<std::string, long> Multiplexer::get(const std::string &url)
+{
+  std::uint64_t wire = 0;
+  return impl_->get(url, wire, 0);
+}
+//--------------------------------------------------------------------------------------------
+std::tuple<std::string, long> Multiplexer::get(const std::string &url, std::uint64_t &wire) { return impl_->get(url, wire, 0); }
+//--------------------------------------------------------------------------------------------
+std::tuple<std::string, long> Multiplexer::get(const std::string &url, std::uint64_t &wire, std::uint32_t timeout_ms)
+{
+  return impl_->get(url, wire, timeout_ms);
+}
+//--------------------------------------------------------------------------------------------
+void Multiplexer::warmup(const std::string &url, std::size_t count) { impl_->warmup(url, count); }
+//--------------------------------------------------------------------------------------------
+std::size_t Multiplexer::connections() const { return impl_->connections(); }
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<Multiplexer> Multiplexer::shared(const std::string &key, const MultiplexerOptions &options)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<Multiplexer>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  // the geocoders with the same key and the different options do not share the connections
+  auto &item = registry[key + '\n' + optionsKey(options)];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<Multiplexer>(options);
+    item = result;
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace curl
+}  // namespace utils
+}  // namespace geocoder
@@ -0,0 +1,186 @@
+/** @file limiter.cpp
+ *  @brief the implementation of the class Limiter
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/limiter.h"
+
+// std
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+
+// this
+#include "utils/logger/logger.h"
+#include "utils/metrics.h"
+
+namespace geocoder
+{
+namespace utils
+{
+//--------------------------------------------------------------------------------------------
+LimiterOptions readLimiterOptions(const boost::property_tree::ptree &limiter)
+{
+  LimiterOptions result;
+  result.initial = limiter.get<std::size_t>("initial", result.initial);
+  result.min = limiter.get<std::size_t>("min", result.min);
+  result.max = limiter.get<std::size_t>("max", result.max);
+  result.backoff = limiter.get<double>("backoff", result.backoff);
+  result.tolerance = limiter.get<double>("tolerance", result.tolerance);
+
+  if (!result.min || result.min > result.max)
+  {
+    throw std::runtime_error("[readLimiterOptions]: invalid 'min' " + std::to_string(result.min) + ", 'max' " + std::to_string(result.max));
+  }
+  if (result.backoff <= 0.0 || result.backoff >= 1.0)
+  {
+    throw std::runtime_error("[readLimiterOptions]: 'backoff' is not in (0, 1)");
+  }
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+class Limiter::Impl final
+{
+ public:
+  Impl(const LimiterOptions &options, const std::string &metric)
+   : options_(options)
+   , limit_(static_cast<double>(std::min(std::max(options.initial, options.min), options.max)))
+   , gauge_(metric.empty() ? nullptr : &metrics::counter(metric))
+  {
+    publish();
+  }
+
+  boost::optional<Ticket> acquire(Clock::time_point deadline)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto free = [this] { return inflight_ < static_cast<std::size_t>(limit_); };
+    if (deadline == Clock::time_point::max())
+    {
+      cond_.wait(lock, free);
+    }
+    else if (!cond_.wait_until(lock, deadline, free))
+    {
+      return boost::none;
+    }
+    ++inflight_;
+
+    Ticket result;
+    result.start = Clock::now();
+    result.epoch = epoch_;
+    return result;
+  }
+
+  void release(const Ticket &ticket, Outcome outcome)
+  {
+    const auto latency = std::chrono::duration<double, std::micro>(Clock::now() - ticket.start).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --inflight_;
+
+      if (outcome == Outcome::success && options_.tolerance > 0.0)
+      {
+        if (baseline_ > 0.0 && latency > baseline_ * options_.tolerance)
+        {
+          outcome = Outcome::overload;
+        }
+        else
+        {
+          // the minimum latency, drifts up slowly to follow the change of the route
+          baseline_ = (baseline_ == 0.0 || latency < baseline_) ? latency : baseline_ + (latency - baseline_) / 100.0;
+        }
+      }
+
+      if (outcome == Outcome::success)
+      {
+        limit_ = std::min(limit_ + 1.0 / limit_, static_cast<double>(options_.max));
+      }
+      else if (outcome == Outcome::overload && ticket.epoch == epoch_)
+      {
+        limit_ = std::max(limit_ * options_.backoff, static_cast<double>(options_.min));
+        ++epoch_;
+        BOOST_LOG_SEV(geo_logger::get(), logger::Severity::debug) << "[Limiter::release]: overload, limit " << limit_;
+      }
+      publish();
+    }
+
+    cond_.notify_all();
+  }
+
+  std::size_t limit() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(limit_);
+  }
+
+  std::size_t inflight() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inflight_;
+  }
+
+ private:
+  void publish()
+  {
+    if (gauge_)
+    {
+      gauge_->set(static_cast<std::uint64_t>(limit_));
+    }
+  }
+
+  const LimiterOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  double limit_;
+  std::size_t inflight_{0};
+  /** @brief the number of the decrease, the overload of the requests started before is not counted */
+  std::uint64_t epoch_{0};
+  /** @brief the minimum latency, microseconds (0 - unknown) */
+  double baseline_{0.0};
+  metrics::Counter *gauge_;
+};
+//--------------------------------------------------------------------------------------------
+Limiter::Limiter(const LimiterOptions &options, const std::string &metric)
+ : impl_(new Impl(options, metric))
+{
+}
+//--------------------------------------------------------------------------------------------
+Limiter::~Limiter() = default;
+//--------------------------------------------------------------------------------------------
+Limiter::Ticket Limiter::acquire() { return *impl_->acquire(Clock::time_point::max()); }
+//--------------------------------------------------------------------------------------------
+boost::optional<Limiter::Ticket> Limiter::acquire(Clock::time_point deadline) { return impl_->acquire(deadline); }
+//--------------------------------------------------------------------------------------------
+void Limiter::release(const Ticket &ticket, Outcome outcome) { impl_->release(ticket, outcome); }
+//--------------------------------------------------------------------------------------------
+std::size_t Limiter::limit() const { return impl_->limit(); }
+//--------------------------------------------------------------------------------------------
+std::size_t Limiter::inflight() const { return impl_->inflight(); }
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<Limiter> Limiter::shared(const std::string &key, const LimiterOptions &options, const std::string &metric)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<Limiter>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  auto &item = registry[key];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<Limiter>(options, metric);
+    item = result;
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace utils
+}  // namespace geocoder
@@ -0,0 +1,539 @@
+/** @file binary.cpp
+ *  @brief the implementation of the binary logger
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/logger/binary.h"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// this
+#include "utils/utils.h"
+
+namespace geocoder
+{
+namespace utils
+{
+namespace logger
+{
+namespace binary
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+const char magic[] = "GEOBLOG1";
+const std::size_t magic_size = sizeof(magic) - 1;
+
+enum class Block : std::uint8_t
+{
+  format = 'F',
+  records = 'R',
+  dropped = 'D'
+};
+//--------------------------------------------------------------------------------------------
+/** @class Ring
+ *  @brief single producer (the owner thread) single consumer (the flush thread) ring buffer
+ */
+class Ring final
+{
+ public:
+  Ring(std::size_t capacity, std::uint32_t thread)
+   : thread_(thread)
+  {
+    std::size_t size = 1024;
+    while (size < capacity)
+    {
+      size <<= 1;
+    }
+
+    data_.resize(size);
+    mask_ = size - 1;
+  }
+
+  /** @brief producer, record is dropped if the buffer is full */
+  bool push(const char *data, std::size_t size)
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_acquire);
+
+    if (data_.size() - (head - tail) < size)
+    {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    const auto pos = head & mask_;
+    const auto first = std::min(size, data_.size() - pos);
+    std::memcpy(data_.data() + pos, data, first);
+    std::memcpy(data_.data(), data + first, size - first);
+
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  /** @brief consumer, append all records to 'out' */
+  void drain(std::string &out)
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto size = static_cast<std::size_t>(head - tail);
+
+    const auto pos = tail & mask_;
+    const auto first = std::min(size, data_.size() - pos);
+    out.append(data_.data() + pos, first);
+    out.append(data_.data(), size - first);
+
+    tail_.store(head, std::memory_order_release);
+  }
+
+  bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+  std::uint64_t takeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+  std::uint32_t thread() const { return thread_; }
+
+ private:
+  std::vector<char> data_;
+  std::size_t mask_{0};
+  std::uint32_t thread_;
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> tail_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+using RingPtr = std::shared_ptr<Ring>;
+//--------------------------------------------------------------------------------------------
+/** @class BinaryLogger
+ *  @brief the registry of the ring buffers and the format strings, the flush thread
+ */
+class BinaryLogger final
+{
+ public:
+  static BinaryLogger &get()
+  {
+    static BinaryLogger instance;
+    return instance;
+  }
+
+  ~BinaryLogger() { stop(); }
+
+  void start(const config::Configuration &conf)
+  {
+    stop();
+
+    namespace fs = boost::filesystem;
+    const auto dir = fs::exists(conf.workdir) ? conf.workdir : fs::current_path();
+
+    auto filename = dir / generateFileName(conf.binary.prefix, "blog");
+    for (std::size_t i = 1; fs::exists(filename); ++i)
+    {
+      filename = dir / generateFileName(conf.binary.prefix + "_" + std::to_string(i), "blog");
+    }
+
+    fout_.open(filename.string(), std::ios::binary | std::ios::trunc);
+    if (!fout_.is_open())
+    {
+      throw std::runtime_error("[logger::binary::start]: failed open file '" + filename.string() + "'");
+    }
+
+    fout_.write(magic, magic_size);
+
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      rings_.clear();
+      written_formats_ = 0;
+      next_thread_ = 0;
+      buffer_ = conf.binary.buffer;
+      flush_ = std::chrono::milliseconds(std::max<std::uint32_t>(conf.binary.flush, 1));
+      stop_ = false;
+    }
+
+    min_rank_ = severityRank(conf.severity);
+    ++generation_;
+    running_ = true;
+
+    thread_ = std::thread([this] { run(); });
+  }
+
+  void stop()
+  {
+    if (!thread_.joinable())
+    {
+      return;
+    }
+
+    running_ = false;
+
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+
+    flush();
+    fout_.close();
+  }
+
+  bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+  bool isEnabled(Severity sev) const { return severityRank(sev) >= min_rank_.load(std::memory_order_relaxed); }
+
+  std::uint32_t registerFormat(const char *format)
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    formats_.emplace_back(format);
+    return static_cast<std::uint32_t>(formats_.size() - 1);
+  }
+
+  void push(const char *data, std::size_t size)
+  {
+    struct Local
+    {
+      RingPtr ring;
+      std::uint64_t generation{0};
+    };
+
+    thread_local Local local;
+
+    const auto generation = generation_.load(std::memory_order_acquire);
+    if (!local.ring || local.generation != generation)
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      local.ring = std::make_shared<Ring>(buffer_, next_thread_++);
+      local.generation = generation;
+      rings_.push_back(local.ring);
+    }
+
+    local.ring->push(data, size);
+  }
+
+ private:
+  BinaryLogger() = default;
+
+  void run()
+  {
+    std::unique_lock<std::mutex> locker(lock_);
+    while (!stop_)
+    {
+      cv_.wait_for(locker, flush_, [this] { return stop_; });
+
+      locker.unlock();
+      flush();
+      locker.lock();
+    }
+  }
+
+  void writeBlock(Block type, std::uint32_t a, std::uint32_t b, const char *payload, std::size_t size)
+  {
+    const auto t = static_cast<char>(type);
+    fout_.write(&t, 1);
+    fout_.write(reinterpret_cast<const char *>(&a), sizeof(a));
+    fout_.write(reinterpret_cast<const char *>(&b), sizeof(b));
+    fout_.write(payload, size);
+  }
+
+  /** @brief write new format strings, then records of the all threads */
+  void flush()
+  {
+    std::vector<RingPtr> rings;
+    std::vector<std::pair<std::uint32_t, std::string>> formats;
+
+    {
+      std::lock_guard<std::mutex> locker(lock_);
+      rings = rings_;
+      for (; written_formats_ < formats_.size(); ++written_formats_)
+      {
+        formats.emplace_back(static_cast<std::uint32_t>(written_formats_), formats_[written_formats_]);
+      }
+    }
+
+    for (const auto &i : formats)
+    {
+      writeBlock(Block::format, i.first, static_cast<std::uint32_t>(i.second.size()), i.second.data(), i.second.size());
+    }
+
+    for (const auto &i : rings)
+    {
+      buffer_records_.clear();
+      i->drain(buffer_records_);
+      if (!buffer_records_.empty())
+      {
+        writeBlock(Block::records, i->thread(), static_cast<std::uint32_t>(buffer_records_.size()), buffer_records_.data(), buffer_records_.size());
+      }
+
+      if (const auto dropped = i->takeDropped())
+      {
+        writeBlock(Block::dropped, i->thread(), static_cast<std::uint32_t>(dropped), nullptr, 0);
+      }
+    }
+
+    fout_.flush();
+    rings.clear();
+
+    // remove the ring buffers of the finished threads
+    std::lock_guard<std::mutex> locker(lock_);
+    rings_.erase(std::remove_if(std::begin(rings_), std::end(rings_), [](const auto &i) { return i.use_count() == 1 && i->empty(); }),
+                 std::end(rings_));
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  bool stop_{false};
+
+  std::vector<RingPtr> rings_;
+  std::vector<std::string> formats_;
+  std::size_t written_formats_{0};
+  std::uint32_t next_thread_{0};
+  std::size_t buffer_{1 << 20};
+  std::chrono::milliseconds flush_{100};
+
+  std::atomic<bool> running_{false};
+  std::atomic<int> min_rank_{0};
+  std::atomic<std::uint64_t> generation_{0};
+
+  std::ofstream fout_;
+  std::string buffer_records_;
+};
+//--------------------------------------------------------------------------------------------
+template <typename T>
+T read(const char *data)
+{
+  T result;
+  std::memcpy(&result, data, sizeof(T));
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+/** @brief the maximum size of the format (the literal of the source) */
+const std::uint32_t max_format = 1 << 16;
+//--------------------------------------------------------------------------------------------
+/** @brief read the payload of the block by the chunks: the memory is not taken ahead of the data of the truncated file
+ *  @throw std::runtime_error - unexpected end of file
+ */
+void readPayload(std::istream &in, std::uint32_t size, std::string &payload)
+{
+  const std::size_t chunk = 1 << 20;
+  payload.clear();
+  while (payload.size() < size)
+  {
+    const auto offset = payload.size();
+    payload.resize(offset + std::min<std::size_t>(chunk, size - offset));
+    if (!in.read(&payload[offset], static_cast<std::streamsize>(payload.size() - offset)))
+    {
+      throw std::runtime_error("[logger::binary::decode]: unexpected end of file");
+    }
+  }
+}
+//--------------------------------------------------------------------------------------------
+/** @brief the value of the fixed width argument, the value is not beyond the record */
+template <typename T>
+T readArg(const char *data, std::size_t size)
+{
+  if (1 + sizeof(T) > size)
+  {
+    throw std::runtime_error("[logger::binary::decode]: invalid argument");
+  }
+  return read<T>(data + 1);
+}
+//--------------------------------------------------------------------------------------------
+/** @brief render the argument, return the size of the encoded argument
+ *  @param size - the rest of the record
+ */
+std::size_t renderArg(const char *data, std::size_t size, std::ostream &out)
+{
+  if (size < 1)
+  {
+    throw std::runtime_error("[logger::binary::decode]: invalid argument");
+  }
+
+  const auto type = static_cast<ArgType>(data[0]);
+  switch (type)
+  {
+    case ArgType::int64:
+      out << readArg<std::int64_t>(data, size);
+      return 1 + sizeof(std::int64_t);
+    case ArgType::uint64:
+      out << readArg<std::uint64_t>(data, size);
+      return 1 + sizeof(std::uint64_t);
+    case ArgType::float64:
+      out << readArg<double>(data, size);
+      return 1 + sizeof(double);
+    case ArgType::boolean:
+      out << std::boolalpha << (readArg<std::uint8_t>(data, size) != 0);
+      return 1 + sizeof(std::uint8_t);
+    case ArgType::character:
+      out << readArg<char>(data, size);
+      return 1 + sizeof(char);
+    case ArgType::string:
+    {
+      const std::size_t len = readArg<std::uint16_t>(data, size);
+      if (1 + sizeof(std::uint16_t) + len > size)
+      {
+        throw std::runtime_error("[logger::binary::decode]: invalid argument");
+      }
+      out.write(data + 1 + sizeof(std::uint16_t), static_cast<std::streamsize>(len));
+      return 1 + sizeof(std::uint16_t) + len;
+    }
+    default:
+      throw std::runtime_error("[logger::binary::decode]: unknown type of argument");
+  }
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+void start(const config::Configuration &conf) { BinaryLogger::get().start(conf); }
+//--------------------------------------------------------------------------------------------
+void stop() { BinaryLogger::get().stop(); }
+//--------------------------------------------------------------------------------------------
+bool isRunning() { return BinaryLogger::get().isRunning(); }
+//--------------------------------------------------------------------------------------------
+bool isEnabled(Severity sev) { return BinaryLogger::get().isEnabled(sev); }
+//--------------------------------------------------------------------------------------------
+std::uint32_t registerFormat(const char *format) { return BinaryLogger::get().registerFormat(format); }
+//--------------------------------------------------------------------------------------------
+Encoder::Encoder(std::uint32_t id, Severity sev)
+{
+  RecordHeader header{};
+  header.id = id;
+  header.severity = static_cast<std::uint8_t>(sev);
+  std::memcpy(buffer_.data(), &header, sizeof(header));
+}
+//--------------------------------------------------------------------------------------------
+Encoder &Encoder::putString(const char *data, std::size_t size)
+{
+  const auto prefix = 1 + sizeof(std::uint16_t);
+  if (size_ + prefix > buffer_.size())
+  {
+    return *this;
+  }
+
+  const auto len = static_cast<std::uint16_t>(std::min(size, buffer_.size() - size_ - prefix));
+  buffer_[size_] = static_cast<char>(ArgType::string);
+  std::memcpy(buffer_.data() + size_ + 1, &len, sizeof(len));
+  std::memcpy(buffer_.data() + size_ + prefix, data, len);
+  size_ += prefix + len;
+  ++count_;
+
+  return *this;
+}
+//--------------------------------------------------------------------------------------------
+void Encoder::commit()
+{
+  RecordHeader header;
+  std::memcpy(&header, buffer_.data(), sizeof(header));
+  header.time = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+  header.size = static_cast<std::uint16_t>(size_ - sizeof(header));
+  header.count = count_;
+  std::memcpy(buffer_.data(), &header, sizeof(header));
+
+  BinaryLogger::get().push(buffer_.data(), size_);
+}
+//--------------------------------------------------------------------------------------------
+std::size_t decode(std::istream &in, std::ostream &out)
+{
+  std::array<char, magic_size> header;
+  if (!in.read(header.data(), header.size()) || !std::equal(std::begin(header), std::end(header), magic))
+  {
+    throw std::runtime_error("[logger::binary::decode]: is not binary log");
+  }
+
+  std::map<std::uint32_t, std::string> formats;
+  std::string payload;
+  std::size_t result = 0;
+
+  for (;;)
+  {
+    char type{};
+    std::uint32_t a{};
+    std::uint32_t b{};
+    if (!in.read(&type, 1))
+    {
+      break;
+    }
+
+    if (!in.read(reinterpret_cast<char *>(&a), sizeof(a)) || !in.read(reinterpret_cast<char *>(&b), sizeof(b)))
+    {
+      throw std::runtime_error("[logger::binary::decode]: unexpected end of file");
+    }
+
+    switch (static_cast<Block>(type))
+    {
+      case Block::format:
+        if (b > max_format)
+        {
+          throw std::runtime_error("[logger::binary::decode]: invalid format " + std::to_string(a));
+        }
+        readPayload(in, b, payload);
+        formats[a] = payload;
+        break;
+      case Block::dropped:
+        out << "[thread " << a << "]: dropped " << b << " records\n";
+        break;
+      case Block::records:
+      {
+        readPayload(in, b, payload);
+
+        std::size_t offset = 0;
+        while (offset + sizeof(RecordHeader) <= payload.size())
+        {
+          const auto record = read<RecordHeader>(payload.data() + offset);
+          offset += sizeof(RecordHeader);
+
+          const auto time = boost::posix_time::from_time_t(static_cast<std::time_t>(record.time / 1000000000ULL)) +
+                            boost::posix_time::microseconds((record.time % 1000000000ULL) / 1000);
+
+          out << "[" << boost::posix_time::to_iso_extended_string(time) << "][thread " << a << "]["
+              << severityToText(static_cast<Severity>(record.severity)) << "]: ";
+
+          const auto it = formats.find(record.id);
+          const std::string format = (it != formats.end()) ? it->second : "<unknown format " + std::to_string(record.id) + ">";
+
+          // substitute arguments into the placeholders
+          std::size_t pos = 0;
+          std::size_t arg = offset;
+          const auto end = offset + record.size;
+          if (end > payload.size())
+          {
+            throw std::runtime_error("[logger::binary::decode]: invalid record");
+          }
+          for (std::size_t i = 0; i < record.count; ++i)
+          {
+            const auto ph = format.find("{}", pos);
+            out.write(format.data() + pos, ((ph == std::string::npos) ? format.size() : ph) - pos);
+            pos = (ph == std::string::npos) ? format.size() : ph + 2;
+            arg += renderArg(payload.data() + arg, end - arg, out);
+          }
+          out.write(format.data() + pos, format.size() - pos);
+          out << "\n";
+
+          offset = end;
+          ++result;
+        }
+        break;
+      }
+      default:
+        throw std::runtime_error("[logger::binary::decode]: unknown block '" + std::string(1, type) + "'");
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace binary
+}  // namespace logger
+}  // namespace utils
+}  // namespace geocoder
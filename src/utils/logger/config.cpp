@@ -66,6 +66,11 @@ Configuration readFile(const boost::filesystem::path &filename)
         throw std::runtime_error("[logger::config::readFile]: invalid time type '" + time_type + "', filename ='" + filename.string() + "'");
       }
 
+      if (const auto severity = log_conf->get_optional<std::string>("severity"))
+      {
+        conf.severity = textToSeverity(*severity);
+      }
+
       if (const auto rotation = log_conf->get_child_optional("rotation"))
       {
         conf.rotation.period = rotation->get<std::uint32_t>("period");
@@ -86,6 +91,14 @@ Configuration readFile(const boost::filesystem::path &filename)
         }
       }
 
+      if (const auto binary = log_conf->get_child_optional("binary"))
+      {
+        conf.binary.enabled = binary->get<bool>("enabled", conf.binary.enabled);
+        conf.binary.prefix = binary->get<std::string>("prefix", conf.binary.prefix);
+        conf.binary.buffer = binary->get<std::size_t>("buffer", conf.binary.buffer);
+        conf.binary.flush = binary->get<std::uint32_t>("flush", conf.binary.flush);
+      }
+
       for (auto &i : conf.attributes)
       {
         auto key(std::get<0>(i));
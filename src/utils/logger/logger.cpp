@@ -8,7 +8,6 @@
 
 // std
 #include <array>
-#include <functional>
 #include <memory>
 #include <string>
 
@@ -31,6 +30,7 @@
 #include <boost/core/null_deleter.hpp>
 
 // this
+#include "utils/logger/binary.h"
 #include "utils/logger/config.h"
 #include "utils/utils.h"
 
@@ -55,6 +55,13 @@ namespace log = boost::log;
 //--------------------------------------------------------------------------------------------
 std::array<std::string, static_cast<int>(Severity::trace) + 1> text_sev{"INFO", "WARNING", "ERROR", "CRITICAL", "FATAL", "DEBUG", "TRACE"};
 //--------------------------------------------------------------------------------------------
+const std::string &severityToText(Severity sev)
+{
+  static const std::string unknown{"UNKNOWN"};
+  const auto index = static_cast<std::size_t>(sev);
+  return (index < text_sev.size()) ? text_sev[index] : unknown;
+}
+//--------------------------------------------------------------------------------------------
 using sev_log_t = sources::severity_logger_mt<Severity>;
 using file_sink_t = sinks::asynchronous_sink<sinks::text_file_backend>;
 using file_sink_ptr_t = boost::shared_ptr<file_sink_t>;
@@ -104,45 +111,157 @@ void init_attrs(const config::Configuration &conf)
   }
 }
 //--------------------------------------------------------------------------------------------
-// format message
-void format(const config::Configuration &conf, const log::record_view &record, log::formatting_ostream &os)
+/** @class Formatter
+ *  @brief format message directly into the sink stream
+ *  @details the attribute names and the enabled attributes are resolved once, the text
+ *  of the timestamp is cached per second (the formatter is called from the sink thread)
+ */
+class Formatter final
 {
-  auto sev = record.attribute_values()["Severity"].extract<Severity>().get();
-  auto text = text_sev[static_cast<int>(sev)];
+ public:
+  explicit Formatter(const config::Configuration &conf)
+   : timestamp_(conf.attributes.at(config::Configuration::AttributesValues::timestamp))
+   , thread_id_(conf.attributes.at(config::Configuration::AttributesValues::thread_id))
+   , process_id_(conf.attributes.at(config::Configuration::AttributesValues::process_id))
+   , timestamp_name_(config::Configuration::AttributesValues::timestamp)
+   , thread_id_name_(config::Configuration::AttributesValues::thread_id)
+   , process_id_name_(config::Configuration::AttributesValues::process_id)
+   , severity_name_("Severity")
+   , message_name_("Message")
+  {
+  }
 
-  std::ostringstream tmp;
+  void operator()(const log::record_view &record, log::formatting_ostream &os) const
+  {
+    const auto &values = record.attribute_values();
 
-  auto format_attr = [&tmp](const auto &val) { tmp << "[" << val << "]"; };
+    if (timestamp_)
+    {
+      if (const auto timestamp = extract<boost::posix_time::ptime>(values, timestamp_name_))
+      {
+        os << '[';
+        formatTimestamp(timestamp.get(), os);
+        os << ']';
+      }
+    }
 
-  const auto &attrs = conf.attributes;
+    if (thread_id_)
+    {
+      if (const auto thread_id = extract<log::attributes::current_thread_id::value_type>(values, thread_id_name_))
+      {
+        os << '[' << thread_id.get() << ']';
+      }
+    }
+
+    if (process_id_)
+    {
+      if (const auto process_id = extract<log::attributes::current_process_id::value_type>(values, process_id_name_))
+      {
+        os << '[' << process_id.get() << ']';
+      }
+    }
 
-  if (attrs.at(config::Configuration::AttributesValues::timestamp))
+    if (const auto sev = extract<Severity>(values, severity_name_))
+    {
+      const auto &text = severityToText(sev.get());
+      os << '[';
+      os.write(text.data(), text.size());
+      os << ']';
+    }
+
+    if (const auto msg = extract<std::string>(values, message_name_))
+    {
+      os.write(": ", 2);
+      os.write(msg.get().data(), msg.get().size());
+    }
+  }
+
+ private:
+  template <typename T>
+  static log::value_ref<T> extract(const log::attribute_value_set &values, const log::attribute_name &name)
   {
-    const auto timestamp = log::extract<boost::posix_time::ptime>("TimeStamp", record).get();
-    format_attr(boost::posix_time::to_iso_extended_string(timestamp));
+    const auto it = values.find(name);
+    if (it == values.end())
+    {
+      return log::value_ref<T>();
+    }
+
+    return it->second.extract<T>();
   }
 
-  if (attrs.at(config::Configuration::AttributesValues::thread_id))
+  static void formatTimestamp(const boost::posix_time::ptime &t, log::formatting_ostream &os)
   {
-    const auto thread_id =
-        log::extract<log::attributes::current_thread_id::value_type>(config::Configuration::AttributesValues::thread_id.data(), record).get();
-    format_attr(thread_id);
+    struct Cache
+    {
+      long long second{-1};
+      std::string text;
+    };
+
+    thread_local Cache cache;
+
+    const auto tod = t.time_of_day();
+    const auto second = static_cast<long long>(t.date().day_number()) * 86400 + tod.total_seconds();
+    if (second != cache.second)
+    {
+      cache.second = second;
+      cache.text = boost::posix_time::to_iso_extended_string(boost::posix_time::ptime(t.date(), boost::posix_time::seconds(tod.total_seconds())));
+    }
+
+    os.write(cache.text.data(), cache.text.size());
+
+    // fractional seconds, zero padded
+    const auto digits = boost::posix_time::time_duration::num_fractional_digits();
+    std::array<char, 16> frac;
+    auto value = tod.fractional_seconds();
+    frac[0] = '.';
+    for (auto i = digits; i > 0; --i)
+    {
+      frac[i] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+    os.write(frac.data(), digits + 1);
   }
 
-  if (attrs.at(config::Configuration::AttributesValues::process_id))
+ private:
+  bool timestamp_;
+  bool thread_id_;
+  bool process_id_;
+  log::attribute_name timestamp_name_;
+  log::attribute_name thread_id_name_;
+  log::attribute_name process_id_name_;
+  log::attribute_name severity_name_;
+  log::attribute_name message_name_;
+};
+//--------------------------------------------------------------------------------------------
+/** @class SeverityFilter
+ *  @brief the core filter, discard records below minimum severity
+ *  @details the core filter is checked before the message is formatted by BOOST_LOG_SEV
+ */
+class SeverityFilter final
+{
+ public:
+  explicit SeverityFilter(Severity min)
+   : min_(severityRank(min))
+   , severity_name_("Severity")
   {
-    const auto process_id =
-        log::extract<log::attributes::current_process_id::value_type>(config::Configuration::AttributesValues::process_id.data(), record).get();
-    format_attr(process_id);
   }
 
-  format_attr(text);
+  bool operator()(const log::attribute_value_set &values) const
+  {
+    const auto it = values.find(severity_name_);
+    if (it == values.end())
+    {
+      return true;
+    }
 
-  const auto msg = record.attribute_values()["Message"].extract<std::string>().get();
-  tmp << ": " << msg;
+    const auto sev = it->second.extract<Severity>();
+    return !sev || severityRank(sev.get()) >= min_;
+  }
 
-  os << tmp.str();
-}
+ private:
+  int min_;
+  log::attribute_name severity_name_;
+};
 //--------------------------------------------------------------------------------------------
 file_sink_ptr_t createFileSink(const config::Configuration &conf)
 {
@@ -180,8 +299,7 @@ file_sink_ptr_t createFileSink(const config::Configuration &conf)
   }
 
   auto tmp = boost::make_shared<file_sink_t>(backend);
-  auto fn = std::bind(format, conf, std::placeholders::_1, std::placeholders::_2);
-  tmp->set_formatter(fn);
+  tmp->set_formatter(Formatter(conf));
 
   return tmp;
 }
@@ -192,8 +310,7 @@ debug_sink_ptr_t createDebugSink(const config::Configuration &conf)
   debug_backend->add_stream(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
   debug_backend->auto_flush();
   auto sink = boost::make_shared<debug_sink_t>(debug_backend);
-  auto fn = std::bind(format, conf, std::placeholders::_1, std::placeholders::_2);
-  sink->set_formatter(fn);
+  sink->set_formatter(Formatter(conf));
 
   return sink;
 }
@@ -206,6 +323,8 @@ void initLog(const config::Configuration &conf)
 
   auto core = log::core::get();
 
+  core->set_filter(SeverityFilter(conf.severity));
+
   // create file sink
   auto file_sink = createFileSink(conf);
 
@@ -218,6 +337,11 @@ void initLog(const config::Configuration &conf)
   }
 
   core->add_sink(file_sink);
+
+  if (conf.binary.enabled)
+  {
+    binary::start(conf);
+  }
 }
 //--------------------------------------------------------------------------------------------
 /** @brief implementation of the class Logger */
@@ -227,6 +351,8 @@ void Logger::init()
   initLog(config::Configuration());
 }
 //--------------------------------------------------------------------------------------------
+void Logger::init(const config::Configuration &conf) { initLog(conf); }
+//--------------------------------------------------------------------------------------------
 void Logger::initFromFile(const boost::filesystem::path &filename)
 {
   const auto conf = config::readFile(filename);
@@ -0,0 +1,89 @@
+/** @file metrics.cpp
+ *  @brief the implementation of the process wide named counters
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/metrics.h"
+
+// std
+#include <memory>
+#include <mutex>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace metrics
+{
+//--------------------------------------------------------------------------------------------
+namespace
+{
+class Registry final
+{
+ public:
+  static Registry &instance()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  Counter &counter(const std::string &name)
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+
+    auto &item = counters_[name];
+    if (!item)
+    {
+      item.reset(new Counter);
+    }
+
+    return *item;
+  }
+
+  Snapshot snapshot()
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+
+    Snapshot result;
+    for (const auto &i : counters_)
+    {
+      result.emplace(i.first, i.second->value());
+    }
+
+    return result;
+  }
+
+  void reset()
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+
+    for (auto &i : counters_)
+    {
+      i.second->reset();
+    }
+  }
+
+ private:
+  std::mutex lock_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+};
+}  // namespace
+//--------------------------------------------------------------------------------------------
+Counter &counter(const std::string &name) { return Registry::instance().counter(name); }
+//--------------------------------------------------------------------------------------------
+Snapshot snapshot() { return Registry::instance().snapshot(); }
+//--------------------------------------------------------------------------------------------
+void reset() { Registry::instance().reset(); }
+//--------------------------------------------------------------------------------------------
+void print(std::ostream &out, const Snapshot &values)
+{
+  for (const auto &i : values)
+  {
+    out << i.first << " " << i.second << "\n";
+  }
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace metrics
+}  // namespace utils
+}  // namespace geocoder
@@ -0,0 +1,151 @@
+/** @file negative_cache.cpp
+ *  @brief the implementation of the class NegativeCache
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/negative_cache.h"
+
+// std
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+
+// this
+#include "utils/metrics.h"
+
+namespace geocoder
+{
+namespace utils
+{
+//--------------------------------------------------------------------------------------------
+NegativeCacheOptions readNegativeCacheOptions(const boost::property_tree::ptree &cache)
+{
+  NegativeCacheOptions result;
+  result.ttl = std::chrono::seconds(cache.get<std::uint32_t>("ttl", static_cast<std::uint32_t>(result.ttl.count())));
+  result.size = cache.get<std::size_t>("size", result.size);
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+class NegativeCache::Impl final
+{
+  struct Entry
+  {
+    std::string key;
+    Clock::time_point expire;
+  };
+
+  using List = std::list<Entry>;
+
+ public:
+  explicit Impl(const NegativeCacheOptions &options)
+   : options_(options)
+   , hits_(metrics::counter("negative_cache.hits"))
+   , gauge_(metrics::counter("negative_cache.size"))
+  {
+  }
+
+  bool contains(const std::string &key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = index_.find(key);
+    if (it == index_.end())
+    {
+      return false;
+    }
+    if (it->second->expire <= Clock::now())
+    {
+      lru_.erase(it->second);
+      index_.erase(it);
+      gauge_.set(index_.size());
+      return false;
+    }
+
+    // the most recently used is the first
+    lru_.splice(lru_.begin(), lru_, it->second);
+    hits_.add();
+    return true;
+  }
+
+  void insert(const std::string &key)
+  {
+    if (options_.size == 0)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto expire = Clock::now() + options_.ttl;
+    const auto it = index_.find(key);
+    if (it != index_.end())
+    {
+      it->second->expire = expire;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+
+    if (index_.size() >= options_.size)
+    {
+      index_.erase(lru_.back().key);
+      lru_.pop_back();
+    }
+    lru_.push_front(Entry{key, expire});
+    index_.emplace(key, lru_.begin());
+    gauge_.set(index_.size());
+  }
+
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+  }
+
+ private:
+  const NegativeCacheOptions options_;
+
+  mutable std::mutex mutex_;
+  List lru_;
+  std::unordered_map<std::string, List::iterator> index_;
+  metrics::Counter &hits_;
+  metrics::Counter &gauge_;
+};
+//--------------------------------------------------------------------------------------------
+NegativeCache::NegativeCache(const NegativeCacheOptions &options)
+ : impl_(new Impl(options))
+{
+}
+//--------------------------------------------------------------------------------------------
+NegativeCache::~NegativeCache() = default;
+//--------------------------------------------------------------------------------------------
+bool NegativeCache::contains(const std::string &key) { return impl_->contains(key); }
+//--------------------------------------------------------------------------------------------
+void NegativeCache::insert(const std::string &key) { impl_->insert(key); }
+//--------------------------------------------------------------------------------------------
+std::size_t NegativeCache::size() const { return impl_->size(); }
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<NegativeCache> NegativeCache::shared(const std::string &key, const NegativeCacheOptions &options)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<NegativeCache>> registry;
+
+  std::lock_guard<std::mutex> locker(lock);
+
+  auto &item = registry[key];
+  auto result = item.lock();
+  if (!result)
+  {
+    result = std::make_shared<NegativeCache>(options);
+    item = result;
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace utils
+}  // namespace geocoder
@@ -20,8 +20,7 @@ namespace geocoder
 namespace utils
 {
 //--------------------------------------------------------------------------------------------
-bool parseCmd(int argc, char *argv[], boost::filesystem::path &config_filename, std::string &address, boost::filesystem::path &addr_filename,
-              boost::filesystem::path &outfile)
+bool parseCmd(int argc, char *argv[], CmdOptions &options)
 {
   namespace bp = boost::program_options;
 
@@ -34,31 +33,174 @@ bool parseCmd(int argc, char *argv[], boost::filesystem::path &config_filename,
   std::string address_fname;
   std::string addr;
   std::string output;
+  std::string record;
+  std::string replay;
+  std::string reverse;
+  std::string index;
+  double max_distance = 0.0;
+  std::string complete;
+  std::size_t top = 10;
+  std::string format = "text";
+  std::string serve;
+  bool stream = false;
+  std::string journal;
+  bool resume = false;
+  std::string shard;
+  std::string shard_by = "line";
 
   option_desc.add_options()("help,h", "Display the program usage and exit")("version,v", "Display the program version and exit")(
       "config,c", bp::value<std::string>(&config)->required(), "Configuration file name (required)")(
       "addr_file,A", bp::value<std::string>(&address_fname), "Address file name (optional)")(
-      "address,a", bp::value<std::string>(&addr), "address (optional)")("output,o", bp::value<std::string>(&output), "output file (optional)");
+      "address,a", bp::value<std::string>(&addr), "address (optional)")("output,o", bp::value<std::string>(&output), "output file (optional)")(
+      "record", bp::value<std::string>(&record), "Directory for recording responses of the geocoders (optional)")(
+      "replay", bp::value<std::string>(&replay), "Directory with recorded responses, geocoding without network (optional)")(
+      "reverse,r", bp::value<std::string>(&reverse), "File with points 'latitude longitude', reverse geocoding by local index (optional)")(
+      "index", bp::value<std::string>(&index), "Output file or directory of the recorded responses for reverse geocoding and autocomplete")(
+      "max_distance", bp::value<double>(&max_distance), "Maximum distance (meters) of reverse geocoding, 0 - unlimited (optional)")(
+      "complete", bp::value<std::string>(&complete), "File with partial addresses, autocomplete by local index (optional)")(
+      "top", bp::value<std::size_t>(&top), "Count of the completions of the partial address, default 10 (optional)")(
+      "format", bp::value<std::string>(&format), "Format of the output file: text, columnar, csv, jsonl, default text (optional)")(
+      "serve", bp::value<std::string>(&serve), "Daemon mode, geocoding over HTTP on 'host:port' or 'unix:path' (optional)")(
+      "stream", bp::bool_switch(&stream), "Filter mode, addresses from stdin, results to stdout per batch (optional)")(
+      "journal", bp::value<std::string>(&journal), "Journal of the progress of the address file, default '<output>.journal' (optional)")(
+      "resume", bp::bool_switch(&resume), "Skip the addresses completed by the journal of the interrupted run (optional)")(
+      "shard", bp::value<std::string>(&shard), "The slice 'index/count' of the address file, the output is csv or jsonl (optional)")(
+      "shard_by", bp::value<std::string>(&shard_by), "The key of the slice: line, hash (the same address in the same shard), default line (optional)");
 
-  bp::variables_map options;
-  bp::store(bp::command_line_parser(argc, argv).options(option_desc).run(), options);
-  if (options.empty() || options.count("help"))
+  bp::variables_map vm;
+  bp::store(bp::command_line_parser(argc, argv).options(option_desc).run(), vm);
+  if (vm.empty() || vm.count("help"))
   {
     std::cerr << option_desc << std::endl;
     return false;
   }
-  else if (options.count("version"))
+  else if (vm.count("version"))
   {
     std::cout << geocoder::version::getText() << std::endl;
     return false;
   }
 
-  bp::notify(options);
+  bp::notify(vm);
 
-  config_filename = {config};
-  addr_filename = {address_fname};
-  outfile = {output};
-  std::swap(address, addr);
+  if (!record.empty() && !replay.empty())
+  {
+    std::cerr << "Ambiguity parameters --record or --replay" << std::endl;
+    return false;
+  }
+
+  if (!reverse.empty() && index.empty())
+  {
+    std::cerr << "Reverse geocoding requires --index" << std::endl;
+    return false;
+  }
+
+  if (!complete.empty() && index.empty())
+  {
+    std::cerr << "Autocomplete requires --index" << std::endl;
+    return false;
+  }
+
+  if (!reverse.empty() && !complete.empty())
+  {
+    std::cerr << "Ambiguity parameters --reverse or --complete" << std::endl;
+    return false;
+  }
+
+  if (format != "text" && format != "columnar" && format != "csv" && format != "jsonl")
+  {
+    std::cerr << "Unknown format '" << format << "'" << std::endl;
+    return false;
+  }
+
+  if (stream && format == "columnar")
+  {
+    std::cerr << "Format 'columnar' is not supported by --stream" << std::endl;
+    return false;
+  }
+
+  if (stream && !serve.empty())
+  {
+    std::cerr << "Ambiguity parameters --stream or --serve" << std::endl;
+    return false;
+  }
+
+  if (resume && journal.empty() && output.empty())
+  {
+    std::cerr << "Resume requires --journal or --output" << std::endl;
+    return false;
+  }
+
+  if (shard_by != "line" && shard_by != "hash")
+  {
+    std::cerr << "Unknown key of the shard '" << shard_by << "'" << std::endl;
+    return false;
+  }
+
+  if (!shard.empty() && format != "csv" && format != "jsonl")
+  {
+    std::cerr << "The output of --shard requires the ids of the lines, --format csv or jsonl" << std::endl;
+    return false;
+  }
+
+  options.config = {config};
+  options.addr_file = {address_fname};
+  options.output = {output};
+  options.record = {record};
+  options.replay = {replay};
+  options.reverse = {reverse};
+  options.index = {index};
+  options.max_distance = max_distance;
+  options.complete = {complete};
+  options.top = top;
+  options.format = format;
+  options.serve = serve;
+  options.stream = stream;
+  options.journal = {journal};
+  options.resume = resume;
+  options.shard = shard;
+  options.shard_by = shard_by;
+  std::swap(options.address, addr);
+
+  return true;
+}
+//--------------------------------------------------------------------------------------------
+bool parseMergeCmd(int argc, char *argv[], MergeOptions &options)
+{
+  namespace bp = boost::program_options;
+
+  BOOST_ASSERT_MSG(argc > 0, "count argument is null");
+  BOOST_ASSERT_MSG(argv, "command line is nullptr");
+
+  bp::options_description option_desc("Usage: geocoder merge -o output shard_output...\nAllowed options");
+
+  std::string output;
+  std::vector<std::string> inputs;
+
+  option_desc.add_options()("help,h", "Display the program usage and exit")("output,o", bp::value<std::string>(&output)->required(),
+                                                                              "Output file (required)")(
+      "input", bp::value<std::vector<std::string>>(&inputs), "Outputs of the shards, csv or jsonl (required)");
+
+  bp::positional_options_description positional;
+  positional.add("input", -1);
+
+  bp::variables_map vm;
+  bp::store(bp::command_line_parser(argc, argv).options(option_desc).positional(positional).run(), vm);
+  if (vm.count("help"))
+  {
+    std::cerr << option_desc << std::endl;
+    return false;
+  }
+
+  bp::notify(vm);
+
+  if (inputs.empty())
+  {
+    std::cerr << option_desc << std::endl;
+    return false;
+  }
+
+  options.output = {output};
+  options.inputs.assign(inputs.begin(), inputs.end());
 
   return true;
 }
@@ -0,0 +1,187 @@
+/** @file recorder.cpp
+ *  @brief the implementation of the class Recorder
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "utils/recorder.h"
+
+// std
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+
+namespace geocoder
+{
+namespace utils
+{
+namespace fs = boost::filesystem;
+//--------------------------------------------------------------------------------------------
+namespace
+{
+/** @brief FNV-1a 64 bit */
+std::uint64_t hashUrl(const std::string &url)
+{
+  std::uint64_t result = 14695981039346656037ULL;
+  for (const auto c : url)
+  {
+    result ^= static_cast<unsigned char>(c);
+    result *= 1099511628211ULL;
+  }
+  return result;
+}
+}  // namespace
+//--------------------------------------------------------------------------------------------
+Recorder::Recorder(Mode mode, const boost::filesystem::path &dir)
+ : mode_(mode)
+ , dir_(dir)
+{
+  if (mode_ == Mode::record)
+  {
+    fs::create_directories(dir_);
+  }
+  else if (mode_ == Mode::replay && !fs::is_directory(dir_))
+  {
+    throw std::runtime_error("[Recorder::Recorder]: is not exists directory '" + dir_.string() + "'");
+  }
+}
+//--------------------------------------------------------------------------------------------
+Recorder::Recorder(const boost::property_tree::ptree &conf)
+ : Recorder(textToMode(conf.get<std::string>("mode", "none")), conf.get<std::string>("dir", std::string()))
+{
+}
+//--------------------------------------------------------------------------------------------
+fs::path Recorder::getFileName(const std::string &url) const
+{
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hashUrl(url);
+  const auto text = name.str();
+
+  auto result = dir_;
+  result /= text.substr(0, 2);
+  result /= text + ".resp";
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+void Recorder::save(const std::string &url, const std::string &body, long code) const
+{
+  const auto filename = getFileName(url);
+  fs::create_directories(filename.parent_path());
+
+  // write to temporary file and rename, concurrent workers may record the same url
+  auto tmp = filename;
+  tmp += fs::unique_path(".%%%%%%%%");
+
+  {
+    std::ofstream fout(tmp.string(), std::ios::binary | std::ios::trunc);
+    if (!fout.is_open())
+    {
+      throw std::runtime_error("[Recorder::save]: failed open file '" + tmp.string() + "'");
+    }
+
+    fout << url << '\n' << code << '\n';
+    fout.write(body.data(), body.size());
+  }
+
+  fs::rename(tmp, filename);
+}
+//--------------------------------------------------------------------------------------------
+std::tuple<std::string, long> Recorder::load(const std::string &url) const
+{
+  const auto filename = getFileName(url);
+
+  std::ifstream fin(filename.string(), std::ios::binary);
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("[Recorder::load]: is not recorded url '" + url + "'");
+  }
+
+  std::string stored_url;
+  std::string code;
+  std::getline(fin, stored_url);
+  std::getline(fin, code);
+
+  if (stored_url != url)
+  {
+    throw std::runtime_error("[Recorder::load]: is not recorded url '" + url + "', collision with '" + stored_url + "'");
+  }
+
+  std::string body{std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>()};
+
+  return std::make_tuple(std::move(body), std::stol(code));
+}
+//--------------------------------------------------------------------------------------------
+void Recorder::forEach(const std::function<void(const std::string &, const std::string &, long)> &fn) const
+{
+  if (!fs::is_directory(dir_))
+  {
+    throw std::runtime_error("[Recorder::forEach]: is not found directory '" + dir_.string() + "'");
+  }
+
+  for (fs::recursive_directory_iterator it(dir_), end; it != end; ++it)
+  {
+    if (!fs::is_regular_file(it->path()) || it->path().extension() != ".resp")
+    {
+      continue;
+    }
+
+    std::ifstream fin(it->path().string(), std::ios::binary);
+    if (!fin.is_open())
+    {
+      throw std::runtime_error("[Recorder::forEach]: failed open file '" + it->path().string() + "'");
+    }
+
+    std::string url;
+    std::string code;
+    std::getline(fin, url);
+    std::getline(fin, code);
+
+    const std::string body{std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>()};
+
+    fn(url, body, std::stol(code));
+  }
+}
+//--------------------------------------------------------------------------------------------
+std::string Recorder::modeToText(Mode mode)
+{
+  switch (mode)
+  {
+    case Mode::none:
+      return "none";
+    case Mode::record:
+      return "record";
+    case Mode::replay:
+      return "replay";
+    default:
+      throw std::runtime_error("[Recorder::modeToText]: unknown mode");
+  }
+}
+//--------------------------------------------------------------------------------------------
+Recorder::Mode Recorder::textToMode(const std::string &mode)
+{
+  if (mode == "none")
+  {
+    return Mode::none;
+  }
+  else if (mode == "record")
+  {
+    return Mode::record;
+  }
+  else if (mode == "replay")
+  {
+    return Mode::replay;
+  }
+  else
+  {
+    throw std::runtime_error("[Recorder::textToMode]: unknown mode '" + mode + "'");
+  }
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace utils
+}  // namespace geocoder
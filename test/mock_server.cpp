@@ -0,0 +1,692 @@
+/** @file mock_server.cpp
+ *  @brief the implementation of the local mock geocoder http server
+ *  @author agent
+ *  @date 19.10.2026
+ */
+// declare
+#include "mock_server.h"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+namespace geocoder
+{
+namespace test
+{
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+//--------------------------------------------------------------------------------------------
+namespace
+{
+std::string urlDecode(const std::string &text)
+{
+  std::string result;
+  result.reserve(text.size());
+
+  for (std::size_t i = 0; i < text.size(); ++i)
+  {
+    if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(text[i + 1]) && std::isxdigit(text[i + 2]))
+    {
+      result.push_back(static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16)));
+      i += 2;
+    }
+    else if (text[i] == '+')
+    {
+      result.push_back(' ');
+    }
+    else
+    {
+      result.push_back(text[i]);
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+std::string getParam(const std::string &target, const std::string &name)
+{
+  const auto query = target.find('?');
+  if (query == std::string::npos)
+  {
+    return std::string();
+  }
+
+  std::vector<std::string> params;
+  const auto text = target.substr(query + 1);
+  boost::split(params, text, boost::is_any_of("&"));
+
+  for (const auto &i : params)
+  {
+    if (boost::starts_with(i, name + "="))
+    {
+      return urlDecode(i.substr(name.size() + 1));
+    }
+  }
+
+  return std::string();
+}
+//--------------------------------------------------------------------------------------------
+std::string xmlEscape(const std::string &text)
+{
+  std::string result;
+  result.reserve(text.size());
+
+  for (const auto c : text)
+  {
+    switch (c)
+    {
+      case '&':
+        result += "&amp;";
+        break;
+      case '<':
+        result += "&lt;";
+        break;
+      case '>':
+        result += "&gt;";
+        break;
+      default:
+        result.push_back(c);
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+std::string jsonEscape(const std::string &text)
+{
+  std::string result;
+  result.reserve(text.size());
+
+  for (const auto c : text)
+  {
+    switch (c)
+    {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      default:
+        result.push_back(c);
+    }
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+/** @brief the request has 'Accept-Encoding' with gzip */
+bool acceptGzip(const std::string &header)
+{
+  const auto begin = boost::ifind_first(header, "\r\naccept-encoding:");
+  if (begin.empty())
+  {
+    return false;
+  }
+
+  const auto pos = static_cast<std::size_t>(begin.end() - header.begin());
+  return boost::icontains(header.substr(pos, header.find("\r\n", pos) - pos), "gzip");
+}
+//--------------------------------------------------------------------------------------------
+std::string gzip(const std::string &text)
+{
+  namespace io = boost::iostreams;
+
+  std::ostringstream out;
+  {
+    io::filtering_ostream stream;
+    stream.push(io::gzip_compressor());
+    stream.push(out);
+    stream << text;
+  }
+
+  return out.str();
+}
+//--------------------------------------------------------------------------------------------
+std::string precisionToYandex(geo::Precision p) { return (p == geo::Precision::nearly) ? "near" : geo::PrecisionToString(p); }
+}  // namespace
+//--------------------------------------------------------------------------------------------
+class MockServer::Impl final
+{
+ public:
+  enum class Action
+  {
+    ok,
+    error_400,
+    error_429,
+    error_403,
+    error_5xx,
+    drop
+  };
+
+  struct Decision
+  {
+    Action action{Action::ok};
+    std::chrono::microseconds latency{0};
+  };
+
+  Impl(const Fixtures &fixtures, const MockConfig &conf)
+   : fixtures_(fixtures)
+   , empty_(makeYandexAnswer(geo::Locations()), makeYandexJsonAnswer(geo::Locations()))
+   , conf_(conf)
+   , acceptor_(io_, tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+   , rand_(conf.seed)
+  {
+    for (const auto &i : fixtures_)
+    {
+      rendered_.emplace(i.first, std::make_pair(makeYandexAnswer(i.second), makeYandexJsonAnswer(i.second)));
+    }
+
+    accept();
+
+    const auto threads = std::max<std::size_t>(conf_.threads, 1);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+      threads_.emplace_back([this] { io_.run(); });
+    }
+  }
+
+  ~Impl()
+  {
+    io_.stop();
+    for (auto &i : threads_)
+    {
+      i.join();
+    }
+  }
+
+  std::uint16_t port() const { return acceptor_.local_endpoint().port(); }
+
+  MockStats stats() const
+  {
+    MockStats result;
+    result.connections = connections_;
+    result.requests = requests_;
+    result.probes = probes_;
+    result.ok = ok_;
+    result.error_429 = error_429_;
+    result.error_5xx = error_5xx_;
+    result.drop = drop_;
+    result.bytes = bytes_;
+
+    std::lock_guard<std::mutex> locker(lock_);
+    result.error_403 = error_403_;
+    result.keys = keys_;
+    return result;
+  }
+
+  const MockConfig &config() const { return conf_; }
+
+  void sent(std::size_t bytes) { bytes_ += bytes; }
+
+  void probed() { ++probes_; }
+
+  Decision decide(const std::string &target)
+  {
+    ++requests_;
+
+    std::lock_guard<std::mutex> locker(lock_);
+
+    Decision result;
+
+    const auto key = getParam(target, "apikey");
+    const auto used = ++keys_[key];
+    const auto quota = conf_.key_quota.find(key);
+    if (quota != conf_.key_quota.end() && used > quota->second)
+    {
+      result.action = Action::error_403;
+      ++error_403_;
+      return result;
+    }
+
+    if (conf_.bad_request.count(getParam(target, "geocode")))
+    {
+      result.action = Action::error_400;
+      return result;
+    }
+
+    switch (conf_.latency_type)
+    {
+      case MockConfig::Latency::constant:
+        result.latency = conf_.latency;
+        break;
+      case MockConfig::Latency::uniform:
+      {
+        std::uniform_int_distribution<std::int64_t> dist(conf_.latency.count(), std::max(conf_.latency, conf_.latency_max).count());
+        result.latency = std::chrono::microseconds(dist(rand_));
+        break;
+      }
+      case MockConfig::Latency::exponential:
+      {
+        std::exponential_distribution<double> dist(1.0 / std::max<double>(conf_.latency.count(), 1.0));
+        result.latency = std::chrono::microseconds(static_cast<std::int64_t>(dist(rand_)));
+        break;
+      }
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const auto p = dist(rand_);
+
+    if (p < conf_.drop)
+    {
+      result.action = Action::drop;
+      ++drop_;
+    }
+    else if (p < conf_.drop + conf_.error_429)
+    {
+      result.action = Action::error_429;
+      ++error_429_;
+    }
+    else if (p < conf_.drop + conf_.error_429 + conf_.error_5xx)
+    {
+      result.action = Action::error_5xx;
+      ++error_5xx_;
+    }
+    else
+    {
+      ++ok_;
+    }
+
+    return result;
+  }
+
+  std::string body(const std::string &target) const
+  {
+    const bool json = (getParam(target, "format") == "json");
+    const auto results_text = getParam(target, "results");
+    const std::size_t results = results_text.empty() ? 0 : std::stoul(results_text);
+
+    const auto it = fixtures_.find(getParam(target, "geocode"));
+    if (it == fixtures_.end())
+    {
+      return json ? empty_.second : empty_.first;
+    }
+
+    if (results && results < it->second.size())
+    {
+      const geo::Locations locs(it->second.begin(), it->second.begin() + results);
+      return json ? makeYandexJsonAnswer(locs) : makeYandexAnswer(locs);
+    }
+
+    const auto &rendered = rendered_.at(it->first);
+    return json ? rendered.second : rendered.first;
+  }
+
+ private:
+  class Session;
+  void accept();
+
+ private:
+  const Fixtures fixtures_;
+  /** @brief pre-rendered full answers: xml, json */
+  using Rendered = std::pair<std::string, std::string>;
+  std::map<std::string, Rendered> rendered_;
+  const Rendered empty_;
+  const MockConfig conf_;
+  asio::io_context io_;
+  tcp::acceptor acceptor_;
+  std::vector<std::thread> threads_;
+
+  mutable std::mutex lock_;
+  std::mt19937 rand_;
+  std::map<std::string, std::uint64_t> keys_;
+  std::uint64_t error_403_{0};
+
+  std::atomic<std::uint64_t> connections_{0};
+  std::atomic<std::uint64_t> requests_{0};
+  std::atomic<std::uint64_t> probes_{0};
+  std::atomic<std::uint64_t> ok_{0};
+  std::atomic<std::uint64_t> error_429_{0};
+  std::atomic<std::uint64_t> error_5xx_{0};
+  std::atomic<std::uint64_t> drop_{0};
+  std::atomic<std::uint64_t> bytes_{0};
+};
+//--------------------------------------------------------------------------------------------
+/** @class Session
+ *  @brief one client connection (keep-alive)
+ */
+class MockServer::Impl::Session final : public std::enable_shared_from_this<Session>
+{
+ public:
+  Session(tcp::socket socket, Impl &server)
+   : socket_(std::move(socket))
+   , timer_(socket_.get_executor())
+   , server_(server)
+  {
+  }
+
+  void read()
+  {
+    auto self = shared_from_this();
+    asio::async_read_until(socket_, buffer_, "\r\n\r\n", [this, self](const boost::system::error_code &ec, std::size_t n) {
+      if (ec)
+      {
+        return;
+      }
+
+      std::string header(asio::buffers_begin(buffer_.data()), asio::buffers_begin(buffer_.data()) + n);
+      buffer_.consume(n);
+      handle(header);
+    });
+  }
+
+ private:
+  void handle(const std::string &header)
+  {
+    std::istringstream in(header);
+    std::string method;
+    std::string target;
+    in >> method >> target;
+
+    keep_alive_ = !boost::icontains(header, "connection: close");
+
+    // the warm-up of the connection: the headers only, no latency and errors
+    if (method == "HEAD")
+    {
+      server_.probed();
+      header_ = std::string("HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: ") + (keep_alive_ ? "keep-alive" : "close") + "\r\n\r\n";
+      body_.clear();
+      offset_ = 0;
+      writeHeader();
+      return;
+    }
+
+    const auto decision = server_.decide(target);
+
+    std::ostringstream out;
+    std::string body;
+
+    switch (decision.action)
+    {
+      case Action::ok:
+        body = server_.body(target);
+        out << "HTTP/1.1 200 OK\r\nContent-Type: text/xml; charset=utf-8\r\n";
+        if (acceptGzip(header))
+        {
+          body = gzip(body);
+          out << "Content-Encoding: gzip\r\n";
+        }
+        break;
+      case Action::error_400:
+        body = "{\"statusCode\":400,\"error\":\"Bad Request\",\"message\":\"Invalid parameter value\"}";
+        out << "HTTP/1.1 400 Bad Request\r\nContent-Type: application/json\r\n";
+        break;
+      case Action::error_429:
+        body = "Too Many Requests";
+        out << "HTTP/1.1 429 Too Many Requests\r\nContent-Type: text/plain\r\n";
+        break;
+      case Action::error_403:
+        body = "Forbidden";
+        out << "HTTP/1.1 403 Forbidden\r\nContent-Type: text/plain\r\n";
+        break;
+      case Action::error_5xx:
+        body = "Service Unavailable";
+        out << "HTTP/1.1 503 Service Unavailable\r\nContent-Type: text/plain\r\n";
+        break;
+      case Action::drop:
+        break;
+    }
+
+    out << "Content-Length: " << body.size() << "\r\n";
+    server_.sent(body.size());
+    out << "Connection: " << (keep_alive_ ? "keep-alive" : "close") << "\r\n\r\n";
+
+    header_ = out.str();
+    body_ = std::move(body);
+    offset_ = 0;
+
+    auto self = shared_from_this();
+    timer_.expires_after(decision.latency);
+    timer_.async_wait([this, self, decision](const boost::system::error_code &ec) {
+      if (ec)
+      {
+        return;
+      }
+
+      if (decision.action == Action::drop)
+      {
+        boost::system::error_code ignore;
+        socket_.shutdown(tcp::socket::shutdown_both, ignore);
+        socket_.close(ignore);
+        return;
+      }
+
+      writeHeader();
+    });
+  }
+
+  void writeHeader()
+  {
+    const auto drip = server_.config().drip_chunk;
+    if (!drip)
+    {
+      header_ += body_;
+      body_.clear();
+    }
+
+    auto self = shared_from_this();
+    asio::async_write(socket_, asio::buffer(header_), [this, self](const boost::system::error_code &ec, std::size_t) {
+      if (!ec)
+      {
+        writeBody();
+      }
+    });
+  }
+
+  void writeBody()
+  {
+    if (offset_ >= body_.size())
+    {
+      complete();
+      return;
+    }
+
+    const auto &conf = server_.config();
+    const auto n = std::min(conf.drip_chunk, body_.size() - offset_);
+
+    auto self = shared_from_this();
+    timer_.expires_after(conf.drip_delay);
+    timer_.async_wait([this, self, n](const boost::system::error_code &ec) {
+      if (ec)
+      {
+        return;
+      }
+
+      asio::async_write(socket_, asio::buffer(body_.data() + offset_, n), [this, self, n](const boost::system::error_code &ec, std::size_t) {
+        if (!ec)
+        {
+          offset_ += n;
+          writeBody();
+        }
+      });
+    });
+  }
+
+  void complete()
+  {
+    if (keep_alive_)
+    {
+      read();
+    }
+    else
+    {
+      boost::system::error_code ignore;
+      socket_.shutdown(tcp::socket::shutdown_both, ignore);
+    }
+  }
+
+ private:
+  tcp::socket socket_;
+  asio::steady_timer timer_;
+  asio::streambuf buffer_;
+  Impl &server_;
+  std::string header_;
+  std::string body_;
+  std::size_t offset_{0};
+  bool keep_alive_{true};
+};
+//--------------------------------------------------------------------------------------------
+void MockServer::Impl::accept()
+{
+  acceptor_.async_accept([this](const boost::system::error_code &ec, tcp::socket socket) {
+    if (!ec)
+    {
+      ++connections_;
+      socket.set_option(tcp::no_delay(true));
+      std::make_shared<Session>(std::move(socket), *this)->read();
+    }
+
+    if (acceptor_.is_open())
+    {
+      accept();
+    }
+  });
+}
+//--------------------------------------------------------------------------------------------
+MockServer::MockServer(const Fixtures &fixtures, const MockConfig &conf)
+ : impl_(new Impl(fixtures, conf))
+{
+}
+//--------------------------------------------------------------------------------------------
+MockServer::~MockServer() = default;
+//--------------------------------------------------------------------------------------------
+std::uint16_t MockServer::port() const { return impl_->port(); }
+//--------------------------------------------------------------------------------------------
+std::string MockServer::url() const { return "http://127.0.0.1:" + std::to_string(port()) + "/1.x/?geocode="; }
+//--------------------------------------------------------------------------------------------
+MockStats MockServer::stats() const { return impl_->stats(); }
+//--------------------------------------------------------------------------------------------
+std::string makeYandexAnswer(const geo::Locations &locs)
+{
+  std::ostringstream out;
+  out.precision(10);
+
+  out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+  out << "<ymaps xmlns=\"http://maps.yandex.ru/ymaps/1.x\">\n";
+  out << "<GeoObjectCollection>\n";
+  out << "<metaDataProperty xmlns=\"http://www.opengis.net/gml\"><GeocoderResponseMetaData xmlns=\"http://maps.yandex.ru/geocoder/1.x\">";
+  out << "<found>" << locs.size() << "</found><results>10</results></GeocoderResponseMetaData></metaDataProperty>\n";
+
+  auto tag = [&out](const std::string &name, const std::string &value) {
+    if (!value.empty())
+    {
+      out << "<" << name << ">" << xmlEscape(value) << "</" << name << ">";
+    }
+  };
+
+  for (const auto &i : locs)
+  {
+    out << "<featureMember xmlns=\"http://www.opengis.net/gml\"><GeoObject xmlns=\"http://maps.yandex.ru/ymaps/1.x\">";
+    out << "<metaDataProperty xmlns=\"http://www.opengis.net/gml\"><GeocoderMetaData xmlns=\"http://maps.yandex.ru/geocoder/1.x\">";
+    out << "<kind>house</kind>";
+    tag("text", i.line);
+    tag("precision", precisionToYandex(i.precision));
+    out << "<AddressDetails xmlns=\"urn:oasis:names:tc:ciq:xsdschema:xAL:2.0\"><Country>";
+    tag("AddressLine", i.line);
+    tag("CountryName", i.country);
+    out << "<AdministrativeArea>";
+    tag("AdministrativeAreaName", i.region);
+    out << "<SubAdministrativeArea>";
+    tag("SubAdministrativeAreaName", i.district);
+    out << "<Locality>";
+    tag("LocalityName", i.place);
+    out << "<DependentLocality>";
+    tag("DependentLocalityName", i.suburb);
+    out << "<Thoroughfare>";
+    tag("ThoroughfareName", i.street);
+    out << "<Premise>";
+    tag("PremiseNumber", i.house);
+    out << "</Premise></Thoroughfare></DependentLocality></Locality></SubAdministrativeArea></AdministrativeArea>";
+    out << "</Country></AddressDetails></GeocoderMetaData></metaDataProperty>";
+    out << "<Point><pos>" << i.coord.longitude << " " << i.coord.latitude << "</pos></Point>";
+    out << "</GeoObject></featureMember>\n";
+  }
+
+  out << "</GeoObjectCollection>\n</ymaps>\n";
+
+  return out.str();
+}
+//--------------------------------------------------------------------------------------------
+std::string makeYandexJsonAnswer(const geo::Locations &locs)
+{
+  std::ostringstream out;
+  out.precision(10);
+
+  out << "{\"response\":{\"GeoObjectCollection\":{\"metaDataProperty\":{\"GeocoderResponseMetaData\":";
+  out << "{\"found\":\"" << locs.size() << "\",\"results\":\"10\"}},\"featureMember\":[";
+
+  auto field = [&out](const std::string &name, const std::string &value) {
+    if (!value.empty())
+    {
+      out << "\"" << name << "\":\"" << jsonEscape(value) << "\",";
+    }
+  };
+
+  for (std::size_t i = 0; i < locs.size(); ++i)
+  {
+    const auto &loc = locs[i];
+    out << (i ? "," : "") << "{\"GeoObject\":{\"metaDataProperty\":{\"GeocoderMetaData\":{\"kind\":\"house\",";
+    field("text", loc.line);
+    out << "\"precision\":\"" << precisionToYandex(loc.precision) << "\",";
+    out << "\"AddressDetails\":{\"Country\":{";
+    field("AddressLine", loc.line);
+    field("CountryName", loc.country);
+    out << "\"AdministrativeArea\":{";
+    field("AdministrativeAreaName", loc.region);
+    out << "\"SubAdministrativeArea\":{";
+    field("SubAdministrativeAreaName", loc.district);
+    out << "\"Locality\":{";
+    field("LocalityName", loc.place);
+    out << "\"DependentLocality\":{";
+    field("DependentLocalityName", loc.suburb);
+    out << "\"Thoroughfare\":{";
+    field("ThoroughfareName", loc.street);
+    out << "\"Premise\":{";
+    field("PremiseNumber", loc.house);
+    out << "\"kind\":\"house\"}}}}}}}}}},";
+    out << "\"Point\":{\"pos\":\"" << loc.coord.longitude << " " << loc.coord.latitude << "\"}}}";
+  }
+
+  out << "]}}}";
+
+  return out.str();
+}
+//--------------------------------------------------------------------------------------------
+Fixtures makeFixtures(const DataSet &data, std::size_t extra)
+{
+  Fixtures result;
+
+  for (const auto &i : data)
+  {
+    geo::Locations locs{i.second};
+    for (std::size_t j = 0; j < extra; ++j)
+    {
+      // the street level results, as the real geocoder returns for the ambiguous addresses
+      auto loc = i.second;
+      loc.house.clear();
+      loc.precision = geo::Precision::street;
+      loc.coord.latitude += 0.001 * (j + 1);
+      locs.push_back(std::move(loc));
+    }
+    result.emplace(i.first, std::move(locs));
+  }
+
+  return result;
+}
+//--------------------------------------------------------------------------------------------
+}  // namespace test
+}  // namespace geocoder
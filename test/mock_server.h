@@ -0,0 +1,116 @@
+/** @file mock_server.h
+ *  @brief the define of the local mock geocoder http server
+ *  @author agent
+ *  @date 19.10.2026
+ */
+#ifndef GEOCODER_TEST_MOCK_SERVER_H_
+#define GEOCODER_TEST_MOCK_SERVER_H_
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <memory>
+#include <string>
+
+// this
+#include "geo/location.h"
+#include "test_utils.h"
+
+namespace geocoder
+{
+namespace test
+{
+/** @brief address -> locations of the answer */
+using Fixtures = std::map<std::string, geo::Locations>;
+
+/** @struct MockConfig
+ *  @brief behaviour of the mock server
+ */
+struct MockConfig
+{
+  enum class Latency
+  {
+    constant,     ///< always 'latency'
+    uniform,      ///< uniform in ['latency', 'latency_max']
+    exponential   ///< exponential with mean 'latency'
+  };
+
+  Latency latency_type{Latency::constant};
+  std::chrono::microseconds latency{0};
+  std::chrono::microseconds latency_max{0};
+
+  /** @brief probability of the response 429 Too Many Requests */
+  double error_429{0.0};
+  /** @brief probability of the response 503 Service Unavailable */
+  double error_5xx{0.0};
+  /** @brief probability of closing connection without response */
+  double drop{0.0};
+
+  /** @brief the addresses answered 400 Bad Request (the error body of the geocoder) */
+  std::set<std::string> bad_request;
+
+  /** @brief requests of the api key ('apikey' parameter) per run, beyond - 403 Forbidden */
+  std::map<std::string, std::uint64_t> key_quota;
+
+  /** @brief slow-drip body: chunk size (0 - disabled) and delay between chunks */
+  std::size_t drip_chunk{0};
+  std::chrono::microseconds drip_delay{0};
+
+  std::uint32_t seed{42};
+  std::size_t threads{4};
+};
+
+/** @struct MockStats
+ *  @brief counters of the mock server
+ */
+struct MockStats
+{
+  std::uint64_t connections{0};
+  std::uint64_t requests{0};
+  /** @brief HEAD requests (the warm-up of the connections), not counted in 'requests' */
+  std::uint64_t probes{0};
+  std::uint64_t ok{0};
+  std::uint64_t error_429{0};
+  std::uint64_t error_5xx{0};
+  std::uint64_t drop{0};
+  std::uint64_t error_403{0};
+  /** @brief requests by the api key ('apikey' parameter) */
+  std::map<std::string, std::uint64_t> keys;
+  /** @brief bytes of the bodies (after Content-Encoding) */
+  std::uint64_t bytes{0};
+};
+
+/** @class MockServer
+ *  @brief the local stand-in for the yandex geocoder, listen 127.0.0.1 on the ephemeral port
+ *  @details supports the parameters 'format' (xml, json) and 'results'
+ */
+class MockServer final
+{
+ public:
+  MockServer(const Fixtures &fixtures, const MockConfig &conf = MockConfig());
+  MockServer(const MockServer &) = delete;
+  MockServer &operator=(const MockServer &) = delete;
+  ~MockServer();
+
+  std::uint16_t port() const;
+  /** @brief url for config option 'connection.url' */
+  std::string url() const;
+  MockStats stats() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** @brief render yandex geocoder xml answer */
+std::string makeYandexAnswer(const geo::Locations &locs);
+/** @brief render yandex geocoder json answer (format=json) */
+std::string makeYandexJsonAnswer(const geo::Locations &locs);
+/** @brief fixtures from data set (address -> location of the data set and 'extra' less precise locations) */
+Fixtures makeFixtures(const DataSet &data, std::size_t extra = 0);
+}  // namespace test
+}  // namespace geocoder
+
+#endif
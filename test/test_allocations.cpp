@@ -0,0 +1,120 @@
+/** @file test_allocations.cpp
+ *  @brief the implementation test for the allocations of the request of the worker: the buffers are reused, the locations are not copied
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// boost
+#include <boost/log/core.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/geoyandex.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace pt = boost::property_tree;
+
+/** @brief only the allocations of the thread of the test are counted, the mock server and the logger are not */
+thread_local bool counting = false;
+thread_local std::size_t allocations = 0;
+
+/** @brief the count of the allocations of the function */
+template <class F>
+std::size_t count(F &&f)
+{
+  allocations = 0;
+  counting = true;
+  f();
+  counting = false;
+  return allocations;
+}
+
+/** @brief the logging is disabled in the scope (restored by the failed check too) */
+class NoLogging final
+{
+ public:
+  NoLogging() { boost::log::core::get()->set_logging_enabled(false); }
+  NoLogging(const NoLogging &) = delete;
+  NoLogging &operator=(const NoLogging &) = delete;
+  ~NoLogging() { boost::log::core::get()->set_logging_enabled(true); }
+};
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+  if (counting)
+  {
+    ++allocations;
+  }
+  if (auto result = std::malloc(size ? size : 1))
+  {
+    return result;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept { ::operator delete(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { ::operator delete(ptr); }
+
+BOOST_AUTO_TEST_SUITE(test_allocations)
+
+BOOST_AUTO_TEST_CASE(test_geopool)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const auto fixtures = geocoder::test::makeFixtures(data, 9);
+  geocoder::test::MockServer server(fixtures);
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.format", "json");
+  document.put("document.geocoders.geocoder.connection.url", server.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  geo::GeoPool pool(document);
+
+  const auto &address = fixtures.begin()->first;
+  const auto body = geocoder::test::makeYandexJsonAnswer(fixtures.begin()->second);
+
+  // the parse itself: the strings of the locations and the vector
+  geo::Locations parsed;
+  const auto parse = count([&] { parsed = geo::parseYandexJson(body); });
+  BOOST_REQUIRE_EQUAL(parsed.size(), 10);
+
+  // the buffers of the worker are sized by the first requests
+  for (int i = 0; i < 3; ++i)
+  {
+    pool.geocode(address);
+  }
+
+  // the trace of the request is not the part of the hot path
+  const NoLogging no_logging;
+
+  // the steady state: the url, the body and the handoff of the answer add nothing to the parse
+  geo::Answer answer;
+  for (int i = 0; i < 3; ++i)
+  {
+    const auto request = count([&] { answer = pool.geocode(address); });
+    BOOST_REQUIRE_EQUAL(answer.locations.size(), 10);
+    BOOST_CHECK_EQUAL(request, parse);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
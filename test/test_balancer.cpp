@@ -0,0 +1,253 @@
+/** @file test_balancer.cpp
+ *  @brief the implementation test for the endpoints with the weights and the daily quotas
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <fstream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/balancer.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace fs = boost::filesystem;
+namespace pt = boost::property_tree;
+using geocoder::utils::Balancer;
+using geocoder::utils::Endpoint;
+using geocoder::utils::Endpoints;
+
+Endpoint makeEndpoint(const std::string &id, std::size_t weight, std::uint64_t quota = 0)
+{
+  Endpoint result;
+  result.id = id;
+  result.url = "http://127.0.0.1/?geocode=";
+  result.key = id;
+  result.weight = weight;
+  result.quota = quota;
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_balancer)
+
+BOOST_AUTO_TEST_CASE(test_weights)
+{
+  Balancer balancer({makeEndpoint("a", 3), makeEndpoint("b", 2), makeEndpoint("c", 1)});
+  BOOST_REQUIRE_EQUAL(balancer.size(), 3);
+
+  // smooth: the heavy endpoint is not requested in a row more than its share
+  std::vector<std::size_t> counts(3, 0);
+  std::size_t row = 0;
+  std::size_t max_row = 0;
+  std::size_t last = balancer.size();
+  for (int i = 0; i < 600; ++i)
+  {
+    const auto endpoint = balancer.acquire();
+    ++counts[endpoint];
+    row = (endpoint == last) ? row + 1 : 1;
+    max_row = std::max(max_row, row);
+    last = endpoint;
+  }
+
+  BOOST_CHECK_EQUAL(counts[0], 300);
+  BOOST_CHECK_EQUAL(counts[1], 200);
+  BOOST_CHECK_EQUAL(counts[2], 100);
+  BOOST_CHECK(max_row <= 2);
+  BOOST_CHECK_EQUAL(balancer.used(0), 300);
+}
+
+BOOST_AUTO_TEST_CASE(test_quota)
+{
+  Balancer balancer({makeEndpoint("a", 1, 5), makeEndpoint("b", 1, 10), makeEndpoint("c", 1)});
+
+  for (int i = 0; i < 30; ++i)
+  {
+    balancer.acquire();
+  }
+  BOOST_CHECK_EQUAL(balancer.used(0), 5);
+  BOOST_CHECK_EQUAL(balancer.used(1), 10);
+  BOOST_CHECK_EQUAL(balancer.used(2), 15);
+  BOOST_CHECK(balancer.exhausted(0));
+  BOOST_CHECK(!balancer.exhausted(2));
+
+  // the limit of the key by the geocoder
+  balancer.exhaust(2);
+  BOOST_CHECK(balancer.exhausted(2));
+  BOOST_CHECK_THROW(balancer.acquire(), std::runtime_error);
+  BOOST_CHECK_EQUAL(balancer.used(2), 15);
+}
+
+BOOST_AUTO_TEST_CASE(test_usage)
+{
+  const geocoder::test::TempDir dir("geocoder_balancer");
+  const auto usage = dir.path / "usage.xml";
+  const Endpoints endpoints = {makeEndpoint("a", 1, 10), makeEndpoint("b", 1)};
+
+  {
+    Balancer balancer(endpoints, usage, 1000);
+    for (int i = 0; i < 14; ++i)
+    {
+      balancer.acquire();
+    }
+    balancer.exhaust(1);
+    BOOST_CHECK(fs::exists(usage));
+  }
+
+  // the next run: the usage of today, the order of the endpoints is changed
+  {
+    Balancer balancer({endpoints[1], endpoints[0], makeEndpoint("c", 1)}, usage);
+    BOOST_CHECK_EQUAL(balancer.used(0), 7);
+    BOOST_CHECK(balancer.exhausted(0));
+    BOOST_CHECK_EQUAL(balancer.used(1), 7);
+    BOOST_CHECK_EQUAL(balancer.used(2), 0);
+    for (int i = 0; i < 3; ++i)
+    {
+      BOOST_CHECK(balancer.acquire() != 0);
+    }
+    BOOST_CHECK_EQUAL(balancer.used(1) + balancer.used(2), 10);
+  }
+
+  // the usage of the other day is ignored
+  pt::ptree document;
+  pt::read_xml(usage.string(), document);
+  BOOST_CHECK_EQUAL(document.get<std::string>("usage.endpoint.id"), "b");
+  document.put("usage.day", "2016-01-01");
+  pt::write_xml(usage.string(), document);
+  {
+    Balancer balancer(endpoints, usage);
+    BOOST_CHECK_EQUAL(balancer.used(0), 0);
+    BOOST_CHECK(!balancer.exhausted(1));
+  }
+
+  // the broken file is ignored
+  {
+    std::ofstream fout(usage.string());
+    fout << "<usage><day>";
+  }
+  Balancer balancer(endpoints, usage);
+  BOOST_CHECK_EQUAL(balancer.used(0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_usage_failed)
+{
+  const geocoder::test::TempDir dir("geocoder_balancer");
+  const auto usage = dir.path / "none" / "usage.xml";
+
+  // the usage file is not written: the requests are not failed, the explicit save is
+  Balancer balancer({makeEndpoint("a", 1), makeEndpoint("b", 1)}, usage, 1);
+  for (int i = 0; i < 4; ++i)
+  {
+    BOOST_CHECK_NO_THROW(balancer.acquire());
+  }
+  BOOST_CHECK_NO_THROW(balancer.exhaust(0));
+  BOOST_CHECK_EQUAL(balancer.acquire(), 1);
+  BOOST_CHECK_THROW(balancer.save(), std::runtime_error);
+  BOOST_CHECK(!fs::exists(usage));
+}
+
+BOOST_AUTO_TEST_CASE(test_read_endpoints)
+{
+  pt::ptree conn;
+  conn.put("url", "http://host/?geocode=");
+  auto endpoints = geocoder::utils::readEndpoints(conn);
+  BOOST_REQUIRE_EQUAL(endpoints.size(), 1);
+  BOOST_CHECK_EQUAL(endpoints[0].url, "http://host/?geocode=");
+  BOOST_CHECK_EQUAL(endpoints[0].quota, 0);
+
+  pt::ptree first;
+  first.put("key", "k1");
+  first.put("weight", 2);
+  first.put("quota", 25000);
+  pt::ptree second;
+  second.put("id", "backup");
+  second.put("url", "http://backup/?geocode=");
+  conn.add_child("endpoints.endpoint", first);
+  conn.add_child("endpoints.endpoint", second);
+
+  endpoints = geocoder::utils::readEndpoints(conn);
+  BOOST_REQUIRE_EQUAL(endpoints.size(), 2);
+  BOOST_CHECK_EQUAL(endpoints[0].id, "0");
+  BOOST_CHECK_EQUAL(endpoints[0].url, "http://host/?geocode=");
+  BOOST_CHECK_EQUAL(endpoints[0].key, "k1");
+  BOOST_CHECK_EQUAL(endpoints[0].weight, 2);
+  BOOST_CHECK_EQUAL(endpoints[0].quota, 25000);
+  BOOST_CHECK_EQUAL(endpoints[1].id, "backup");
+  BOOST_CHECK_EQUAL(endpoints[1].url, "http://backup/?geocode=");
+  BOOST_CHECK_EQUAL(endpoints[1].weight, 1);
+
+  conn.put("endpoints.endpoint.weight", 0);
+  BOOST_CHECK_THROW(geocoder::utils::readEndpoints(conn), std::runtime_error);
+  BOOST_CHECK_THROW(geocoder::utils::readEndpoints(pt::ptree()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_keys_geopool)
+{
+  const geocoder::test::TempDir dir("geocoder_balancer");
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+
+  // the key 'a' is limited by the geocoder, the key 'c' by the local quota
+  geocoder::test::MockConfig mock;
+  mock.key_quota["a"] = 10;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  auto &conn = document.get_child("document.geocoders.geocoder.connection");
+  conn.put("url", server.url());
+  conn.put("timeout", 5);
+  conn.put("conntimeout", 5);
+  conn.put("usage", (dir.path / "usage.xml").string());
+  for (const auto &i : {makeEndpoint("a", 2), makeEndpoint("b", 1), makeEndpoint("c", 1, 15)})
+  {
+    pt::ptree endpoint;
+    endpoint.put("id", i.id);
+    endpoint.put("key", i.key);
+    endpoint.put("weight", i.weight);
+    endpoint.put("quota", i.quota);
+    conn.add_child("endpoints.endpoint", endpoint);
+  }
+
+  geocoder::utils::metrics::reset();
+  {
+    geocoder::geo::GeoPool pool(document);
+    for (int n = 0; n < 30; ++n)
+    {
+      for (const auto &i : data)
+      {
+        const auto answer = pool.geocode(i.first);
+        BOOST_REQUIRE_EQUAL(answer.locations.size(), 1);
+      }
+    }
+  }
+
+  // 90 answers: 'a' - 10 and the refused request, 'c' - the quota, 'b' - the rest
+  const auto stats = server.stats();
+  BOOST_CHECK_EQUAL(stats.error_403, 1);
+  BOOST_CHECK_EQUAL(stats.keys.at("a"), 11);
+  BOOST_CHECK_EQUAL(stats.keys.at("c"), 15);
+  BOOST_CHECK_EQUAL(stats.keys.at("b"), 65);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("geocoder.yandex.endpoint.a.requests").value(), 11);
+
+  pt::ptree usage;
+  pt::read_xml((dir.path / "usage.xml").string(), usage);
+  const auto &first = usage.get_child("usage").equal_range("endpoint").first->second;
+  BOOST_CHECK_EQUAL(first.get<std::string>("id"), "a");
+  BOOST_CHECK_EQUAL(first.get<std::uint64_t>("requests"), 11);
+  BOOST_CHECK(first.get<bool>("exhausted"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+/** @file test_binary_logger.cpp
+ *  @brief the implementation test for binary logger
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "utils/logger/binary.h"
+#include "test_utils.h"
+#include "utils/logger/logger.h"
+
+namespace
+{
+namespace fs = boost::filesystem;
+namespace logger = geocoder::utils::logger;
+
+logger::config::Configuration makeConfig(const fs::path &dir)
+{
+  logger::config::Configuration conf;
+  conf.workdir = dir;
+  conf.binary.enabled = true;
+  conf.binary.prefix = "test";
+  conf.binary.flush = 10;
+  return conf;
+}
+
+/** @brief decode all binary logs of the directory */
+std::size_t decodeDir(const fs::path &dir, std::string &text)
+{
+  std::ostringstream out;
+  std::size_t result = 0;
+
+  for (fs::directory_iterator it(dir), end; it != end; ++it)
+  {
+    if (it->path().extension() == ".blog")
+    {
+      std::ifstream fin(it->path().string(), std::ios::binary);
+      result += logger::binary::decode(fin, out);
+    }
+  }
+
+  text = out.str();
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_binary_logger)
+
+BOOST_AUTO_TEST_CASE(test_format)
+{
+  BOOST_CHECK_EQUAL(logger::binary::format("request '{}' code {}", std::string("abc"), 200), "request 'abc' code 200");
+  BOOST_CHECK_EQUAL(logger::binary::format("no placeholders"), "no placeholders");
+  BOOST_CHECK_EQUAL(logger::binary::format("{} {}", 1), "1 {}");
+}
+
+BOOST_AUTO_TEST_CASE(test_write_decode)
+{
+  const geocoder::test::TempDir temp("geocoder_blog");
+  const auto &dir = temp.path;
+
+  logger::binary::start(makeConfig(dir));
+  BOOST_REQUIRE(logger::binary::isRunning());
+
+  const std::size_t threads = 4;
+  const std::size_t count = 1000;
+
+  std::vector<std::future<void>> futures;
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    futures.push_back(std::async(std::launch::async, [t, count] {
+      auto &lg = geo_logger::get();
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        GEO_LOG_BIN(lg, logger::Severity::trace, "[test]: thread {} record {} '{}' {} {}", t, i, std::string("addr"), 0.5, true);
+      }
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  logger::binary::stop();
+  BOOST_CHECK(!logger::binary::isRunning());
+
+  std::string text;
+  BOOST_CHECK_EQUAL(decodeDir(dir, text), threads * count);
+  BOOST_CHECK(text.find("[TRACE]: [test]: thread 3 record 999 'addr' 0.5 true\n") != std::string::npos);
+  BOOST_CHECK(text.find("dropped") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_severity_and_overflow)
+{
+  const geocoder::test::TempDir temp("geocoder_blog");
+  const auto &dir = temp.path;
+
+  auto conf = makeConfig(dir);
+  conf.severity = logger::Severity::info;
+  conf.binary.buffer = 1024;
+  conf.binary.flush = 10000;
+
+  logger::binary::start(conf);
+
+  auto &lg = geo_logger::get();
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    GEO_LOG_BIN(lg, logger::Severity::trace, "[test]: filtered {}", i);
+    GEO_LOG_BIN(lg, logger::Severity::info, "[test]: record {} {}", i, std::string(64, 'x'));
+  }
+
+  logger::binary::stop();
+
+  std::string text;
+  const auto count = decodeDir(dir, text);
+  BOOST_CHECK(count > 0 && count < 100);
+  BOOST_CHECK(text.find("filtered") == std::string::npos);
+  BOOST_CHECK(text.find("[INFO]: [test]: record 0 ") != std::string::npos);
+  BOOST_CHECK(text.find("dropped") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt)
+{
+  const geocoder::test::TempDir temp("geocoder_blog");
+  const auto &dir = temp.path;
+
+  logger::binary::start(makeConfig(dir));
+  GEO_LOG_BIN(geo_logger::get(), logger::Severity::info, "[test]: the last argument '{}'", std::string("corrupt"));
+  logger::binary::stop();
+
+  std::string text;
+  BOOST_REQUIRE_EQUAL(decodeDir(dir, text), 1);
+
+  // the length of the string is beyond the record
+  for (fs::directory_iterator it(dir), end; it != end; ++it)
+  {
+    std::string data;
+    {
+      std::ifstream fin(it->path().string(), std::ios::binary);
+      data.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    }
+    const auto pos = data.rfind("corrupt");
+    BOOST_REQUIRE(pos != std::string::npos && pos >= 2);
+    data[pos - 2] = data[pos - 1] = '\xff';
+    std::ofstream fout(it->path().string(), std::ios::binary | std::ios::trunc);
+    fout << data;
+  }
+  BOOST_CHECK_THROW(decodeDir(dir, text), std::runtime_error);
+
+  // the truncated blocks, the sizes of the blocks larger than the file: 'GEOBLOG1', the type, u32, u32 size
+  const auto block = [](char type, std::uint32_t size, const std::string &payload) {
+    std::string result("GEOBLOG1");
+    result += type;
+    result.append(4, '\0');
+    result.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    return result + payload;
+  };
+  for (const auto &i : {block('F', 10, "abc"), block('F', 0xFFFFFFFF, "abc"), block('R', 0xFFFFFFF0, "abc")})
+  {
+    std::istringstream in(i);
+    std::ostringstream out;
+    BOOST_CHECK_THROW(logger::binary::decode(in, out), std::runtime_error);
+  }
+  std::istringstream in(block('F', 3, "abc"));
+  std::ostringstream out;
+  BOOST_CHECK_EQUAL(logger::binary::decode(in, out), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+/** @file test_columnar.cpp
+ *  @brief the implementation test for columnar binary output
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/columnar.h"
+#include "geo/reverse.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+
+/** @brief the answers of the data set: the all locations, the not found address, the answer of the two locations */
+geo::Answers makeAnswers()
+{
+  geo::Answers result;
+  geo::Answer many;
+  many.type = geo::Answer::GeocoderType::local;
+  for (const auto &i : geocoder::test::readFromFile("../test/addrs.txt"))
+  {
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::yandex;
+    answer.locations.push_back(i.second);
+    result.push_back(answer);
+    many.locations.push_back(i.second);
+  }
+
+  result.push_back(geo::Answer());
+  result.push_back(many);
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_columnar)
+
+BOOST_AUTO_TEST_CASE(test_write_read)
+{
+  const geocoder::test::TempDir dir("geocoder_columnar");
+  const auto answers = makeAnswers();
+  const auto filename = dir.path / "output.col";
+  geo::printColumnar(filename, answers);
+  BOOST_CHECK(geo::isColumnarFile(filename));
+
+  const geo::ColumnarReader reader(filename);
+  BOOST_REQUIRE_EQUAL(reader.answers(), answers.size());
+  BOOST_REQUIRE_EQUAL(reader.rows(), 6);
+
+  // zero copy scan of the columns
+  const auto first = reader.first();
+  const auto latitude = reader.latitude();
+  const auto place = reader.strings("place");
+  BOOST_CHECK_EQUAL(first[3], 3);
+  BOOST_CHECK_EQUAL(first[4], 3);
+  BOOST_CHECK_EQUAL(first[5], 6);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(latitude.data) % alignof(double), 0);
+  BOOST_CHECK_EQUAL(latitude[0], answers[0].locations[0].coord.latitude);
+  BOOST_CHECK_EQUAL(place.size(), 6);
+  BOOST_CHECK_EQUAL(place.entries(), 2);
+  BOOST_CHECK_EQUAL(place.code(0), place.code(3));
+  BOOST_CHECK(place[2] == answers[2].locations[0].place);
+  BOOST_CHECK(reader.type()[3] == static_cast<std::int8_t>(geo::Answer::GeocoderType::unknown));
+
+  const auto copy = reader.read();
+  BOOST_REQUIRE_EQUAL(copy.size(), answers.size());
+  for (std::size_t i = 0; i < answers.size(); ++i)
+  {
+    BOOST_CHECK(copy[i].type == answers[i].type);
+    BOOST_REQUIRE_EQUAL(copy[i].locations.size(), answers[i].locations.size());
+    for (std::size_t j = 0; j < answers[i].locations.size(); ++j)
+    {
+      const auto &l = copy[i].locations[j];
+      const auto &r = answers[i].locations[j];
+      BOOST_CHECK_EQUAL(l.line, r.line);
+      BOOST_CHECK_EQUAL(l.country, r.country);
+      BOOST_CHECK_EQUAL(l.region, r.region);
+      BOOST_CHECK_EQUAL(l.district, r.district);
+      BOOST_CHECK_EQUAL(l.place, r.place);
+      BOOST_CHECK_EQUAL(l.suburb, r.suburb);
+      BOOST_CHECK_EQUAL(l.street, r.street);
+      BOOST_CHECK_EQUAL(l.house, r.house);
+      BOOST_CHECK_EQUAL(l.coord.latitude, r.coord.latitude);
+      BOOST_CHECK_EQUAL(l.coord.longitude, r.coord.longitude);
+      BOOST_CHECK(l.precision == r.precision);
+    }
+  }
+
+  BOOST_CHECK_THROW(reader.strings("absent"), std::runtime_error);
+  BOOST_CHECK_THROW(reader.answer(answers.size()), std::out_of_range);
+
+  // the source of the local indexes
+  BOOST_CHECK_EQUAL(geo::loadLocations(filename).size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty_and_invalid)
+{
+  const geocoder::test::TempDir dir("geocoder_columnar");
+
+  geo::printColumnar(dir.path / "empty.col", geo::Answers());
+  const geo::ColumnarReader reader(dir.path / "empty.col");
+  BOOST_CHECK_EQUAL(reader.answers(), 0);
+  BOOST_CHECK_EQUAL(reader.rows(), 0);
+  BOOST_CHECK_EQUAL(reader.strings("house").entries(), 0);
+
+  {
+    std::ofstream fout((dir.path / "bad.col").string());
+    fout << "not a columnar file";
+  }
+  BOOST_CHECK(!geo::isColumnarFile(dir.path / "bad.col"));
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "bad.col"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "absent.col"), std::runtime_error);
+
+  // the truncated file
+  geo::printColumnar(dir.path / "full.col", makeAnswers());
+  fs::resize_file(dir.path / "full.col", fs::file_size(dir.path / "full.col") / 2);
+  BOOST_CHECK(geo::isColumnarFile(dir.path / "full.col"));
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "full.col"), std::runtime_error);
+
+  // the corrupt columns: the header (32 bytes), the directory of the columns (64 bytes each:
+  // name[16], type, reserved, offset, count, offsets, entries, bytes)
+  geo::printColumnar(dir.path / "full.col", makeAnswers());
+  std::string data;
+  {
+    std::ifstream fin((dir.path / "full.col").string(), std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  }
+  const auto field = [&data](const std::string &name, std::size_t at) {
+    std::uint32_t columns = 0;
+    std::memcpy(&columns, data.data() + 8, sizeof(columns));
+    for (std::size_t i = 0; i < columns; ++i)
+    {
+      const auto column = 32 + i * 64;
+      if (name == data.c_str() + column)
+      {
+        std::uint64_t result = 0;
+        std::memcpy(&result, data.data() + column + at, sizeof(result));
+        return result;
+      }
+    }
+    BOOST_FAIL("is not found column '" + name + "'");
+    return std::uint64_t(0);
+  };
+  const auto corrupt = [&data, &dir](std::uint64_t offset, std::uint32_t value) {
+    auto copy = data;
+    std::memcpy(&copy[offset], &value, sizeof(value));
+    std::ofstream fout((dir.path / "corrupt.col").string(), std::ios::binary | std::ios::trunc);
+    fout << copy;
+  };
+
+  corrupt(field("first", 24) + sizeof(std::uint32_t), 1000);
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "corrupt.col"), std::runtime_error);
+  corrupt(field("house", 24), static_cast<std::uint32_t>(field("house", 48)));
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "corrupt.col"), std::runtime_error);
+  corrupt(field("house", 40) + sizeof(std::uint32_t), 1000);
+  BOOST_CHECK_THROW(geo::ColumnarReader(dir.path / "corrupt.col"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
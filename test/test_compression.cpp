@@ -0,0 +1,91 @@
+/** @file test_compression.cpp
+ *  @brief the implementation test for compressed responses and traffic counters
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <string>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+namespace metrics = geocoder::utils::metrics;
+
+/** @brief geocode the all data set, return count of the right answers */
+std::size_t run(const geocoder::test::DataSet &data, const geocoder::test::MockServer &server, const std::string &http_version,
+                const std::string *encoding)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  for (auto &i : document.get_child("document.geocoders"))
+  {
+    i.second.put("connection.url", server.url());
+    i.second.put("connection.http_version", http_version);
+    i.second.get_child("connection").erase("accept_encoding");
+    if (encoding)
+    {
+      i.second.put("connection.accept_encoding", *encoding);
+    }
+  }
+
+  geocoder::geo::GeoPool pool(document);
+  std::size_t result = 0;
+  for (const auto &i : data)
+  {
+    const auto ret = pool.geocode(i.first);
+    result += (ret.locations.size() == 1 && ret.locations.front().house == i.second.house) ? 1 : 0;
+  }
+
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_compression)
+
+BOOST_AUTO_TEST_CASE(test_identity)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  metrics::reset();
+  BOOST_CHECK_EQUAL(run(data, server, "1.1", nullptr), data.size());
+
+  const auto values = metrics::snapshot();
+  BOOST_CHECK_EQUAL(values.at("geocoder.yandex.requests"), data.size());
+  BOOST_CHECK_EQUAL(values.at("geocoder.yandex.bytes_wire"), values.at("geocoder.yandex.bytes_decoded"));
+  BOOST_CHECK_EQUAL(values.at("geocoder.yandex.bytes_wire"), server.stats().bytes);
+}
+
+BOOST_AUTO_TEST_CASE(test_gzip)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+
+  for (const auto &version : {"1.1", "2"})
+  {
+    geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+    metrics::reset();
+    const std::string encoding = "gzip, deflate, br";
+    BOOST_CHECK_EQUAL(run(data, server, version, &encoding), data.size());
+
+    const auto values = metrics::snapshot();
+    BOOST_TEST_MESSAGE("http " << version << ": wire " << values.at("geocoder.yandex.bytes_wire") << " bytes, decoded "
+                               << values.at("geocoder.yandex.bytes_decoded") << " bytes");
+    BOOST_CHECK_EQUAL(values.at("geocoder.yandex.bytes_wire"), server.stats().bytes);
+    BOOST_CHECK(values.at("geocoder.yandex.bytes_wire") < values.at("geocoder.yandex.bytes_decoded"));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
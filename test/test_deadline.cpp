@@ -0,0 +1,155 @@
+/** @file test_deadline.cpp
+ *  @brief the implementation test for the deadline of the address split across the chain of the geocoders
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+using Clock = std::chrono::steady_clock;
+
+/** @brief the config of 'count' geocoders of the server, the timeout of the connection is long */
+pt::ptree makeConfig(const std::string &url, std::size_t count, std::int64_t total, std::int64_t min_request)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  auto &geocoders = document.get_child("document.geocoders");
+  auto geo = geocoders.get_child("geocoder");
+  geo.put("connection.url", url);
+  geo.put("connection.timeout", 5);
+  geocoders.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    geocoders.add_child("geocoder", geo);
+  }
+  document.put("document.deadline.total", total);
+  document.put("document.deadline.min_request", min_request);
+  return document;
+}
+
+std::int64_t elapsed(Clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_deadline)
+
+BOOST_AUTO_TEST_CASE(test_single)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(400);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // the answer is later than the deadline: the request is aborted
+  {
+    geocoder::geo::GeoPool pool(makeConfig(server.url(), 1, 100, 10));
+    const auto start = Clock::now();
+    const auto answer = pool.geocode(data.begin()->first);
+    BOOST_CHECK(answer.locations.empty());
+    BOOST_CHECK(elapsed(start) < 300);
+  }
+
+  // the deadline is enough
+  {
+    geocoder::geo::GeoPool pool(makeConfig(server.url(), 1, 2000, 10));
+    const auto answer = pool.geocode(data.begin()->first);
+    BOOST_CHECK_EQUAL(answer.locations.size(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_chain)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(400);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // the both geocoders are requested in the half of the deadline each
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), 2, 300, 10));
+  const auto start = Clock::now();
+  const auto answer = pool.geocode(data.begin()->first);
+  const auto duration = elapsed(start);
+  BOOST_CHECK(answer.locations.empty());
+  BOOST_CHECK(duration >= 250);
+  BOOST_CHECK(duration < 400);
+  BOOST_CHECK_EQUAL(server.stats().requests, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_not_started)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  // the rest of the deadline is less than the minimum request: nothing is sent
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), 2, 20, 50));
+  BOOST_CHECK(pool.geocode(data.begin()->first).locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 0);
+
+  // the share of the first geocoder is less than the minimum request, the whole deadline is enough
+  const auto exceeded = geocoder::utils::metrics::counter("geocoder.yandex.deadline_exceeded").value();
+  geocoder::geo::GeoPool chain(makeConfig(server.url(), 2, 150, 100));
+  BOOST_CHECK_EQUAL(chain.geocode(data.begin()->first).locations.size(), 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, 1);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("geocoder.yandex.deadline_exceeded").value(), exceeded + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_http2_ms)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(400);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // the multiplexer (plain http falls back to HTTP/1.1) gets the milliseconds as they are, not rounded up to the seconds
+  for (const auto timeout : {300, 1500})
+  {
+    auto conf = makeConfig(server.url(), 1, 0, 0);
+    conf.put("document.geocoders.geocoder.connection.timeout_ms", timeout);
+    conf.put("document.geocoders.geocoder.connection.http_version", "2");
+    geocoder::geo::GeoPool pool(conf);
+
+    const auto start = Clock::now();
+    const auto answer = pool.geocode(data.begin()->first);
+    BOOST_CHECK_EQUAL(answer.locations.size(), (timeout < 400) ? 0 : 1);
+    BOOST_CHECK(elapsed(start) < 800);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_low_speed)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.drip_chunk = 1;
+  mock.drip_delay = std::chrono::milliseconds(100);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // 10 bytes per second for the body of the kilobytes: aborted by the speed, not by the timeout
+  auto conf = makeConfig(server.url(), 1, 0, 0);
+  conf.put("document.geocoders.geocoder.connection.timeout", 30);
+  conf.put("document.geocoders.geocoder.connection.low_speed_limit", 100);
+  conf.put("document.geocoders.geocoder.connection.low_speed_time", 1);
+  geocoder::geo::GeoPool pool(conf);
+
+  const auto start = Clock::now();
+  BOOST_CHECK(pool.geocode(data.begin()->first).locations.empty());
+  BOOST_CHECK(elapsed(start) < 5000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/** @file test_fuzzy.cpp
+ *  @brief the implementation test for fuzzy address matching
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/fuzzy.h"
+#include "geo/gazetteer.h"
+#include "geo/geopool.h"
+#include "test_utils.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+
+/** @brief the index of the data set in the temporary directory */
+struct TempIndex
+{
+  TempIndex()
+   : dir("geocoder_fuzzy")
+   , filename(dir.path / "index.gaz")
+  {
+    geo::GazetteerBuilder builder;
+    for (const auto &i : geocoder::test::readFromFile("../test/addrs.txt"))
+    {
+      builder.add(i.second);
+    }
+    builder.write(filename);
+  }
+  const geocoder::test::TempDir dir;
+  const fs::path filename;
+};
+
+/** @brief the reference levenshtein distance (single byte strings) */
+std::size_t reference(const std::string &lhs, const std::string &rhs)
+{
+  std::vector<std::size_t> prev(rhs.size() + 1);
+  std::vector<std::size_t> cur(rhs.size() + 1);
+  for (std::size_t j = 0; j <= rhs.size(); ++j)
+  {
+    prev[j] = j;
+  }
+
+  for (std::size_t i = 1; i <= lhs.size(); ++i)
+  {
+    cur[0] = i;
+    for (std::size_t j = 1; j <= rhs.size(); ++j)
+    {
+      cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + ((lhs[i - 1] == rhs[j - 1]) ? 0 : 1)});
+    }
+    std::swap(prev, cur);
+  }
+  return prev[rhs.size()];
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_fuzzy)
+
+BOOST_AUTO_TEST_CASE(test_edit_distance)
+{
+  BOOST_CHECK_EQUAL(geo::editDistance("kitten", "sitting", 5), 3);
+  BOOST_CHECK_EQUAL(geo::editDistance("kitten", "sitting", 2), 3);
+  BOOST_CHECK_EQUAL(geo::editDistance("", "abc", 5), 3);
+  BOOST_CHECK_EQUAL(geo::editDistance("abc", "abc", 0), 0);
+  BOOST_CHECK_EQUAL(geo::editDistance("пришвина", "пришвена", 3), 1);
+  BOOST_CHECK_EQUAL(geo::editDistance("текучева", "текчеа", 3), 2);
+
+  // the bit-parallel (up to 64 code points) and the banded (longer) against the reference
+  std::mt19937 rand(42);
+  std::uniform_int_distribution<int> letter('a', 'd');
+  std::uniform_int_distribution<std::size_t> length(0, 100);
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    std::string lhs(length(rand), ' ');
+    std::string rhs(std::min<std::size_t>(lhs.size() + length(rand) % 5, 100), ' ');
+    std::generate(lhs.begin(), lhs.end(), [&] { return static_cast<char>(letter(rand)); });
+    std::generate(rhs.begin(), rhs.end(), [&] { return static_cast<char>(letter(rand)); });
+    // the similar strings
+    if (i % 2)
+    {
+      rhs = lhs;
+      for (std::size_t k = 0; k < 3 && !rhs.empty(); ++k)
+      {
+        rhs[length(rand) % rhs.size()] = 'z';
+      }
+    }
+
+    const auto expected = reference(lhs, rhs);
+    const std::size_t max = 8;
+    BOOST_REQUIRE_EQUAL(geo::editDistance(lhs, rhs, max), std::min(expected, max + 1));
+    BOOST_REQUIRE_EQUAL(geo::editDistance(lhs, rhs, 200), expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_match)
+{
+  const TempIndex temp;
+  const geo::Gazetteer gazetteer(temp.filename);
+  const geo::FuzzyIndex index(gazetteer);
+  BOOST_CHECK_EQUAL(index.size(), gazetteer.size());
+
+  auto matches = index.match("Москва, ул. Пришвено 8к2");
+  BOOST_REQUIRE(!matches.empty());
+  BOOST_CHECK_EQUAL(matches.front().key, "москва пришвина 8к2");
+  BOOST_CHECK_EQUAL(matches.front().distance, 2);
+  BOOST_REQUIRE_EQUAL(matches.front().ids.size(), 1);
+  BOOST_CHECK_EQUAL(gazetteer.record(matches.front().ids.front()).house, "8к2");
+
+  matches = index.match("Ростов на Дону, улица Текучева, д. 350а");
+  BOOST_REQUIRE(!matches.empty());
+  BOOST_CHECK_EQUAL(matches.front().distance, 0);
+  BOOST_CHECK_EQUAL(matches.front().score, 1.0);
+
+  matches = index.match("Ростов-на-Дону, Тикучева 350А");
+  BOOST_REQUIRE(!matches.empty());
+  BOOST_CHECK_EQUAL(matches.front().key, "ростов на дону текучева 350а");
+
+  // the house number is not corrected
+  BOOST_CHECK(index.match("Москва, ракетный 18").empty());
+  geo::FuzzyOptions options;
+  options.exact_numbers = false;
+  BOOST_CHECK(!index.match("Москва, ракетный 18", options).empty());
+
+  // below the threshold
+  BOOST_CHECK(index.match("Санкт-Петербург, Невский проспект 16").empty());
+  BOOST_CHECK(index.match("Москва, Пришвино 8к2", [] {
+                     geo::FuzzyOptions o;
+                     o.threshold = 1.0;
+                     return o;
+                   }()).empty());
+  BOOST_CHECK(index.match("").empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_local_fuzzy)
+{
+  const TempIndex temp;
+
+  boost::property_tree::ptree document;
+  auto &conf = document.add_child("document.geocoders.geocoder", boost::property_tree::ptree());
+  conf.put("name", "local");
+  conf.put("index", temp.filename.string());
+  conf.put("fuzzy.enabled", true);
+
+  geocoder::utils::metrics::reset();
+
+  geo::GeoPool pool(document);
+
+  auto ret = pool.geocode("Москва, Пришвена 8к2");
+  BOOST_REQUIRE_EQUAL(ret.locations.size(), 1);
+  BOOST_CHECK_EQUAL(ret.locations.front().street, "улица Пришвина");
+  BOOST_CHECK(ret.type == geo::Answer::GeocoderType::local);
+
+  ret = pool.geocode("Москва, Пришвина 8к2");
+  BOOST_CHECK_EQUAL(ret.locations.size(), 1);
+
+  ret = pool.geocode("Москва, Тверская 1");
+  BOOST_CHECK(ret.locations.empty());
+
+  const auto values = geocoder::utils::metrics::snapshot();
+  BOOST_CHECK_EQUAL(values.at("geocoder.local.requests"), 3);
+  BOOST_CHECK_EQUAL(values.at("geocoder.local.hits"), 2);
+  BOOST_CHECK_EQUAL(values.at("geocoder.local.fuzzy_hits"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,247 @@
+/** @file test_gazetteer.cpp
+ *  @brief the implementation test for offline gazetteer index and local geocoder
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/gazetteer.h"
+#include "geo/geopool.h"
+#include "geo/normalize.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+
+fs::path buildIndex(const geocoder::test::DataSet &data, const fs::path &dir)
+{
+  geo::GazetteerBuilder builder;
+  for (const auto &i : data)
+  {
+    builder.add(i.second);
+  }
+
+  const auto filename = dir / "index.gaz";
+  builder.write(filename);
+  return filename;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_gazetteer)
+
+BOOST_AUTO_TEST_CASE(test_normalize)
+{
+  BOOST_CHECK_EQUAL(geo::normalize("Москва, ул. Пришвина, д. 8к2"), "москва пришвина 8к2");
+  BOOST_CHECK_EQUAL(geo::normalize("  РОСТОВ-НА-ДОНУ,улица Текучёва   350А "), "ростов на дону текучева 350а");
+  BOOST_CHECK_EQUAL(geo::normalize("г. Москва, пр-т Мира 1"), "москва мира 1");
+  BOOST_CHECK_EQUAL(geo::normalize("Main St. 5"), "main st 5");
+  BOOST_CHECK_EQUAL(geo::normalize(", ; ."), "");
+
+  geo::Location loc;
+  loc.country = "Россия";
+  loc.region = "Москва";
+  loc.place = "Москва";
+  loc.street = "улица Пришвина";
+  loc.house = "8к2";
+  const auto keys = geo::normalizedKeys(loc);
+  BOOST_REQUIRE_EQUAL(keys.size(), 2);
+  BOOST_CHECK_EQUAL(keys[0], "москва пришвина 8к2");
+  BOOST_CHECK_EQUAL(keys[1], "россия москва пришвина 8к2");
+}
+
+BOOST_AUTO_TEST_CASE(test_build_find)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const geocoder::test::TempDir dir("geocoder_gazetteer");
+
+  const geo::Gazetteer index(buildIndex(data, dir.path));
+  BOOST_CHECK_EQUAL(index.records(), data.size());
+
+  for (const auto &i : data)
+  {
+    const auto locs = index.find(i.first);
+    BOOST_REQUIRE_EQUAL(locs.size(), 1);
+    BOOST_CHECK_EQUAL(locs.front().line, i.second.line);
+    BOOST_CHECK_EQUAL(locs.front().region, i.second.region);
+    BOOST_CHECK_EQUAL(locs.front().district, i.second.district);
+    BOOST_CHECK_EQUAL(locs.front().street, i.second.street);
+    BOOST_CHECK_EQUAL(locs.front().house, i.second.house);
+    BOOST_CHECK_EQUAL(locs.front().coord.latitude, i.second.coord.latitude);
+    BOOST_CHECK_EQUAL(locs.front().coord.longitude, i.second.coord.longitude);
+    BOOST_CHECK(locs.front().precision == i.second.precision);
+  }
+
+  BOOST_CHECK(index.find("Москва, пришвина 8").empty());
+  BOOST_CHECK(index.find("").empty());
+
+  std::vector<std::string> keys;
+  index.forEachPrefix("москва ", [&keys](const std::string &key, std::uint32_t) {
+    keys.push_back(key);
+    return true;
+  });
+  BOOST_REQUIRE_EQUAL(keys.size(), 2);
+  BOOST_CHECK_EQUAL(keys[0], "москва пришвина 8к2");
+  BOOST_CHECK_EQUAL(keys[1], "москва ракетный 16");
+}
+
+BOOST_AUTO_TEST_CASE(test_many_blocks)
+{
+  const geocoder::test::TempDir dir("geocoder_gazetteer");
+
+  geo::GazetteerBuilder builder;
+  const std::size_t count = 5000;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    geo::Location loc;
+    loc.place = "Тверь";
+    loc.street = "улица " + std::to_string(i % 50);
+    loc.house = std::to_string(i);
+    loc.coord = geo::Coordinates(50.0, 40.0);
+    builder.add(loc);
+    // the duplicated key
+    builder.add("дубль", loc);
+  }
+  builder.write(dir.path / "index.gaz");
+
+  const geo::Gazetteer index(dir.path / "index.gaz");
+  BOOST_CHECK_EQUAL(index.records(), 2 * count);
+
+  for (std::size_t i = 0; i < count; i += 7)
+  {
+    const auto locs = index.find("тверь ул. " + std::to_string(i % 50) + " д. " + std::to_string(i));
+    BOOST_REQUIRE_EQUAL(locs.size(), 1);
+    BOOST_CHECK_EQUAL(locs.front().house, std::to_string(i));
+  }
+
+  BOOST_CHECK_EQUAL(index.find("Дубль").size(), count);
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_and_invalid_file)
+{
+  const geocoder::test::TempDir dir("geocoder_gazetteer");
+
+  {
+    std::ofstream fout((dir.path / "gaz.csv").string());
+    fout << "# country;region;district;place;suburb;street;house;latitude;longitude;precision\n";
+    fout << "Россия;Москва;;Москва;;улица Пришвина;8к2;55.889073;37.594306\n\n";
+    fout << "Россия;Москва;;Москва;;Ракетный бульвар;16;55.817512;37.655823;number\n";
+  }
+
+  const auto locs = geo::readGazetteerCsv(dir.path / "gaz.csv");
+  BOOST_REQUIRE_EQUAL(locs.size(), 2);
+  BOOST_CHECK_EQUAL(locs[0].line, "Россия, Москва, улица Пришвина, 8к2");
+  BOOST_CHECK(locs[0].precision == geo::Precision::exact);
+  BOOST_CHECK(locs[1].precision == geo::Precision::number);
+
+  {
+    std::ofstream fout((dir.path / "bad.csv").string());
+    fout << "Россия;Москва;;Москва\n";
+  }
+  BOOST_CHECK_THROW(geo::readGazetteerCsv(dir.path / "bad.csv"), std::runtime_error);
+
+  {
+    std::ofstream fout((dir.path / "bad.gaz").string());
+    fout << "not an index";
+  }
+  BOOST_CHECK_THROW(geo::Gazetteer(dir.path / "bad.gaz"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::Gazetteer(dir.path / "absent.gaz"), std::runtime_error);
+
+  // the corrupt index: the offset of the block, the offset of the string of the record are beyond the file
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const auto filename = buildIndex(data, dir.path);
+  std::string index;
+  {
+    std::ifstream fin(filename.string(), std::ios::binary);
+    index.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  }
+  const auto corrupt = [&index, &filename](std::size_t offset, std::uint64_t value, std::size_t size) {
+    auto copy = index;
+    copy.replace(offset, size, reinterpret_cast<const char *>(&value), size);
+    std::ofstream fout(filename.string(), std::ios::binary | std::ios::trunc);
+    fout << copy;
+  };
+
+  // the header: magic[8], block_size, reserved, keys, blocks, records, blocks_offset, records_offset, strings_offset
+  std::uint64_t blocks_offset = 0;
+  std::uint64_t records_offset = 0;
+  std::memcpy(&blocks_offset, index.data() + 40, sizeof(blocks_offset));
+  std::memcpy(&records_offset, index.data() + 48, sizeof(records_offset));
+
+  corrupt(blocks_offset, index.size() * 2, sizeof(std::uint64_t));
+  BOOST_CHECK_THROW(geo::Gazetteer{filename}, std::runtime_error);
+  corrupt(24, std::uint64_t(1) << 62, sizeof(std::uint64_t));
+  BOOST_CHECK_THROW(geo::Gazetteer{filename}, std::runtime_error);
+
+  corrupt(records_offset + 16, 0xFFFFFFF0, sizeof(std::uint32_t));
+  const geo::Gazetteer broken(filename);
+  BOOST_CHECK_THROW(broken.record(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_local_geocoder_first)
+{
+  namespace pt = boost::property_tree;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const geocoder::test::TempDir dir("geocoder_gazetteer");
+
+  // the index has the only first address, the rest are answered by the remote geocoder
+  geocoder::test::DataSet local{*data.begin()};
+  const auto filename = buildIndex(local, dir.path);
+
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  auto &geocoders = document.get_child("document.geocoders");
+  for (auto &i : geocoders)
+  {
+    i.second.put("connection.url", server.url());
+  }
+
+  // the order of the geocoders is the order of insertion
+  pt::ptree conf;
+  conf.put("name", "local");
+  conf.put("index", filename.string());
+  pt::ptree chain;
+  chain.add_child("geocoder", conf);
+  for (const auto &i : geocoders)
+  {
+    chain.add_child(i.first, i.second);
+  }
+  geocoders.swap(chain);
+
+  geocoder::utils::metrics::reset();
+
+  geo::GeoPool pool(document);
+  for (const auto &i : data)
+  {
+    const auto ret = pool.geocode(i.first);
+    BOOST_REQUIRE_EQUAL(ret.locations.size(), 1);
+    BOOST_CHECK_EQUAL(ret.locations.front().house, i.second.house);
+    BOOST_CHECK(ret.type == ((i.first == local.begin()->first) ? geo::Answer::GeocoderType::local : geo::Answer::GeocoderType::yandex));
+  }
+
+  const auto values = geocoder::utils::metrics::snapshot();
+  BOOST_CHECK_EQUAL(values.at("geocoder.local.requests"), data.size());
+  BOOST_CHECK_EQUAL(values.at("geocoder.local.hits"), 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, data.size() - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
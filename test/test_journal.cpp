@@ -0,0 +1,246 @@
+/** @file test_journal.cpp
+ *  @brief the implementation test for the journal of the progress (checkpoint and resume)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <fstream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/journal.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+namespace pt = boost::property_tree;
+
+void checkEqual(const geo::Answer &lhs, const geo::Answer &rhs)
+{
+  BOOST_CHECK(lhs.type == rhs.type);
+  BOOST_REQUIRE_EQUAL(lhs.locations.size(), rhs.locations.size());
+  for (std::size_t i = 0; i < lhs.locations.size(); ++i)
+  {
+    const auto &l = lhs.locations[i];
+    const auto &r = rhs.locations[i];
+    BOOST_CHECK_EQUAL(l.line, r.line);
+    BOOST_CHECK_EQUAL(l.country, r.country);
+    BOOST_CHECK_EQUAL(l.street, r.street);
+    BOOST_CHECK_EQUAL(l.house, r.house);
+    BOOST_CHECK_EQUAL(l.coord.latitude, r.coord.latitude);
+    BOOST_CHECK_EQUAL(l.coord.longitude, r.coord.longitude);
+    BOOST_CHECK(l.precision == r.precision);
+  }
+}
+
+/** @brief the addresses of the data set and the answers, the last address is not found */
+void makeData(geo::Addresses &addrs, geo::Answers &answers)
+{
+  for (const auto &i : geocoder::test::readFromFile("../test/addrs.txt"))
+  {
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::yandex;
+    answer.locations.push_back(i.second);
+    addrs.push_back(i.first);
+    answers.push_back(answer);
+  }
+  addrs.push_back("неизвестный адрес");
+  answers.push_back(geo::Answer());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_journal)
+
+BOOST_AUTO_TEST_CASE(test_append_load)
+{
+  const geocoder::test::TempDir dir("geocoder_journal");
+  const auto filename = dir.path / "output.journal";
+
+  geo::Addresses addrs;
+  geo::Answers answers;
+  makeData(addrs, answers);
+
+  // the group is not written until flush
+  {
+    geo::Journal journal(filename, 2);
+    journal.append(0, addrs[0], answers[0]);
+    journal.append(3, addrs[3], answers[3]);
+    journal.append(1, addrs[1], answers[1]);
+
+    geo::Answers loaded;
+    std::vector<bool> done;
+    BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 2);
+  }
+
+  geo::Answers loaded;
+  std::vector<bool> done;
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 3);
+  BOOST_REQUIRE_EQUAL(loaded.size(), addrs.size());
+  BOOST_CHECK(done[0] && done[1] && !done[2] && done[3]);
+  checkEqual(loaded[0], answers[0]);
+  checkEqual(loaded[1], answers[1]);
+  checkEqual(loaded[3], answers[3]);
+
+  // the records of the other input are ignored
+  auto other = addrs;
+  other[1] = "другой адрес";
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, other, loaded, done), 2);
+  BOOST_CHECK(!done[1]);
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, geo::Addresses(addrs.begin(), addrs.begin() + 2), loaded, done), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_torn_tail)
+{
+  const geocoder::test::TempDir dir("geocoder_journal");
+  const auto filename = dir.path / "output.journal";
+
+  geo::Addresses addrs;
+  geo::Answers answers;
+  makeData(addrs, answers);
+
+  {
+    geo::Journal journal(filename);
+    journal.append(0, addrs[0], answers[0]);
+    journal.append(1, addrs[1], answers[1]);
+  }
+  const auto size = fs::file_size(filename);
+
+  // the crash in the middle of the record
+  {
+    std::ofstream fout(filename.string(), std::ios::binary | std::ios::app);
+    fout << std::string("\x40\x00\x00\x00\x01\x02", 6);
+  }
+
+  geo::Answers loaded;
+  std::vector<bool> done;
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 2);
+
+  // the tail is truncated, the records are appended after the valid ones
+  {
+    geo::Journal journal(filename);
+    BOOST_CHECK_EQUAL(fs::file_size(filename), size);
+    journal.append(2, addrs[2], answers[2]);
+  }
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 3);
+  checkEqual(loaded[2], answers[2]);
+
+  // the size of the torn record is above the rest of the file: not allocated
+  const auto valid = fs::file_size(filename);
+  {
+    std::ofstream fout(filename.string(), std::ios::binary | std::ios::app);
+    fout << std::string("\xff\xff\xff\xff\x01\x02\x03\x04\x05", 9);
+  }
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 3);
+  {
+    geo::Journal journal(filename);
+    BOOST_CHECK_EQUAL(fs::file_size(filename), valid);
+  }
+
+  // not a journal: the file is not overwritten
+  {
+    std::ofstream fout(filename.string(), std::ios::binary);
+    fout << "garbage";
+  }
+  BOOST_CHECK(!geo::Journal::isJournal(filename));
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 0);
+  BOOST_CHECK_THROW(geo::Journal journal(filename), std::runtime_error);
+  BOOST_CHECK_EQUAL(fs::file_size(filename), 7);
+
+  // the empty file is started
+  {
+    std::ofstream fout(filename.string(), std::ios::binary | std::ios::trunc);
+  }
+  {
+    geo::Journal journal(filename);
+    journal.append(3, addrs[3], answers[3]);
+  }
+  BOOST_CHECK(geo::Journal::isJournal(filename));
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, loaded, done), 1);
+
+  BOOST_CHECK_THROW(geo::Journal(dir.path / "none" / "output.journal"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_resume)
+{
+  const geocoder::test::TempDir dir("geocoder_journal");
+  const auto filename = dir.path / "output.journal";
+
+  geo::Addresses addrs;
+  geo::Answers answers;
+  makeData(addrs, answers);
+
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(geocoder::test::readFromFile("../test/addrs.txt")));
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  // the coordinates of the json answer are exact, compared with the fixtures
+  document.put("document.geocoders.geocoder.format", "json");
+  document.put("document.geocoders.geocoder.connection.url", upstream.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+
+  // the interrupted run: the first address is completed
+  {
+    geo::Journal journal(filename);
+    journal.append(0, addrs[0], answers[0]);
+  }
+
+  geo::Answers result;
+  std::vector<bool> done;
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, result, done), 1);
+  {
+    geo::Journal journal(filename);
+    geo::geocode(addrs, document, result, done, &journal);
+  }
+
+  // the completed address is not requested
+  BOOST_CHECK_EQUAL(upstream.stats().requests, addrs.size() - 1);
+  BOOST_REQUIRE_EQUAL(result.size(), addrs.size());
+  for (std::size_t i = 0; i < addrs.size(); ++i)
+  {
+    checkEqual(result[i], answers[i]);
+  }
+
+  // the next resume has nothing to do
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, result, done), addrs.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_transient)
+{
+  const geocoder::test::TempDir dir("geocoder_journal");
+  const auto filename = dir.path / "output.journal";
+
+  geo::Addresses addrs;
+  geo::Answers answers;
+  makeData(addrs, answers);
+
+  // the outage of the geocoder: the all requests are 503
+  geocoder::test::MockConfig mock;
+  mock.error_5xx = 1.0;
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(geocoder::test::readFromFile("../test/addrs.txt")), mock);
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", upstream.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+
+  geo::Answers result;
+  {
+    geo::Journal journal(filename);
+    geo::geocode(addrs, document, result, std::vector<bool>(), &journal);
+  }
+
+  // the failed addresses are geocoded again by the resume
+  std::vector<bool> done;
+  BOOST_CHECK_EQUAL(geo::Journal::load(filename, addrs, result, done), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+/** @file test_json.cpp
+ *  @brief the implementation test for json reader and json answer of the yandex geocoder
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/geoyandex.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/json.h"
+
+namespace
+{
+namespace json = geocoder::utils::json;
+
+/** @brief events as text: '{', '}', '[', ']', 'k:<key>', 's:<string>', 'l:<literal>' */
+class Recorder final : public json::Handler
+{
+ public:
+  void startObject() override { events.push_back("{"); }
+  void endObject() override { events.push_back("}"); }
+  void startArray() override { events.push_back("["); }
+  void endArray() override { events.push_back("]"); }
+  void key(const char *data, std::size_t size) override { events.push_back("k:" + std::string(data, size)); }
+  void string(const char *data, std::size_t size) override { events.push_back("s:" + std::string(data, size)); }
+  void literal(const char *data, std::size_t size) override { events.push_back("l:" + std::string(data, size)); }
+
+  std::vector<std::string> events;
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_json)
+
+BOOST_AUTO_TEST_CASE(test_reader)
+{
+  Recorder rec;
+  json::parse(" {\"a\": [1, -2.5e3, true, null, {}], \"b\" : \"x\\\"y\\\\z\\/\\n\", \"c\": []} ", rec);
+
+  const std::vector<std::string> expected{"{",   "k:a",   "[", "l:1", "l:-2.5e3", "l:true", "l:null", "{",  "}",
+                                          "]",   "k:b",   "s:x\"y\\z/\n",         "k:c",    "[",      "]",  "}"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(rec.events.begin(), rec.events.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_unicode)
+{
+  Recorder rec;
+  json::parse("[\"\\u041c\\u043e\\u0441\\u043a\\u0432\\u0430\", \"\\ud83d\\ude00\", \"Москва\"]", rec);
+
+  BOOST_REQUIRE_EQUAL(rec.events.size(), 5);
+  BOOST_CHECK_EQUAL(rec.events[1], "s:Москва");
+  BOOST_CHECK_EQUAL(rec.events[2], "s:\xF0\x9F\x98\x80");
+  BOOST_CHECK_EQUAL(rec.events[3], "s:Москва");
+}
+
+BOOST_AUTO_TEST_CASE(test_errors)
+{
+  for (const auto text : {"", "{", "[1,]", "{\"a\" 1}", "\"abc", "[tru]", "{} x", "[\"\\x\"]", "[\"\\ud83d\"]", "{1: 2}"})
+  {
+    Recorder rec;
+    BOOST_CHECK_THROW(json::parse(text, rec), std::runtime_error);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_yandex_json_as_xml)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const auto fixtures = geocoder::test::makeFixtures(data, 3);
+
+  for (const auto &i : fixtures)
+  {
+    const auto xml = geocoder::geo::parseYandexXml(geocoder::test::makeYandexAnswer(i.second));
+    const auto json = geocoder::geo::parseYandexJson(geocoder::test::makeYandexJsonAnswer(i.second));
+
+    BOOST_REQUIRE_EQUAL(xml.size(), json.size());
+    BOOST_REQUIRE_EQUAL(json.size(), 4);
+
+    for (std::size_t j = 0; j < json.size(); ++j)
+    {
+      BOOST_CHECK_EQUAL(json[j].line, xml[j].line);
+      BOOST_CHECK_EQUAL(json[j].country, xml[j].country);
+      BOOST_CHECK_EQUAL(json[j].region, xml[j].region);
+      BOOST_CHECK_EQUAL(json[j].district, xml[j].district);
+      BOOST_CHECK_EQUAL(json[j].place, xml[j].place);
+      BOOST_CHECK_EQUAL(json[j].suburb, xml[j].suburb);
+      BOOST_CHECK_EQUAL(json[j].street, xml[j].street);
+      BOOST_CHECK_EQUAL(json[j].house, xml[j].house);
+      BOOST_CHECK(json[j].precision == xml[j].precision);
+      BOOST_CHECK_CLOSE(json[j].coord.latitude, i.second[j].coord.latitude, 1e-9);
+      BOOST_CHECK_CLOSE(json[j].coord.longitude, i.second[j].coord.longitude, 1e-9);
+    }
+  }
+
+  BOOST_CHECK(geocoder::geo::parseYandexJson(geocoder::test::makeYandexJsonAnswer(geocoder::geo::Locations())).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_format_results)
+{
+  namespace pt = boost::property_tree;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data, 9));
+
+  for (const auto &format : {"xml", "json"})
+  {
+    for (const std::size_t results : {0, 1})
+    {
+      pt::ptree document;
+      pt::read_xml("../config/geocoder.xml", document);
+      for (auto &i : document.get_child("document.geocoders"))
+      {
+        i.second.put("connection.url", server.url());
+        i.second.put("format", format);
+        i.second.put("results", results);
+      }
+
+      geocoder::geo::GeoPool pool(document);
+      for (const auto &i : data)
+      {
+        const auto ret = pool.geocode(i.first);
+        BOOST_REQUIRE_EQUAL(ret.locations.size(), results ? results : 10);
+        BOOST_CHECK_EQUAL(ret.locations.front().house, i.second.house);
+        BOOST_CHECK(ret.locations.front().precision == geocoder::geo::Precision::exact);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
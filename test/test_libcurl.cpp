@@ -0,0 +1,121 @@
+/** @file test_libcurl.cpp
+ *  @brief the implementation test for the pool of the handles of the LibCurl
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// boost
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geoyandex.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/libcurl/libcurl.h"
+
+namespace
+{
+using geocoder::utils::curl::LibCurl;
+using geocoder::utils::curl::LibCurlOptions;
+
+std::string makeUrl(const std::string &base, const std::string &address) { return base + LibCurl::escapeUrl(address) + "&format=json"; }
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_libcurl)
+
+BOOST_AUTO_TEST_CASE(test_shared)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.threads = 8;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // the threads share the instance: the each one takes own handle, the connection is kept alive
+  LibCurl curl;
+  std::vector<std::future<std::size_t>> futures;
+  for (std::size_t t = 0; t < 8; ++t)
+  {
+    futures.push_back(std::async(std::launch::async, [&] {
+      std::size_t result = 0;
+      std::string body;
+      for (int n = 0; n < 10; ++n)
+      {
+        for (const auto &i : data)
+        {
+          const auto code = curl.get(makeUrl(server.url(), i.first), body);
+          const auto locs = geocoder::geo::parseYandexJson(body);
+          result += (code == 200 && locs.size() == 1 && locs.front().house == i.second.house) ? 1 : 0;
+          BOOST_CHECK(curl.lastWireSize() > 0);
+        }
+      }
+      return result;
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    BOOST_CHECK_EQUAL(i.get(), data.size() * 10);
+  }
+  BOOST_CHECK(server.stats().connections <= 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_timeout)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(300);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+  const auto url = makeUrl(server.url(), data.begin()->first);
+  std::string body;
+
+  // the options of the handle are kept between the requests
+  LibCurlOptions options;
+  options.timeout_ms = 100;
+  LibCurl limited(options);
+  BOOST_CHECK_THROW(limited.get(url, body), std::runtime_error);
+  BOOST_CHECK_THROW(limited.get(url, body), std::runtime_error);
+
+  // the timeout of the request does not change the options of the handle
+  LibCurl curl;
+  BOOST_CHECK_THROW(curl.get(url, body, 100), std::runtime_error);
+  BOOST_CHECK_EQUAL(curl.get(url, body), 200);
+  BOOST_CHECK_EQUAL(geocoder::geo::parseYandexJson(body).size(), 1);
+
+  // the setter is applied to the handle by the next request
+  curl.setTimeOutMs(100);
+  BOOST_CHECK_THROW(curl.get(url, body), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_head_post)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+  const auto url = makeUrl(server.url(), data.begin()->first);
+
+  // the handle changed by the head (post) request gets the body of the next one
+  LibCurl curl;
+  curl.head(server.url());
+  std::string body;
+  BOOST_CHECK_EQUAL(curl.get(url, body), 200);
+  BOOST_CHECK_EQUAL(geocoder::geo::parseYandexJson(body).size(), 1);
+  BOOST_CHECK_EQUAL(server.stats().probes, 1);
+  BOOST_CHECK_EQUAL(server.stats().connections, 1);
+
+  // the answer of the post, the options of the handle are applied again for the next get
+  const auto posted = curl.post(url);
+  BOOST_CHECK_EQUAL(std::get<1>(posted), 200);
+  BOOST_CHECK_EQUAL(geocoder::geo::parseYandexJson(std::get<0>(posted)).size(), 1);
+  BOOST_CHECK_EQUAL(curl.get(url, body), 200);
+  BOOST_CHECK_EQUAL(geocoder::geo::parseYandexJson(body).size(), 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
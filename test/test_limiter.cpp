@@ -0,0 +1,240 @@
+/** @file test_limiter.cpp
+ *  @brief the implementation test for the adaptive limit of the requests in flight
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/limiter.h"
+#include "utils/metrics.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+using geocoder::utils::Limiter;
+using geocoder::utils::LimiterOptions;
+
+LimiterOptions makeOptions(std::size_t initial, std::size_t max)
+{
+  LimiterOptions result;
+  result.initial = initial;
+  result.max = max;
+  result.tolerance = 0.0;
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_limiter)
+
+BOOST_AUTO_TEST_CASE(test_aimd)
+{
+  Limiter limiter(makeOptions(4, 16), "test.limiter.limit");
+  BOOST_CHECK_EQUAL(limiter.limit(), 4);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("test.limiter.limit").value(), 4);
+
+  // the additive increase: about one per the limit of the successful requests
+  for (int i = 0; i < 5; ++i)
+  {
+    limiter.release(limiter.acquire(), Limiter::Outcome::success);
+  }
+  BOOST_CHECK_EQUAL(limiter.limit(), 5);
+  for (int i = 0; i < 1000; ++i)
+  {
+    limiter.release(limiter.acquire(), Limiter::Outcome::success);
+  }
+  BOOST_CHECK_EQUAL(limiter.limit(), 16);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("test.limiter.limit").value(), 16);
+
+  // the multiplicative decrease once per the requests in flight
+  std::vector<Limiter::Ticket> tickets;
+  for (int i = 0; i < 8; ++i)
+  {
+    tickets.push_back(limiter.acquire());
+  }
+  BOOST_CHECK_EQUAL(limiter.inflight(), 8);
+  for (const auto &i : tickets)
+  {
+    limiter.release(i, Limiter::Outcome::overload);
+  }
+  BOOST_CHECK_EQUAL(limiter.limit(), 8);
+  BOOST_CHECK_EQUAL(limiter.inflight(), 0);
+
+  // the next overload is counted, the other errors are ignored
+  limiter.release(limiter.acquire(), Limiter::Outcome::overload);
+  BOOST_CHECK_EQUAL(limiter.limit(), 4);
+  limiter.release(limiter.acquire(), Limiter::Outcome::ignore);
+  BOOST_CHECK_EQUAL(limiter.limit(), 4);
+  for (int i = 0; i < 10; ++i)
+  {
+    limiter.release(limiter.acquire(), Limiter::Outcome::overload);
+  }
+  BOOST_CHECK_EQUAL(limiter.limit(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_latency)
+{
+  auto options = makeOptions(8, 16);
+  options.tolerance = 3.0;
+  Limiter limiter(options);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    const auto ticket = limiter.acquire();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    limiter.release(ticket, Limiter::Outcome::success);
+  }
+  const auto limit = limiter.limit();
+  BOOST_CHECK(limit > 8);
+
+  // the answer is successful, but the latency is above the tolerance (the queue of the geocoder)
+  Limiter::Ticket slow;
+  slow.start = Limiter::Clock::now() - std::chrono::seconds(1);
+  slow.epoch = limiter.acquire().epoch;
+  limiter.release(slow, Limiter::Outcome::success);
+  BOOST_CHECK_EQUAL(limiter.limit(), limit / 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_wait)
+{
+  Limiter limiter(makeOptions(2, 2));
+
+  const auto first = limiter.acquire();
+  limiter.acquire();
+
+  std::atomic<bool> acquired{false};
+  auto waiter = std::async(std::launch::async, [&] {
+    limiter.acquire();
+    acquired = true;
+  });
+
+  BOOST_CHECK(waiter.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+  BOOST_CHECK(!acquired);
+  limiter.release(first, Limiter::Outcome::ignore);
+  waiter.get();
+  BOOST_CHECK(acquired);
+  BOOST_CHECK_EQUAL(limiter.inflight(), 2);
+
+  // the wait is bounded by the deadline, the request is not counted
+  const auto start = Limiter::Clock::now();
+  BOOST_CHECK(!limiter.acquire(start + std::chrono::milliseconds(50)));
+  BOOST_CHECK(Limiter::Clock::now() - start >= std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(limiter.inflight(), 2);
+  limiter.release(first, Limiter::Outcome::ignore);
+  BOOST_CHECK(limiter.acquire(Limiter::Clock::now() + std::chrono::milliseconds(50)));
+  BOOST_CHECK_EQUAL(limiter.inflight(), 2);
+
+  pt::ptree conf;
+  conf.put("min", 4);
+  conf.put("max", 2);
+  BOOST_CHECK_THROW(geocoder::utils::readLimiterOptions(conf), std::runtime_error);
+  conf.put("max", 8);
+  conf.put("backoff", 1.0);
+  BOOST_CHECK_THROW(geocoder::utils::readLimiterOptions(conf), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_geopool)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+
+  // the geocoder answers 429 to the fifth of the requests
+  geocoder::test::MockConfig mock;
+  mock.error_429 = 0.2;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  auto &conn = document.get_child("document.geocoders.geocoder.connection");
+  conn.put("url", server.url());
+  conn.put("timeout", 5);
+  conn.put("limiter.initial", 16);
+  conn.put("limiter.max", 32);
+  conn.put("limiter.tolerance", 0);
+
+  // the workers share the limiter of the geocoder
+  auto limiter = Limiter::shared("yandex " + server.url(), geocoder::utils::readLimiterOptions(conn.get_child("limiter")), "geocoder.yandex.limit");
+  std::vector<std::future<void>> workers;
+  for (int t = 0; t < 8; ++t)
+  {
+    workers.push_back(std::async(std::launch::async, [&] {
+      geocoder::geo::GeoPool pool(document);
+      for (int n = 0; n < 50; ++n)
+      {
+        for (const auto &i : data)
+        {
+          pool.geocode(i.first);
+        }
+      }
+    }));
+  }
+  for (auto &i : workers)
+  {
+    i.get();
+  }
+
+  // the overload keeps the limit below the count of the workers
+  BOOST_CHECK(server.stats().error_429 > 0);
+  BOOST_CHECK(limiter->limit() < 8);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("geocoder.yandex.limit").value(), limiter->limit());
+  BOOST_CHECK_EQUAL(limiter->inflight(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_deadline)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::milliseconds(400);
+  mock.threads = 4;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  auto &conn = document.get_child("document.geocoders.geocoder.connection");
+  conn.put("url", server.url());
+  conn.put("timeout", 5);
+  conn.put("limiter.initial", 2);
+  conn.put("limiter.max", 2);
+  conn.put("limiter.tolerance", 0);
+  document.put("document.deadline.total", 200);
+  document.put("document.deadline.min_request", 10);
+
+  auto limiter = Limiter::shared("yandex " + server.url(), geocoder::utils::readLimiterOptions(conn.get_child("limiter")), "geocoder.yandex.limit");
+  std::vector<std::unique_ptr<geocoder::geo::GeoPool>> pools;
+  for (int t = 0; t < 3; ++t)
+  {
+    pools.emplace_back(new geocoder::geo::GeoPool(document));
+  }
+
+  // the two requests are aborted by the deadline, the third one waits for the limit until the deadline and is not sent
+  std::vector<std::future<std::size_t>> workers;
+  for (auto &i : pools)
+  {
+    workers.push_back(std::async(std::launch::async, [&i, &data] { return i->geocode(data.begin()->first).locations.size(); }));
+  }
+  for (auto &i : workers)
+  {
+    BOOST_CHECK_EQUAL(i.get(), 0);
+  }
+
+  // the deadline is not the overload of the geocoder
+  BOOST_CHECK_EQUAL(server.stats().requests, 2);
+  BOOST_CHECK_EQUAL(limiter->limit(), 2);
+  BOOST_CHECK_EQUAL(limiter->inflight(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+/** @file test_multiplexer.cpp
+ *  @brief the implementation test for shared curl multiplexer
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/libcurl/multiplexer.h"
+
+BOOST_AUTO_TEST_SUITE(test_multiplexer)
+
+BOOST_AUTO_TEST_CASE(test_concurrent_get)
+{
+  using geocoder::utils::curl::Multiplexer;
+  using geocoder::utils::curl::MultiplexerOptions;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::microseconds(2000);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  MultiplexerOptions options;
+  options.version = MultiplexerOptions::HttpVersion::http1_1;
+  options.max_connections = 4;
+  options.timeout_ms = 5000;
+  Multiplexer multiplexer(options);
+
+  const std::size_t workers = 16;
+  std::atomic<std::size_t> ok{0};
+  std::vector<std::future<void>> futures;
+  for (std::size_t i = 0; i < workers; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&] {
+      for (std::size_t j = 0; j < 10; ++j)
+      {
+        const auto ret = multiplexer.get(server.url() + "unknown");
+        ok += (std::get<1>(ret) == 200 && !std::get<0>(ret).empty()) ? 1 : 0;
+      }
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    i.get();
+  }
+
+  BOOST_CHECK_EQUAL(ok, workers * 10);
+  BOOST_CHECK(multiplexer.connections() <= options.max_connections);
+  BOOST_CHECK(server.stats().connections <= options.max_connections);
+
+  BOOST_CHECK_THROW(multiplexer.get("http://127.0.0.1:1/"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_options)
+{
+  using geocoder::utils::curl::Multiplexer;
+  using geocoder::utils::curl::MultiplexerOptions;
+
+  // the key is shared by the same options only
+  MultiplexerOptions options;
+  const auto first = Multiplexer::shared("yandex", options);
+  BOOST_CHECK(Multiplexer::shared("yandex", options) == first);
+
+  options.max_connections = 4;
+  const auto other = Multiplexer::shared("yandex", options);
+  BOOST_CHECK(other != first);
+  BOOST_CHECK(Multiplexer::shared("yandex", options) == other);
+  options.cainfo = "ca.pem";
+  BOOST_CHECK(Multiplexer::shared("yandex", options) != other);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_geopool)
+{
+  namespace pt = boost::property_tree;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  for (auto &i : document.get_child("document.geocoders"))
+  {
+    i.second.put("connection.url", server.url());
+    // plain http: HTTP/2 is negotiated only over TLS, the transfers fall back to HTTP/1.1
+    i.second.put("connection.http_version", "2");
+    i.second.put("connection.max_connections", 2);
+  }
+
+  std::vector<std::future<std::size_t>> futures;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&document, &data] {
+      geocoder::geo::GeoPool pool(document);
+      std::size_t result = 0;
+      for (const auto &i : data)
+      {
+        const auto ret = pool.geocode(i.first);
+        result += (ret.locations.size() == 1 && ret.locations.front().house == i.second.house) ? 1 : 0;
+      }
+      return result;
+    }));
+  }
+
+  for (auto &i : futures)
+  {
+    BOOST_CHECK_EQUAL(i.get(), data.size());
+  }
+
+  BOOST_CHECK(server.stats().connections <= 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
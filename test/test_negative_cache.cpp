@@ -0,0 +1,151 @@
+/** @file test_negative_cache.cpp
+ *  @brief the implementation test for the cache of the addresses not resolved by the geocoders
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <thread>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geocoderbase.h"
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/metrics.h"
+#include "utils/negative_cache.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+using geocoder::utils::NegativeCache;
+using geocoder::utils::NegativeCacheOptions;
+
+NegativeCacheOptions makeOptions(std::size_t size, std::int64_t ttl)
+{
+  NegativeCacheOptions result;
+  result.size = size;
+  result.ttl = std::chrono::seconds(ttl);
+  return result;
+}
+
+pt::ptree makeConfig(const std::string &url, std::size_t size)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", url);
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  document.put("document.negative_cache.size", size);
+  return document;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_negative_cache)
+
+BOOST_AUTO_TEST_CASE(test_lru)
+{
+  NegativeCache cache(makeOptions(2, 3600));
+  cache.insert("a");
+  cache.insert("b");
+  BOOST_CHECK(cache.contains("a"));
+
+  // the least recently used is evicted
+  cache.insert("c");
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.contains("a"));
+  BOOST_CHECK(!cache.contains("b"));
+  BOOST_CHECK(cache.contains("c"));
+
+  // disabled
+  NegativeCache disabled(makeOptions(0, 3600));
+  disabled.insert("a");
+  BOOST_CHECK(!disabled.contains("a"));
+}
+
+BOOST_AUTO_TEST_CASE(test_ttl)
+{
+  NegativeCache cache(makeOptions(16, 1));
+  cache.insert("a");
+  BOOST_CHECK(cache.contains("a"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  BOOST_CHECK(!cache.contains("a"));
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+
+  pt::ptree conf;
+  conf.put("size", 10);
+  conf.put("ttl", 60);
+  const auto options = geocoder::utils::readNegativeCacheOptions(conf);
+  BOOST_CHECK_EQUAL(options.size, 10);
+  BOOST_CHECK_EQUAL(options.ttl.count(), 60);
+}
+
+BOOST_AUTO_TEST_CASE(test_rejected)
+{
+  BOOST_CHECK(geocoder::geo::ResponseError("", 400).rejected());
+  BOOST_CHECK(geocoder::geo::ResponseError("", 404).rejected());
+  BOOST_CHECK(!geocoder::geo::ResponseError("", 403).rejected());
+  BOOST_CHECK(!geocoder::geo::ResponseError("", 429).rejected());
+  BOOST_CHECK(!geocoder::geo::ResponseError("", 503).rejected());
+}
+
+BOOST_AUTO_TEST_CASE(test_geopool)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+  const auto hits = geocoder::utils::metrics::counter("negative_cache.hits").value();
+
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), 100));
+
+  // the unknown address is requested once
+  BOOST_CHECK(pool.geocode("неизвестный адрес").locations.empty());
+  BOOST_CHECK(pool.geocode("неизвестный адрес").locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 1);
+  BOOST_CHECK_EQUAL(geocoder::utils::metrics::counter("negative_cache.hits").value(), hits + 1);
+
+  // the found address is not cached
+  BOOST_CHECK_EQUAL(pool.geocode(data.begin()->first).locations.size(), 1);
+  BOOST_CHECK_EQUAL(pool.geocode(data.begin()->first).locations.size(), 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, 3);
+
+  // the cache is common for the all pools
+  geocoder::geo::GeoPool other(makeConfig(server.url(), 100));
+  BOOST_CHECK(other.geocode("неизвестный адрес").locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_bad_request)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.bad_request.insert("адрес с ошибкой");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // 400 is the answer of the address: the error body is not parsed, the address is cached
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), 100));
+  BOOST_CHECK(pool.geocode("адрес с ошибкой").locations.empty());
+  BOOST_CHECK(pool.geocode("адрес с ошибкой").locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_transient)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockConfig mock;
+  mock.error_5xx = 1.0;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  // 503 is not the answer of the address: requested again
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), 100));
+  BOOST_CHECK(pool.geocode("неизвестный адрес").locations.empty());
+  BOOST_CHECK(pool.geocode("неизвестный адрес").locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,157 @@
+/** @file test_parse_options.cpp
+ *  @brief the implementation test for the projection and the precision filter of the answer of the geocoder
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <string>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "geo/geoyandex.h"
+#include "geo/parse_options.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace pt = boost::property_tree;
+
+/** @brief the street level locations first, the exact one is the last */
+geo::Locations makeLocations()
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const auto fixtures = geocoder::test::makeFixtures(data, 3);
+  auto result = fixtures.begin()->second;
+  std::rotate(result.begin(), result.begin() + 1, result.end());
+  return result;
+}
+
+void checkParse(const geo::Locations &locs, const geo::Locations &all)
+{
+  BOOST_REQUIRE_EQUAL(locs.size(), all.size());
+  for (std::size_t i = 0; i < locs.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(locs[i].line, all[i].line);
+    BOOST_CHECK_EQUAL(locs[i].house, all[i].house);
+    BOOST_CHECK_CLOSE(locs[i].coord.latitude, all[i].coord.latitude, 0.0001);
+    BOOST_CHECK(locs[i].precision == all[i].precision);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_parse_options)
+
+BOOST_AUTO_TEST_CASE(test_options)
+{
+  const auto locs = makeLocations();
+  BOOST_REQUIRE_EQUAL(locs.size(), 4);
+  BOOST_REQUIRE(locs.back().precision == geo::Precision::exact);
+
+  const auto xml = geocoder::test::makeYandexAnswer(locs);
+  const auto json = geocoder::test::makeYandexJsonAnswer(locs);
+
+  // the defaults: the all locations
+  checkParse(geo::parseYandexXml(xml, geo::ParseOptions()), locs);
+  checkParse(geo::parseYandexJson(json, geo::ParseOptions()), locs);
+
+  // the count
+  geo::ParseOptions options;
+  options.max_results = 2;
+  checkParse(geo::parseYandexXml(xml, options), geo::Locations(locs.begin(), locs.begin() + 2));
+  checkParse(geo::parseYandexJson(json, options), geo::Locations(locs.begin(), locs.begin() + 2));
+
+  // the precision
+  options.max_results = 0;
+  options.min_precision = geo::Precision::exact;
+  checkParse(geo::parseYandexXml(xml, options), geo::Locations(locs.end() - 1, locs.end()));
+  checkParse(geo::parseYandexJson(json, options), geo::Locations(locs.end() - 1, locs.end()));
+
+  // the fields: the coordinates and the precision are always filled
+  options.min_precision = geo::Precision::other;
+  options.fields = geo::textToFields("line, house");
+  for (const auto &ret : {geo::parseYandexXml(xml, options), geo::parseYandexJson(json, options)})
+  {
+    BOOST_REQUIRE_EQUAL(ret.size(), locs.size());
+    BOOST_CHECK_EQUAL(ret.back().line, locs.back().line);
+    BOOST_CHECK_EQUAL(ret.back().house, locs.back().house);
+    BOOST_CHECK(ret.back().street.empty());
+    BOOST_CHECK(ret.back().country.empty());
+    BOOST_CHECK(ret.back().precision == geo::Precision::exact);
+    BOOST_CHECK(ret.back().coord.isValid());
+  }
+
+  // the local geocoder
+  auto local = locs;
+  options.min_precision = geo::Precision::street;
+  options.max_results = 2;
+  geo::applyParseOptions(options, local);
+  BOOST_REQUIRE_EQUAL(local.size(), 2);
+  BOOST_CHECK(local.front().street.empty());
+  BOOST_CHECK_EQUAL(local.front().line, locs.front().line);
+
+  BOOST_CHECK_EQUAL(geo::textToFields("all"), geo::ParseOptions::all);
+  BOOST_CHECK_THROW(geo::textToFields("line,zip"), std::runtime_error);
+  pt::ptree conf;
+  conf.put("min_precision", "exact");
+  conf.put("max_results", 1);
+  conf.put("fields", "street");
+  const auto read = geo::readParseOptions(conf);
+  BOOST_CHECK(read.min_precision == geo::Precision::exact);
+  BOOST_CHECK_EQUAL(read.max_results, 1);
+  BOOST_CHECK_EQUAL(read.fields, geo::ParseOptions::street);
+}
+
+BOOST_AUTO_TEST_CASE(test_early_stop)
+{
+  const auto locs = makeLocations();
+  const auto json = geocoder::test::makeYandexJsonAnswer(locs);
+
+  // the rest of the document after the wanted locations is not read
+  const auto head = json.substr(0, json.size() * 3 / 4);
+  BOOST_CHECK_THROW(geo::parseYandexJson(head), std::runtime_error);
+
+  geo::ParseOptions options;
+  options.max_results = 1;
+  checkParse(geo::parseYandexJson(head, options), geo::Locations(locs.begin(), locs.begin() + 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_geopool)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  auto fixtures = geocoder::test::makeFixtures(data, 3);
+  const std::string street = "Москва, улица Пришвина";
+  fixtures[street] = geo::Locations(fixtures.begin()->second.begin() + 1, fixtures.begin()->second.end());
+  geocoder::test::MockServer server(fixtures);
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.format", "json");
+  document.put("document.geocoders.geocoder.connection.url", server.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  document.put("document.negative_cache.size", 100);
+  document.put("document.parse.max_results", 1);
+
+  geo::GeoPool pool(document);
+  BOOST_CHECK_EQUAL(pool.parseOptions().max_results, 1);
+  BOOST_CHECK_EQUAL(pool.geocode(data.begin()->first).locations.size(), 1);
+
+  // the address without the wanted precision is not the unresolved one
+  auto options = pool.parseOptions();
+  options.min_precision = geo::Precision::exact;
+  options.max_results = 0;
+  BOOST_CHECK(pool.geocode(street, options).locations.empty());
+  BOOST_CHECK(pool.geocode(street, options).locations.empty());
+  BOOST_CHECK_EQUAL(server.stats().requests, 3);
+  BOOST_CHECK_EQUAL(pool.geocode(street).locations.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
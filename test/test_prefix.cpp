@@ -0,0 +1,119 @@
+/** @file test_prefix.cpp
+ *  @brief the implementation test for autocomplete of the partial addresses
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/prefix.h"
+#include "geo/reverse.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+
+geo::Location makeLocation(const std::string &place, const std::string &street, const std::string &house, double lat)
+{
+  geo::Location loc;
+  loc.country = "Россия";
+  loc.place = place;
+  loc.street = street;
+  loc.house = house;
+  loc.line = "Россия, " + place + ", " + street + ", " + house;
+  loc.coord = geo::Coordinates(lat, 37.0);
+  return loc;
+}
+
+std::vector<std::string> houses(const geo::PrefixIndex::Matches &matches)
+{
+  std::vector<std::string> result;
+  for (const auto &i : matches)
+  {
+    result.push_back(i.location->house);
+  }
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_prefix)
+
+BOOST_AUTO_TEST_CASE(test_top_k)
+{
+  geo::Locations locs;
+  // the weight of the house is the count of the repeats
+  for (int house = 1; house <= 300; ++house)
+  {
+    for (int i = 0; i < ((house % 100 == 0) ? 5 : (house % 10 == 0) ? 2 : 1); ++i)
+    {
+      locs.push_back(makeLocation("Москва", "улица Пришвина", std::to_string(house), 55.0 + house * 0.001));
+    }
+  }
+  locs.push_back(makeLocation("Москворецк", "улица Ленина", "1", 56.0));
+  locs.push_back(makeLocation("Тверь", "улица Пришвина", "7", 57.0));
+
+  const geo::PrefixIndex index(std::move(locs));
+  BOOST_CHECK_EQUAL(index.locations(), 302);
+
+  auto matches = index.complete("Москва, ул. Пришв", 5);
+  BOOST_REQUIRE_EQUAL(matches.size(), 5);
+  BOOST_CHECK(houses(matches) == (std::vector<std::string>{"100", "200", "300", "10", "110"}));
+  BOOST_CHECK_EQUAL(matches[0].weight, 5);
+  BOOST_CHECK_EQUAL(matches[0].key, "москва пришвина 100");
+  BOOST_CHECK_EQUAL(matches[4].weight, 2);
+
+  // the whole number of the house
+  matches = index.complete("москва пришвина 25", 20);
+  BOOST_CHECK(houses(matches) == (std::vector<std::string>{"250", "25", "251", "252", "253", "254", "255", "256", "257", "258", "259"}));
+
+  // the prefix of the word and the whole word
+  BOOST_CHECK_EQUAL(index.complete("Москв", 400).size(), 301);
+  BOOST_CHECK_EQUAL(index.complete("Москва ", 400).size(), 300);
+  BOOST_CHECK_EQUAL(index.complete("Москва,", 400).size(), 300);
+
+  // the address is started from the street, the location is returned once by the all keys
+  matches = index.complete("Пришвина 7", 400);
+  BOOST_CHECK(houses(matches) == (std::vector<std::string>{"70", "7", "7", "71", "72", "73", "74", "75", "76", "77", "78", "79"}));
+  matches = index.complete("пришвина 7", 400);
+  BOOST_CHECK_EQUAL(matches[1].location->place, "Москва");
+  BOOST_CHECK_EQUAL(matches[2].location->place, "Тверь");
+
+  BOOST_CHECK(index.complete("Санкт-Петербург").empty());
+  BOOST_CHECK(index.complete("").empty());
+  BOOST_CHECK(index.complete("москва", 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_from_output)
+{
+  const geocoder::test::TempDir temp("geocoder_prefix");
+  const auto &dir = temp.path;
+
+  geo::Answers answers;
+  for (const auto &i : geocoder::test::readFromFile("../test/addrs.txt"))
+  {
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::yandex;
+    answer.locations.push_back(i.second);
+    answers.push_back(answer);
+  }
+  geo::print(dir / "output.txt", answers);
+
+  const geo::PrefixIndex index(geo::loadLocations(dir / "output.txt"));
+  BOOST_CHECK_EQUAL(index.locations(), answers.size());
+
+  const auto matches = index.complete("ростов на д");
+  BOOST_REQUIRE_EQUAL(matches.size(), 1);
+  BOOST_CHECK_EQUAL(matches[0].location->house, "350А");
+  BOOST_CHECK_EQUAL(index.complete("Москва ").size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
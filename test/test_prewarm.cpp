@@ -0,0 +1,90 @@
+/** @file test_prewarm.cpp
+ *  @brief the implementation test for the warm-up of the connections of the geocoders
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <chrono>
+#include <thread>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+
+pt::ptree makeConfig(const std::string &url, bool enabled, std::int64_t keepalive)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", url);
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  document.put("document.prewarm.enabled", enabled);
+  document.put("document.prewarm.keepalive", keepalive);
+  return document;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_prewarm)
+
+BOOST_AUTO_TEST_CASE(test_warmup)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  // the connection is opened by the constructor of the pool
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), true, 0));
+  BOOST_CHECK_EQUAL(server.stats().connections, 1);
+  BOOST_CHECK_EQUAL(server.stats().probes, 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, 0);
+
+  // the first request reuses the warm connection
+  BOOST_CHECK_EQUAL(pool.geocode(data.begin()->first).locations.size(), 1);
+  BOOST_CHECK_EQUAL(server.stats().connections, 1);
+  BOOST_CHECK_EQUAL(server.stats().requests, 1);
+  BOOST_CHECK_EQUAL(pool.keepAlivePeriod().count(), 0);
+
+  // disabled: the connection is opened by the first request
+  geocoder::geo::GeoPool cold(makeConfig(server.url(), false, 30));
+  BOOST_CHECK_EQUAL(server.stats().connections, 1);
+  BOOST_CHECK_EQUAL(cold.keepAlivePeriod().count(), 0);
+  cold.geocode(data.begin()->first);
+  BOOST_CHECK_EQUAL(server.stats().connections, 2);
+  BOOST_CHECK_EQUAL(server.stats().probes, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_keepalive)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  geocoder::geo::GeoPool pool(makeConfig(server.url(), true, 1));
+  BOOST_CHECK_EQUAL(pool.keepAlivePeriod().count(), 1);
+  BOOST_CHECK_EQUAL(server.stats().probes, 1);
+
+  // the pool is busy: no keep-alive
+  pool.geocode(data.begin()->first);
+  pool.keepAlive();
+  BOOST_CHECK_EQUAL(server.stats().probes, 1);
+
+  // the pool is idle: the keep-alive on the same connection
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  pool.keepAlive();
+  BOOST_CHECK_EQUAL(server.stats().probes, 2);
+  BOOST_CHECK_EQUAL(server.stats().connections, 1);
+
+  // the failed warm-up is not an error of the pool
+  geocoder::geo::GeoPool broken(makeConfig("http://127.0.0.1:1/?geocode=", true, 1));
+  BOOST_CHECK(broken.geocode(data.begin()->first).locations.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
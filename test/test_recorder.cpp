@@ -0,0 +1,97 @@
+/** @file test_recorder.cpp
+ *  @brief the implementation test for record and replay responses
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/recorder.h"
+
+BOOST_AUTO_TEST_SUITE(test_recorder)
+
+BOOST_AUTO_TEST_CASE(test_save_load)
+{
+  using geocoder::utils::Recorder;
+
+  const geocoder::test::TempDir temp("geocoder_rec");
+  const auto &dir = temp.path;
+
+  Recorder rec(Recorder::Mode::record, dir);
+  rec.save("http://localhost/?geocode=a", "body a\nline 2", 200);
+  rec.save("http://localhost/?geocode=b", std::string(), 429);
+
+  Recorder replay(Recorder::Mode::replay, dir);
+  std::string body;
+  long code{};
+
+  std::tie(body, code) = replay.load("http://localhost/?geocode=a");
+  BOOST_CHECK_EQUAL(body, "body a\nline 2");
+  BOOST_CHECK_EQUAL(code, 200);
+
+  std::tie(body, code) = replay.load("http://localhost/?geocode=b");
+  BOOST_CHECK(body.empty());
+  BOOST_CHECK_EQUAL(code, 429);
+
+  BOOST_CHECK_THROW(replay.load("http://localhost/?geocode=c"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_record_replay_geopool)
+{
+  namespace pt = boost::property_tree;
+
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const geocoder::test::TempDir temp("geocoder_rec");
+  const auto &dir = temp.path;
+
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+
+  std::unique_ptr<geocoder::test::MockServer> server(new geocoder::test::MockServer(geocoder::test::makeFixtures(data)));
+  for (auto &i : document.get_child("document.geocoders"))
+  {
+    i.second.put("connection.url", server->url());
+  }
+
+  // record
+  document.put("document.recorder.mode", "record");
+  document.put("document.recorder.dir", dir.string());
+  {
+    geocoder::geo::GeoPool pool(document);
+    for (const auto &i : data)
+    {
+      BOOST_REQUIRE(pool.geocode(i.first).locations.size() == 1);
+    }
+  }
+
+  // replay without network
+  server.reset();
+  document.put("document.recorder.mode", "replay");
+  {
+    geocoder::geo::GeoPool pool(document);
+    for (const auto &i : data)
+    {
+      const auto ret = pool.geocode(i.first);
+      BOOST_REQUIRE(ret.locations.size() == 1);
+      BOOST_CHECK_EQUAL(ret.locations.front().line, i.second.line);
+      BOOST_CHECK_EQUAL(ret.locations.front().house, i.second.house);
+    }
+
+    BOOST_CHECK(pool.geocode("not recorded address").locations.empty());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,169 @@
+/** @file test_reverse.cpp
+ *  @brief the implementation test for local reverse geocoding
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/reverse.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/recorder.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+
+geo::Locations makeLocations(std::size_t count, std::mt19937 &rand)
+{
+  std::uniform_real_distribution<double> lat(55.5, 56.0);
+  std::uniform_real_distribution<double> lon(37.3, 37.9);
+
+  geo::Locations result(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    result[i].house = std::to_string(i);
+    result[i].coord = geo::Coordinates(lat(rand), lon(rand));
+  }
+  return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_reverse)
+
+BOOST_AUTO_TEST_CASE(test_distance)
+{
+  // Moscow - Saint Petersburg, ~634 km
+  BOOST_CHECK_CLOSE(geo::distance(geo::Coordinates(55.7558, 37.6173), geo::Coordinates(59.9343, 30.3351)), 634000.0, 1.0);
+  BOOST_CHECK_SMALL(geo::distance(geo::Coordinates(10.0, 20.0), geo::Coordinates(10.0, 20.0)), 1e-6);
+  // across the antimeridian
+  BOOST_CHECK_CLOSE(geo::distance(geo::Coordinates(0.0, 179.999), geo::Coordinates(0.0, -179.999)), 222.4, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_nearest_as_brute_force)
+{
+  std::mt19937 rand(7);
+  const auto locs = makeLocations(20000, rand);
+  const geo::ReverseIndex index(locs);
+  BOOST_REQUIRE_EQUAL(index.size(), locs.size());
+
+  std::vector<geo::Coordinates> points;
+  for (const auto &i : makeLocations(500, rand))
+  {
+    points.push_back(i.coord);
+  }
+
+  const auto batch = index.nearest(points, std::numeric_limits<double>::infinity(), 4);
+  BOOST_REQUIRE_EQUAL(batch.size(), points.size());
+
+  for (std::size_t p = 0; p < points.size(); ++p)
+  {
+    std::vector<std::pair<double, std::string>> all;
+    for (const auto &i : locs)
+    {
+      all.emplace_back(geo::distance(points[p], i.coord), i.house);
+    }
+    std::partial_sort(all.begin(), all.begin() + 3, all.end());
+
+    const auto matches = index.nearest(points[p], 3);
+    BOOST_REQUIRE_EQUAL(matches.size(), 3);
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      BOOST_CHECK_EQUAL(matches[k].location->house, all[k].second);
+      BOOST_CHECK_CLOSE(matches[k].distance, all[k].first, 1e-3);
+    }
+
+    BOOST_REQUIRE(batch[p].location);
+    BOOST_CHECK_EQUAL(batch[p].location->house, all[0].second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_max_distance_and_invalid)
+{
+  geo::Locations locs(2);
+  locs[0].house = "1";
+  locs[0].coord = geo::Coordinates(55.0, 37.0);
+  // is not geocoded location
+  locs[1].house = "2";
+
+  const geo::ReverseIndex index(locs);
+  BOOST_CHECK_EQUAL(index.size(), 1);
+
+  BOOST_CHECK_EQUAL(index.nearest(geo::Coordinates(55.001, 37.0), 1, 200.0).size(), 1);
+  BOOST_CHECK(index.nearest(geo::Coordinates(55.01, 37.0), 1, 200.0).empty());
+  BOOST_CHECK(index.nearest(geo::Coordinates(), 1).empty());
+
+  const auto batch = index.nearest({geo::Coordinates(55.01, 37.0), geo::Coordinates(55.0, 37.0)}, 200.0);
+  BOOST_CHECK(!batch[0].location);
+  BOOST_CHECK(batch[1].location && batch[1].location->house == "1");
+
+  BOOST_CHECK(geo::ReverseIndex(geo::Locations()).nearest(geo::Coordinates(55.0, 37.0)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_load_locations)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  const geocoder::test::TempDir temp("geocoder_reverse");
+  const auto &dir = temp.path;
+
+  // the output file of the geocoder
+  geo::Answers answers;
+  for (const auto &i : data)
+  {
+    geo::Answer answer;
+    answer.type = geo::Answer::GeocoderType::yandex;
+    answer.locations.push_back(i.second);
+    answers.push_back(answer);
+  }
+  geo::print(dir / "out.txt", answers);
+
+  const auto printed = geo::loadLocations(dir / "out.txt");
+  BOOST_REQUIRE_EQUAL(printed.size(), data.size());
+  // the coordinates are printed exactly
+  auto expected = data.begin();
+  for (const auto &i : printed)
+  {
+    BOOST_CHECK_EQUAL(i.coord.latitude, expected->second.coord.latitude);
+    BOOST_CHECK_EQUAL(i.coord.longitude, expected->second.coord.longitude);
+    ++expected;
+  }
+
+  // the recorded responses (xml and json)
+  geocoder::utils::Recorder recorder(geocoder::utils::Recorder::Mode::record, dir / "rec");
+  std::size_t n = 0;
+  for (const auto &i : data)
+  {
+    const geo::Locations locs{i.second};
+    const auto body = (n % 2) ? geocoder::test::makeYandexJsonAnswer(locs) : geocoder::test::makeYandexAnswer(locs);
+    recorder.save("url" + std::to_string(n++), body, 200);
+  }
+  recorder.save("error", "Too Many Requests", 429);
+
+  const auto recorded = geo::loadLocations(dir / "rec");
+  BOOST_REQUIRE_EQUAL(recorded.size(), data.size());
+
+  for (const auto &locs : {printed, recorded})
+  {
+    const geo::ReverseIndex index(locs);
+    for (const auto &i : data)
+    {
+      const auto matches = index.nearest(i.second.coord);
+      BOOST_REQUIRE_EQUAL(matches.size(), 1);
+      BOOST_CHECK_EQUAL(matches.front().location->line, i.second.line);
+      BOOST_CHECK_EQUAL(matches.front().location->house, i.second.house);
+      BOOST_CHECK(matches.front().distance < 10.0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,267 @@
+/** @file test_server.cpp
+ *  @brief the implementation test for the daemon mode (HTTP geocoding over tcp and unix socket)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <iterator>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/server.h"
+#include "mock_server.h"
+#include "test_utils.h"
+#include "utils/json.h"
+#include "utils/libcurl/libcurl.h"
+
+namespace
+{
+namespace asio = boost::asio;
+namespace fs = boost::filesystem;
+namespace pt = boost::property_tree;
+
+struct Reply
+{
+  int code{0};
+  std::string body;
+};
+
+/** @brief send the request and read the response (Content-Length) */
+template <class Socket>
+Reply roundTrip(Socket &socket, const std::string &request)
+{
+  asio::write(socket, asio::buffer(request));
+
+  asio::streambuf buffer;
+  const auto n = asio::read_until(socket, buffer, "\r\n\r\n");
+  const std::string header(asio::buffers_begin(buffer.data()), asio::buffers_begin(buffer.data()) + n);
+  buffer.consume(n);
+
+  Reply result;
+  result.code = std::stoi(header.substr(9, 3));
+  const auto length_pos = header.find("Content-Length: ");
+  const auto length = std::stoul(header.substr(length_pos + 16));
+  if (buffer.size() < length)
+  {
+    asio::read(socket, buffer, asio::transfer_exactly(length - buffer.size()));
+  }
+  result.body.assign(asio::buffers_begin(buffer.data()), asio::buffers_begin(buffer.data()) + length);
+  return result;
+}
+
+std::string get(const std::string &target) { return "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n"; }
+
+std::string post(const std::string &target, const std::string &body)
+{
+  return "POST " + target + " HTTP/1.1\r\nHost: localhost\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+/** @brief the rows of the answer: the values of the keys */
+class Rows final : public geocoder::utils::json::Handler
+{
+ public:
+  void startObject() override { rows.emplace_back(); }
+  void key(const char *data, std::size_t size) override { key_.assign(data, size); }
+  void string(const char *data, std::size_t size) override { rows.back()[key_].assign(data, size); }
+  void literal(const char *data, std::size_t size) override { rows.back()[key_].assign(data, size); }
+
+  std::vector<std::map<std::string, std::string>> rows;
+
+ private:
+  std::string key_;
+};
+
+std::vector<std::map<std::string, std::string>> parseRows(const std::string &body)
+{
+  Rows result;
+  std::size_t begin = 0;
+  for (auto end = body.find('\n'); end != std::string::npos; end = body.find('\n', begin))
+  {
+    geocoder::utils::json::parse(body.substr(begin, end - begin), result);
+    begin = end + 1;
+  }
+  return result.rows;
+}
+
+/** @brief the server in the background thread */
+class Background final
+{
+ public:
+  Background(const pt::ptree &conf, const geocoder::geo::ServerOptions &options)
+   : server(conf, options)
+   , thread_([this] { server.run(); })
+  {
+  }
+  ~Background()
+  {
+    server.stop();
+    thread_.join();
+  }
+
+  geocoder::geo::Server server;
+
+ private:
+  std::thread thread_;
+};
+
+pt::ptree makeConfig(const geocoder::test::MockServer &upstream)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", upstream.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  return document;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_server)
+
+BOOST_AUTO_TEST_CASE(test_geocode_tcp)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  geocoder::geo::ServerOptions options;
+  options.endpoint = "127.0.0.1:0";
+  options.threads = 2;
+  options.max_body = 16384;
+  options.max_batch = 100;
+  Background background(makeConfig(upstream), options);
+  BOOST_REQUIRE(background.server.port() != 0);
+
+  asio::io_context io;
+  asio::ip::tcp::socket socket(io);
+  socket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), background.server.port()));
+
+  // the single address, the connection is kept alive
+  geocoder::utils::curl::LibCurl curl;
+  for (const auto &i : data)
+  {
+    const auto reply = roundTrip(socket, get("/geocode?address=" + curl.escapeUrl(i.first)));
+    BOOST_REQUIRE_EQUAL(reply.code, 200);
+    const auto rows = parseRows(reply.body);
+    BOOST_REQUIRE_EQUAL(rows.size(), 1);
+    BOOST_CHECK_EQUAL(rows[0].at("id"), "1");
+    BOOST_CHECK_EQUAL(rows[0].at("line"), i.second.line);
+  }
+
+  // the batch: the lines and the json array, the unknown address has no rows
+  std::string lines;
+  std::string array = "[";
+  for (const auto &i : data)
+  {
+    lines += i.first + "\r\n";
+    array += "\"" + i.first + "\",";
+  }
+  lines += "неизвестный адрес";
+  array += "\"неизвестный адрес\"]";
+
+  for (const auto &body : {lines, array})
+  {
+    const auto reply = roundTrip(socket, post("/geocode", body));
+    BOOST_REQUIRE_EQUAL(reply.code, 200);
+    const auto rows = parseRows(reply.body);
+    BOOST_REQUIRE_EQUAL(rows.size(), data.size());
+    std::size_t id = 1;
+    for (const auto &i : data)
+    {
+      BOOST_CHECK_EQUAL(rows[id - 1].at("id"), std::to_string(id));
+      BOOST_CHECK_EQUAL(rows[id - 1].at("street"), i.second.street);
+      ++id;
+    }
+  }
+
+  // the batch of the several parts (the workers geocode them in parallel): the rows are in the order of the addresses
+  lines.clear();
+  for (std::size_t n = 0; n < 20; ++n)
+  {
+    for (const auto &i : data)
+    {
+      lines += i.first + "\n";
+    }
+  }
+  const auto parts = roundTrip(socket, post("/geocode", lines));
+  BOOST_REQUIRE_EQUAL(parts.code, 200);
+  const auto rows = parseRows(parts.body);
+  BOOST_REQUIRE_EQUAL(rows.size(), 20 * data.size());
+  for (std::size_t id = 1; id <= rows.size(); ++id)
+  {
+    auto expected = data.begin();
+    std::advance(expected, (id - 1) % data.size());
+    BOOST_CHECK_EQUAL(rows[id - 1].at("id"), std::to_string(id));
+    BOOST_CHECK_EQUAL(rows[id - 1].at("street"), expected->second.street);
+  }
+
+  // the errors do not close the connection
+  BOOST_CHECK_EQUAL(roundTrip(socket, post("/geocode", std::string(101, '\n'))).code, 413);
+  BOOST_CHECK_EQUAL(roundTrip(socket, get("/geocode")).code, 400);
+  BOOST_CHECK_EQUAL(roundTrip(socket, get("/unknown")).code, 404);
+  BOOST_CHECK_EQUAL(roundTrip(socket, post("/health", "")).code, 405);
+  BOOST_CHECK_EQUAL(roundTrip(socket, post("/geocode", "[\"адрес\", 1]")).code, 400);
+  BOOST_CHECK_EQUAL(roundTrip(socket, get("/health")).body, "ok\n");
+
+  const auto metrics = roundTrip(socket, get("/metrics"));
+  BOOST_CHECK_EQUAL(metrics.code, 200);
+  BOOST_CHECK(metrics.body.find("server.requests") != std::string::npos);
+
+  // the body is larger than 'max_body': the connection is closed
+  const auto reply = roundTrip(socket, post("/geocode", std::string(20000, 'x')));
+  BOOST_CHECK_EQUAL(reply.code, 413);
+  boost::system::error_code ec;
+  char byte;
+  asio::read(socket, asio::buffer(&byte, 1), ec);
+  BOOST_CHECK(ec == asio::error::eof);
+}
+
+BOOST_AUTO_TEST_CASE(test_unix_socket)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  const geocoder::test::TempDir temp("geocoder_server");
+  const auto &dir = temp.path;
+  const auto path = (dir / "geocoder.sock").string();
+
+  geocoder::geo::ServerOptions options;
+  options.endpoint = "unix:" + path;
+  options.threads = 1;
+  {
+    Background background(makeConfig(upstream), options);
+    BOOST_CHECK_EQUAL(background.server.port(), 0);
+    BOOST_CHECK(fs::exists(path));
+
+    asio::io_context io;
+    asio::local::stream_protocol::socket socket(io);
+    socket.connect(asio::local::stream_protocol::endpoint(path));
+
+    const auto reply = roundTrip(socket, post("/geocode", data.begin()->first));
+    BOOST_REQUIRE_EQUAL(reply.code, 200);
+    BOOST_CHECK_EQUAL(parseRows(reply.body).at(0).at("line"), data.begin()->second.line);
+  }
+  BOOST_CHECK(!fs::exists(path));
+
+  // the file of the path is not replaced
+  {
+    std::ofstream fout(path);
+    fout << "data";
+  }
+  BOOST_CHECK_THROW(geocoder::geo::Server(makeConfig(upstream), options), std::runtime_error);
+  BOOST_CHECK_EQUAL(fs::file_size(path), 4);
+
+  options.endpoint = "127.0.0.1";
+  BOOST_CHECK_THROW(geocoder::geo::Server(pt::ptree(), options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
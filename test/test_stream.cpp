@@ -0,0 +1,280 @@
+/** @file test_stream.cpp
+ *  @brief the implementation test for the filter mode (the addresses from the descriptor, the answers per batch)
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <vector>
+
+// posix
+#include <poll.h>
+#include <unistd.h>
+
+// boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/batch.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace pt = boost::property_tree;
+
+pt::ptree makeConfig(const geocoder::test::MockServer &upstream)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+  document.put("document.geocoders.geocoder.connection.url", upstream.url());
+  document.put("document.geocoders.geocoder.connection.timeout", 5);
+  return document;
+}
+
+void writeAll(int fd, const std::string &data)
+{
+  std::size_t done = 0;
+  while (done < data.size())
+  {
+    const auto n = ::write(fd, data.data() + done, data.size() - done);
+    BOOST_REQUIRE(n > 0);
+    done += static_cast<std::size_t>(n);
+  }
+}
+
+/** @brief read until the count of the line feeds or the timeout */
+std::string readLines(int fd, std::size_t lines, int timeout_ms = 5000)
+{
+  std::string result;
+  while (static_cast<std::size_t>(std::count(result.begin(), result.end(), '\n')) < lines)
+  {
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, timeout_ms) <= 0)
+    {
+      break;
+    }
+    char buffer[4096];
+    const auto n = ::read(fd, buffer, sizeof(buffer));
+    if (n <= 0)
+    {
+      break;
+    }
+    result.append(buffer, static_cast<std::size_t>(n));
+  }
+  return result;
+}
+
+/** @brief the pipe, the descriptors are closed on exit */
+struct Pipe
+{
+  Pipe() { BOOST_REQUIRE_EQUAL(::pipe(fds), 0); }
+  ~Pipe()
+  {
+    closeRead();
+    closeWrite();
+  }
+  void closeRead()
+  {
+    if (fds[0] >= 0)
+    {
+      ::close(fds[0]);
+      fds[0] = -1;
+    }
+  }
+  void closeWrite()
+  {
+    if (fds[1] >= 0)
+    {
+      ::close(fds[1]);
+      fds[1] = -1;
+    }
+  }
+
+  int fds[2];
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_stream)
+
+BOOST_AUTO_TEST_CASE(test_csv)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  // the empty line and the line without the line feed
+  std::string input;
+  for (const auto &i : data)
+  {
+    input += i.first + "\r\n";
+  }
+  input += "\n" + data.begin()->first;
+
+  Pipe in;
+  writeAll(in.fds[1], input);
+  in.closeWrite();
+
+  auto out = std::tmpfile();
+  BOOST_REQUIRE(out != nullptr);
+
+  geocoder::geo::StreamOptions options;
+  options.format = "csv";
+  options.batch = 2;
+  options.threads = 2;
+  BOOST_CHECK_EQUAL(geocoder::geo::geocodeStream(in.fds[0], out, makeConfig(upstream), options), data.size() + 2);
+
+  std::rewind(out);
+  std::string output;
+  char buffer[4096];
+  for (auto n = std::fread(buffer, 1, sizeof(buffer), out); n > 0; n = std::fread(buffer, 1, sizeof(buffer), out))
+  {
+    output.append(buffer, n);
+  }
+  std::fclose(out);
+
+  // the header, the row per address, the empty address has no rows
+  std::vector<std::string> rows;
+  std::size_t begin = 0;
+  for (auto end = output.find('\n'); end != std::string::npos; end = output.find('\n', begin))
+  {
+    rows.push_back(output.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  BOOST_REQUIRE_EQUAL(rows.size(), data.size() + 2);
+  BOOST_CHECK_EQUAL(rows[0].compare(0, 8, "id,type,"), 0);
+
+  std::size_t id = 1;
+  for (const auto &i : data)
+  {
+    BOOST_CHECK_EQUAL(rows[id].compare(0, std::to_string(id).size() + 1, std::to_string(id) + ","), 0);
+    BOOST_CHECK(rows[id].find(i.second.street) != std::string::npos);
+    ++id;
+  }
+  BOOST_CHECK_EQUAL(rows.back().compare(0, std::to_string(data.size() + 2).size() + 1, std::to_string(data.size() + 2) + ","), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_order)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  // the answers complete out of the order of the input
+  geocoder::test::MockConfig conf;
+  conf.latency_type = geocoder::test::MockConfig::Latency::uniform;
+  conf.latency = std::chrono::milliseconds(1);
+  conf.latency_max = std::chrono::milliseconds(30);
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data), conf);
+
+  std::string input;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    for (const auto &j : data)
+    {
+      input += j.first + "\n";
+    }
+  }
+
+  Pipe in;
+  auto writer = std::async(std::launch::async, [&] {
+    writeAll(in.fds[1], input);
+    in.closeWrite();
+  });
+
+  auto out = std::tmpfile();
+  BOOST_REQUIRE(out != nullptr);
+
+  geocoder::geo::StreamOptions options;
+  options.format = "csv";
+  options.batch = 3;
+  options.threads = 4;
+  BOOST_CHECK_EQUAL(geocoder::geo::geocodeStream(in.fds[0], out, makeConfig(upstream), options), data.size() * 8);
+  writer.get();
+
+  std::rewind(out);
+  std::string output;
+  char buffer[4096];
+  for (auto n = std::fread(buffer, 1, sizeof(buffer), out); n > 0; n = std::fread(buffer, 1, sizeof(buffer), out))
+  {
+    output.append(buffer, n);
+  }
+  std::fclose(out);
+
+  // the header, then the ids in the order of the input
+  std::size_t id = 0;
+  std::size_t begin = output.find('\n') + 1;
+  for (auto end = output.find('\n', begin); end != std::string::npos; end = output.find('\n', begin))
+  {
+    ++id;
+    BOOST_CHECK_EQUAL(output.compare(begin, std::to_string(id).size() + 1, std::to_string(id) + ","), 0);
+    begin = end + 1;
+  }
+  BOOST_CHECK_EQUAL(id, data.size() * 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_flush_per_batch)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  Pipe in;
+  Pipe out;
+  auto fout = ::fdopen(out.fds[1], "w");
+  BOOST_REQUIRE(fout != nullptr);
+  out.fds[1] = -1;
+
+  geocoder::geo::StreamOptions options;
+  options.format = "jsonl";
+  options.batch = 16;
+  const auto conf = makeConfig(upstream);
+  auto count = std::async(std::launch::async, [&] { return geocoder::geo::geocodeStream(in.fds[0], fout, conf, options); });
+
+  // the answer is written before the end of the input
+  for (const auto &i : data)
+  {
+    writeAll(in.fds[1], i.first + "\n");
+    const auto row = readLines(out.fds[0], 1);
+    BOOST_CHECK(row.find(i.second.street) != std::string::npos);
+  }
+
+  in.closeWrite();
+  BOOST_CHECK_EQUAL(count.get(), data.size());
+  std::fclose(fout);
+}
+
+BOOST_AUTO_TEST_CASE(test_text)
+{
+  const auto data = geocoder::test::readFromFile("../test/addrs.txt");
+  geocoder::test::MockServer upstream(geocoder::test::makeFixtures(data));
+
+  Pipe in;
+  writeAll(in.fds[1], data.begin()->first + "\n");
+  in.closeWrite();
+
+  auto out = std::tmpfile();
+  BOOST_REQUIRE(out != nullptr);
+  BOOST_CHECK_EQUAL(geocoder::geo::geocodeStream(in.fds[0], out, makeConfig(upstream), geocoder::geo::StreamOptions()), 1);
+
+  // the same text as 'print'
+  geocoder::geo::Answer answer;
+  answer.type = geocoder::geo::Answer::GeocoderType::yandex;
+  answer.locations.push_back(data.begin()->second);
+  std::string expected;
+  geocoder::geo::appendText(answer, expected);
+
+  std::rewind(out);
+  std::string output(expected.size() * 2, '\0');
+  output.resize(std::fread(&output[0], 1, output.size(), out));
+  std::fclose(out);
+  BOOST_CHECK_EQUAL(output, expected);
+
+  geocoder::geo::StreamOptions options;
+  options.format = "columnar";
+  BOOST_CHECK_THROW(geocoder::geo::geocodeStream(in.fds[0], stdout, pt::ptree(), options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,282 @@
+/** @file test_tabular.cpp
+ *  @brief the implementation test for CSV and JSON Lines output
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/tabular.h"
+#include "test_utils.h"
+#include "utils/json.h"
+
+namespace
+{
+namespace geo = geocoder::geo;
+namespace fs = boost::filesystem;
+
+/** @brief the values of the keys of the json objects */
+class Collector final : public geocoder::utils::json::Handler
+{
+ public:
+  void startObject() override { objects.emplace_back(); }
+  void key(const char *data, std::size_t size) override { key_.assign(data, size); }
+  void string(const char *data, std::size_t size) override { objects.back()[key_].assign(data, size); }
+  void literal(const char *data, std::size_t size) override { objects.back()[key_].assign(data, size); }
+
+  std::vector<std::map<std::string, std::string>> objects;
+
+ private:
+  std::string key_;
+};
+
+geo::Location makeLocation(const std::string &street, double lat, double lon)
+{
+  geo::Location loc;
+  loc.country = "Россия";
+  loc.place = "Москва";
+  loc.street = street;
+  loc.house = "1";
+  loc.line = loc.country + ", " + loc.place + ", " + loc.street + ", " + loc.house;
+  loc.coord = geo::Coordinates(lat, lon);
+  loc.precision = geo::Precision::exact;
+  return loc;
+}
+
+std::string readFile(const fs::path &filename)
+{
+  std::ifstream fin(filename.string(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_tabular)
+
+BOOST_AUTO_TEST_CASE(test_double)
+{
+  const auto text = [](double value) {
+    std::string result;
+    geo::appendDouble(value, result);
+    return result;
+  };
+
+  BOOST_CHECK_EQUAL(text(55.753215), "55.753215");
+  BOOST_CHECK_EQUAL(text(0.1), "0.1");
+  BOOST_CHECK_EQUAL(text(-37.5), "-37.5");
+  BOOST_CHECK_EQUAL(text(1000.0), "1000");
+  BOOST_CHECK_EQUAL(text(0.1 + 0.2), "0.30000000000000004");
+  BOOST_CHECK_EQUAL(text(-0.000125), "-0.000125");
+  BOOST_CHECK_EQUAL(text(1e-20), "1e-20");
+  BOOST_CHECK_EQUAL(text(1e300), "1e+300");
+  BOOST_CHECK_EQUAL(text(std::numeric_limits<double>::quiet_NaN()), "");
+
+  std::mt19937 rand(42);
+  std::uniform_real_distribution<double> any(-180.0, 180.0);
+  for (int i = 0; i < 100000; ++i)
+  {
+    // the full precision and the coordinates of the geocoders (6 decimals)
+    for (const auto value : {any(rand), std::round(any(rand) * 1e6) / 1e6})
+    {
+      const auto result = text(value);
+      BOOST_REQUIRE_EQUAL(std::strtod(result.c_str(), nullptr), value);
+      BOOST_REQUIRE(result.size() <= 24);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_csv)
+{
+  geo::Answer answer;
+  answer.type = geo::Answer::GeocoderType::yandex;
+  answer.locations.push_back(makeLocation("улица Ленина", 55.75, 37.62));
+  answer.locations.push_back(makeLocation("переулок \"Тихий\", 3-й", 55.5, 37.125));
+
+  std::string out;
+  geo::appendHeader(geo::TabularFormat::csv, out);
+  geo::appendRows(geo::TabularFormat::csv, 7, answer, out);
+  geo::appendRows(geo::TabularFormat::csv, 8, geo::Answer(), out);
+
+  BOOST_CHECK_EQUAL(out,
+                    "id,type,line,country,region,district,place,suburb,street,house,latitude,longitude,precision\n"
+                    "7,yandex,\"Россия, Москва, улица Ленина, 1\",Россия,,,Москва,,улица Ленина,1,55.75,37.62,exact\n"
+                    "7,yandex,\"Россия, Москва, переулок \"\"Тихий\"\", 3-й, 1\",Россия,,,Москва,,\"переулок \"\"Тихий\"\", 3-й\",1,55.5,37.125,exact\n");
+}
+
+BOOST_AUTO_TEST_CASE(test_jsonl)
+{
+  geo::Answer answer;
+  answer.type = geo::Answer::GeocoderType::local;
+  answer.locations.push_back(makeLocation("улица \"Ленина\"\\\t\x01", 0.1 + 0.2, -180.0));
+
+  std::string out;
+  geo::appendHeader(geo::TabularFormat::jsonl, out);
+  geo::appendRows(geo::TabularFormat::jsonl, 3, answer, out);
+  BOOST_REQUIRE(!out.empty());
+  BOOST_CHECK_EQUAL(out.back(), '\n');
+  BOOST_CHECK_EQUAL(out.find('\n'), out.size() - 1);
+
+  Collector collector;
+  geocoder::utils::json::parse(out, collector);
+  BOOST_REQUIRE_EQUAL(collector.objects.size(), 1);
+  auto &object = collector.objects.front();
+  BOOST_CHECK_EQUAL(object["id"], "3");
+  BOOST_CHECK_EQUAL(object["type"], "local");
+  BOOST_CHECK_EQUAL(object["street"], answer.locations[0].street);
+  BOOST_CHECK_EQUAL(object["line"], answer.locations[0].line);
+  BOOST_CHECK_EQUAL(object["district"], "");
+  BOOST_CHECK_EQUAL(std::strtod(object["latitude"].c_str(), nullptr), 0.1 + 0.2);
+  BOOST_CHECK_EQUAL(object["longitude"], "-180");
+  BOOST_CHECK_EQUAL(object["precision"], "exact");
+}
+
+BOOST_AUTO_TEST_CASE(test_print_parallel)
+{
+  const geocoder::test::TempDir temp("geocoder_tabular");
+  const auto &dir = temp.path;
+
+  // the blocks of the threads and the answers without locations
+  geo::Answers answers(50000);
+  geo::Locations locs;
+  for (const auto &i : geocoder::test::readFromFile("../test/addrs.txt"))
+  {
+    locs.push_back(i.second);
+  }
+  for (std::size_t i = 0; i < answers.size(); ++i)
+  {
+    if (i % 7)
+    {
+      answers[i].type = geo::Answer::GeocoderType::yandex;
+      answers[i].locations.push_back(locs[i % locs.size()]);
+    }
+  }
+
+  for (const auto format : {geo::TabularFormat::csv, geo::TabularFormat::jsonl})
+  {
+    geo::printTabular(dir / "single", answers, format, 1);
+    geo::printTabular(dir / "parallel", answers, format, 4);
+
+    std::string expected;
+    geo::appendHeader(format, expected);
+    for (std::size_t i = 0; i < answers.size(); ++i)
+    {
+      geo::appendRows(format, i + 1, answers[i], expected);
+    }
+
+    BOOST_CHECK(readFile(dir / "single") == expected);
+    BOOST_CHECK(readFile(dir / "parallel") == expected);
+  }
+
+  geo::printTabular(dir / "empty", geo::Answers(), geo::TabularFormat::csv);
+  BOOST_CHECK_EQUAL(fs::file_size(dir / "empty"), std::string("id,type,line,country,region,district,place,suburb,street,house,latitude,longitude,precision\n").size());
+  geo::printTabular(dir / "empty", geo::Answers(), geo::TabularFormat::jsonl);
+  BOOST_CHECK_EQUAL(fs::file_size(dir / "empty"), 0);
+
+  BOOST_CHECK_THROW(geo::printTabular(dir / "absent" / "file", answers, geo::TabularFormat::csv), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_shard_merge)
+{
+  const geocoder::test::TempDir temp("geocoder_tabular");
+  const auto &dir = temp.path;
+
+  // the repeated addresses, the answers without locations and of the two locations, the end of line in the csv field
+  geo::Addresses addrs;
+  geo::Answers answers;
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    addrs.push_back("адрес " + std::to_string(i % 50));
+    geo::Answer answer;
+    if (i % 5)
+    {
+      answer.type = geo::Answer::GeocoderType::yandex;
+      answer.locations.push_back(makeLocation((i % 3) ? "Тверская" : "Тверская,\n\"строение\"", 55.75 + i * 1e-4, 37.61));
+    }
+    if (i % 11 == 0)
+    {
+      answer.locations.push_back(makeLocation("Арбат", 55.74, 37.59));
+    }
+    answers.push_back(answer);
+  }
+
+  for (const auto key : {geo::Shard::Key::line, geo::Shard::Key::hash})
+  {
+    for (const auto format : {geo::TabularFormat::csv, geo::TabularFormat::jsonl})
+    {
+      geo::printTabular(dir / "expected", answers, format, 2);
+
+      // the shard geocodes the slice, the ids are the lines of the whole input
+      std::vector<fs::path> outputs;
+      std::map<std::string, std::size_t> owner;
+      std::size_t total = 0;
+      for (std::size_t n = 0; n < 3; ++n)
+      {
+        std::vector<std::size_t> ids;
+        const auto shard = geo::selectShard(addrs, geo::parseShard(std::to_string(n) + "/3", key), ids);
+        BOOST_REQUIRE_EQUAL(shard.size(), ids.size());
+
+        geo::Answers slice;
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+          BOOST_CHECK_EQUAL(shard[i], addrs[ids[i] - 1]);
+          slice.push_back(answers[ids[i] - 1]);
+          if (key == geo::Shard::Key::hash)
+          {
+            BOOST_CHECK_EQUAL(owner.emplace(shard[i], n).first->second, n);
+          }
+        }
+        total += shard.size();
+
+        outputs.push_back(dir / ("shard" + std::to_string(n)));
+        geo::printTabular(outputs.back(), slice, format, 2, ids);
+      }
+      BOOST_CHECK_EQUAL(total, addrs.size());
+
+      geo::mergeTabular(outputs, dir / "merged");
+      BOOST_CHECK(readFile(dir / "merged") == readFile(dir / "expected"));
+    }
+  }
+
+  // the errors: the shard, the formats of the shards, the order of the ids
+  BOOST_CHECK_THROW(geo::parseShard("3/3"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::parseShard("1/0"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::parseShard("1/2x"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::printTabular(dir / "ids", answers, geo::TabularFormat::csv, 1, {1, 2}), std::runtime_error);
+
+  geo::printTabular(dir / "csv", geo::Answers(answers.begin(), answers.begin() + 10), geo::TabularFormat::csv);
+  geo::printTabular(dir / "jsonl", geo::Answers(answers.begin(), answers.begin() + 10), geo::TabularFormat::jsonl);
+  BOOST_CHECK_THROW(geo::mergeTabular({dir / "csv", dir / "jsonl"}, dir / "merged"), std::runtime_error);
+  {
+    std::ofstream fout((dir / "jsonl").string(), std::ios::app);
+    fout << "{\"id\":1}\n";
+  }
+  BOOST_CHECK_THROW(geo::mergeTabular({dir / "jsonl"}, dir / "merged"), std::runtime_error);
+  BOOST_CHECK_THROW(geo::mergeTabular({dir / "absent"}, dir / "merged"), std::runtime_error);
+
+  // the empty shards of jsonl, the first row with the odd count of the escaped quotes is not joined with the next one
+  geo::Answers quoted(answers.begin(), answers.begin() + 10);
+  quoted.front().locations.front().house = "\"строение";
+  geo::printTabular(dir / "expected", quoted, geo::TabularFormat::jsonl);
+  geo::printTabular(dir / "jsonl", quoted, geo::TabularFormat::jsonl);
+  geo::printTabular(dir / "empty0", geo::Answers(), geo::TabularFormat::jsonl);
+  geo::printTabular(dir / "empty1", geo::Answers(), geo::TabularFormat::jsonl);
+  geo::mergeTabular({dir / "empty0", dir / "jsonl", dir / "empty1"}, dir / "merged");
+  BOOST_CHECK(readFile(dir / "merged") == readFile(dir / "expected"));
+  geo::mergeTabular({dir / "empty0", dir / "empty1"}, dir / "merged");
+  BOOST_CHECK_EQUAL(fs::file_size(dir / "merged"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
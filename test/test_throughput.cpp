@@ -0,0 +1,240 @@
+/** @file test_throughput.cpp
+ *  @brief the end-to-end tests against the local mock geocoder server
+ *  @author agent
+ *  @date 19.10.2026
+ */
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/test/unit_test.hpp>
+
+// this
+#include "geo/batch.h"
+#include "geo/geopool.h"
+#include "mock_server.h"
+#include "test_utils.h"
+
+namespace
+{
+namespace fs = boost::filesystem;
+namespace pt = boost::property_tree;
+using Clock = std::chrono::steady_clock;
+using Latencies = std::vector<double>;
+
+/** @brief read config and point 'url' of the all geocoders to mock server */
+pt::ptree makeConfig(const geocoder::test::MockServer &server)
+{
+  pt::ptree document;
+  pt::read_xml("../config/geocoder.xml", document);
+
+  for (auto &i : document.get_child("document.geocoders"))
+  {
+    i.second.put("connection.url", server.url());
+    i.second.put("connection.timeout", 5);
+    i.second.put("connection.conntimeout", 5);
+  }
+
+  return document;
+}
+
+double percentile(Latencies &values, double p)
+{
+  if (values.empty())
+  {
+    return 0.0;
+  }
+
+  const auto n = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+  std::nth_element(std::begin(values), std::begin(values) + n, std::end(values));
+  return values[n];
+}
+
+geocoder::test::DataSet readDataSet() { return geocoder::test::readFromFile("../test/addrs.txt"); }
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(test_throughput)
+
+BOOST_AUTO_TEST_CASE(test_mock_geopool)
+{
+  const auto data = readDataSet();
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data));
+
+  geocoder::geo::GeoPool pool(makeConfig(server));
+
+  for (const auto &i : data)
+  {
+    const auto ret = pool.geocode(i.first);
+    BOOST_REQUIRE(ret.locations.size() == 1);
+
+    const auto &loc = ret.locations.front();
+    BOOST_CHECK_EQUAL(loc.line, i.second.line);
+    BOOST_CHECK_EQUAL(loc.country, i.second.country);
+    BOOST_CHECK_EQUAL(loc.region, i.second.region);
+    BOOST_CHECK_EQUAL(loc.district, i.second.district);
+    BOOST_CHECK_EQUAL(loc.place, i.second.place);
+    BOOST_CHECK_EQUAL(loc.suburb, i.second.suburb);
+    BOOST_CHECK_EQUAL(loc.street, i.second.street);
+    BOOST_CHECK_EQUAL(loc.house, i.second.house);
+    BOOST_CHECK_CLOSE(loc.coord.latitude, i.second.coord.latitude, 0.0001);
+    BOOST_CHECK_CLOSE(loc.coord.longitude, i.second.coord.longitude, 0.0001);
+    BOOST_REQUIRE(loc.precision == i.second.precision);
+  }
+
+  const auto unknown = pool.geocode("unknown address");
+  BOOST_CHECK(unknown.locations.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_pipeline_throughput)
+{
+  const auto data = readDataSet();
+
+  geocoder::test::MockConfig mock;
+  mock.latency = std::chrono::microseconds(200);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  const auto conf = makeConfig(server);
+
+  const std::size_t total = 3000;
+  geocoder::geo::Addresses addrs;
+  while (addrs.size() < total)
+  {
+    for (const auto &i : data)
+    {
+      addrs.push_back(i.first);
+    }
+  }
+  addrs.resize(total);
+
+  const geocoder::test::TempDir dir("geocoder_throughput");
+  const auto out = dir.path / "output.txt";
+
+  const auto start = Clock::now();
+  const auto answers = geocoder::geo::geocode(addrs, conf);
+  geocoder::geo::print(out, answers);
+  const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const auto resolved = std::count_if(std::begin(answers), std::end(answers), [](const auto &i) { return !i.locations.empty(); });
+  BOOST_CHECK_EQUAL(answers.size(), total);
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(resolved), total);
+  BOOST_CHECK(fs::file_size(out) > 0);
+
+  BOOST_TEST_MESSAGE("pipeline: " << total << " addresses, " << elapsed << " s, " << (total / elapsed) << " req/s");
+}
+
+BOOST_AUTO_TEST_CASE(test_latency_percentiles)
+{
+  const auto data = readDataSet();
+
+  geocoder::test::MockConfig mock;
+  mock.latency_type = geocoder::test::MockConfig::Latency::uniform;
+  mock.latency = std::chrono::microseconds(1000);
+  mock.latency_max = std::chrono::microseconds(5000);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  const auto conf = makeConfig(server);
+  const std::size_t workers = 8;
+  const std::size_t per_worker = 100;
+
+  std::atomic<std::size_t> failed{0};
+  std::vector<std::future<Latencies>> futures;
+  const auto start = Clock::now();
+  for (std::size_t w = 0; w < workers; ++w)
+  {
+    futures.push_back(std::async(std::launch::async, [&conf, &data, &failed, per_worker] {
+      geocoder::geo::GeoPool pool(conf);
+      Latencies result;
+      auto it = std::begin(data);
+      for (std::size_t i = 0; i < per_worker; ++i, ++it)
+      {
+        if (it == std::end(data))
+        {
+          it = std::begin(data);
+        }
+
+        const auto begin = Clock::now();
+        const auto answer = pool.geocode(it->first);
+        result.push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin).count());
+        failed += answer.locations.empty() ? 1 : 0;
+      }
+      return result;
+    }));
+  }
+
+  Latencies all;
+  for (auto &i : futures)
+  {
+    const auto l = i.get();
+    all.insert(std::end(all), std::begin(l), std::end(l));
+  }
+  const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const auto p50 = percentile(all, 0.50);
+  const auto p90 = percentile(all, 0.90);
+  const auto p99 = percentile(all, 0.99);
+
+  BOOST_CHECK_EQUAL(all.size(), workers * per_worker);
+  BOOST_CHECK_EQUAL(failed, 0);
+  BOOST_CHECK(p50 >= 1.0);
+  BOOST_CHECK(p50 <= p90 && p90 <= p99);
+
+  BOOST_TEST_MESSAGE("latency: " << all.size() / elapsed << " req/s, p50 = " << p50 << " ms, p90 = " << p90 << " ms, p99 = " << p99 << " ms");
+}
+
+BOOST_AUTO_TEST_CASE(test_errors_and_drops)
+{
+  const auto data = readDataSet();
+
+  geocoder::test::MockConfig mock;
+  mock.error_429 = 0.2;
+  mock.error_5xx = 0.2;
+  mock.drop = 0.1;
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  geocoder::geo::GeoPool pool(makeConfig(server));
+
+  std::size_t resolved = 0;
+  const std::size_t total = 200;
+  for (std::size_t i = 0; i < total; ++i)
+  {
+    const auto answer = pool.geocode(std::begin(data)->first);
+    resolved += answer.locations.empty() ? 0 : 1;
+  }
+
+  const auto stats = server.stats();
+  BOOST_CHECK(stats.requests >= total);
+  BOOST_CHECK(stats.error_429 > 0);
+  BOOST_CHECK(stats.error_5xx > 0);
+  BOOST_CHECK(stats.drop > 0);
+  BOOST_CHECK_EQUAL(resolved, stats.ok);
+}
+
+BOOST_AUTO_TEST_CASE(test_slow_drip)
+{
+  const auto data = readDataSet();
+
+  geocoder::test::MockConfig mock;
+  mock.drip_chunk = 64;
+  mock.drip_delay = std::chrono::microseconds(500);
+  geocoder::test::MockServer server(geocoder::test::makeFixtures(data), mock);
+
+  geocoder::geo::GeoPool pool(makeConfig(server));
+
+  for (const auto &i : data)
+  {
+    const auto ret = pool.geocode(i.first);
+    BOOST_REQUIRE(ret.locations.size() == 1);
+    BOOST_CHECK_EQUAL(ret.locations.front().house, i.second.house);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
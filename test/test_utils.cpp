@@ -67,6 +67,18 @@ DataSet readFromFile(const boost::filesystem::path &filename)
   return result;
 }
 //--------------------------------------------------------------------------------------------
+TempDir::TempDir(const std::string &prefix)
+ : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(prefix + "_%%%%%%"))
+{
+  boost::filesystem::create_directories(path);
+}
+//--------------------------------------------------------------------------------------------
+TempDir::~TempDir()
+{
+  boost::system::error_code err;
+  boost::filesystem::remove_all(path, err);
+}
+//--------------------------------------------------------------------------------------------
 
 }  // namespace test
 }  // namespace geocoder
@@ -8,6 +8,7 @@
 
 // std
 #include <map>
+#include <string>
 
 // boost
 #include <boost/filesystem.hpp>
@@ -24,6 +25,20 @@ using DataSet = std::map<std::string, geo::Location>;
 /** @brief read data set from file */
 DataSet readFromFile(const boost::filesystem::path &filename);
 
+/** @struct TempDir
+ *  @brief the unique directory in the temporary path, removed with the content on exit (also on the failed check)
+ */
+struct TempDir
+{
+  /** @param prefix - the prefix of the name of the directory */
+  explicit TempDir(const std::string &prefix);
+  TempDir(const TempDir &) = delete;
+  TempDir &operator=(const TempDir &) = delete;
+  ~TempDir();
+
+  const boost::filesystem::path path;
+};
+
 }  // namespace test
 }  // namespace geocoder
 